@@ -80,6 +80,26 @@ int natcmp (const char * str1, const char * str2)
 	return *(const unsigned char *) str1 - *(const unsigned char *) str2;
 }
 
+// compares big-endian name prefixes first, like the binary searches of large KeySets
+
+static uint64_t prefix (const char * str)
+{
+	uint64_t ret = 0;
+	for (size_t i = 0; i < sizeof (uint64_t); ++i)
+	{
+		ret = (ret << 8) | (unsigned char) (*str ? *str++ : 0);
+	}
+	return ret;
+}
+
+int prefixcmp (uint64_t prefix1, uint64_t prefix2, const char * str1, const char * str2, size_t size)
+{
+	if (prefix1 != prefix2)
+	{
+		return prefix1 < prefix2 ? -1 : 1;
+	}
+	return memcmp (str1, str2, size);
+}
 
 int main (void)
 {
@@ -118,5 +138,35 @@ int main (void)
 	}
 	timePrint ("natcmp");
 
+	// str3 differs from str1 at the start, so its prefix decides
+	char * str3 = elektraStrDup (str1);
+	str3[2] = 'X';
+	const uint64_t prefix1 = prefix (str1);
+	const uint64_t prefix2 = prefix (str2);
+	const uint64_t prefix3 = prefix (str3);
+	for (int i = 0; i < nrIterations; ++i)
+	{
+		res ^= prefixcmp (prefix1, prefix2, str1, str2, sizeof (str1));
+	}
+	timePrint ("prefixcmp (equal prefix)");
+	for (int i = 0; i < nrIterations; ++i)
+	{
+		res ^= prefixcmp (prefix1, prefix3, str1, str3, sizeof (str1));
+	}
+	timePrint ("prefixcmp (different prefix)");
+
+	Key * key1 = keyNew ("user:/benchmark/some/common/part/only/a/bit/different", KEY_END);
+	Key * key2 = keyNew ("user:/benchmark/some/common/part/only/a/bit/differenX", KEY_END);
+	for (int i = 0; i < nrIterations; ++i)
+	{
+		res ^= keyCmp (key1, key2);
+	}
+	timePrint ("keyCmp");
+
+	keyDel (key1);
+	keyDel (key2);
+	elektraFree (str3);
+	elektraFree (str2);
+
 	printf ("%d\n", res);
 }
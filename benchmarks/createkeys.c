@@ -26,6 +26,24 @@ int benchmarkIterate (void)
 	return c;
 }
 
+void benchmarkFillupArena (void)
+{
+	char name[KEY_NAME_LENGTH + 1];
+	char value[] = "data";
+
+	large = ksNewArena (num_key * num_dir, 0);
+	for (int i = 0; i < num_dir; i++)
+	{
+		snprintf (name, KEY_NAME_LENGTH, "%s/%s%d", KEY_ROOT, "dir", i);
+		ksAppendKey (large, ksArenaKeyNew (large, name, value));
+		for (int j = 0; j < num_key; j++)
+		{
+			snprintf (name, KEY_NAME_LENGTH, "%s/%s%d/%s%d", KEY_ROOT, "dir", i, "key", j);
+			ksAppendKey (large, ksArenaKeyNew (large, name, value));
+		}
+	}
+}
+
 int main (int argc, char ** argv)
 {
 	if (argc != 3)
@@ -53,4 +71,13 @@ int main (int argc, char ** argv)
 
 	benchmarkDel ();
 	timePrint ("Del large keyset");
+
+	benchmarkFillupArena ();
+	timePrint ("New large arena keyset");
+
+	benchmarkIterate ();
+	timePrint ("Iterated over arena keyset");
+
+	benchmarkDel ();
+	timePrint ("Del large arena keyset");
 }
@@ -15,12 +15,153 @@
 
 #define CSV_STR_FMT "%s;%s;%d\n"
 
+#define NUM_MOUNTPOINTS 32
+#define NUM_MOUNTPOINT_KEYS 2000
+#define PARALLEL_ROOT "user:/benchmark/parallel"
+#define MOUNTPOINTS_ROOT "system:/elektra/mountpoints"
+#define CACHE_ENABLED "system:/elektra/cache/enabled"
 
 static void benchmarkDel (void)
 {
 	ksDel (large);
 }
 
+static Key * mountpointConfigKey (size_t i, const char * sub, const char * value)
+{
+	char name[KEY_NAME_LENGTH + 1];
+	snprintf (name, KEY_NAME_LENGTH, "%s/mp%zu", PARALLEL_ROOT, i);
+	Key * key = keyNew (MOUNTPOINTS_ROOT, KEY_END);
+	keyAddBaseName (key, name);
+	if (sub) keyAddName (key, sub);
+	if (value) keySetString (key, value);
+	return key;
+}
+
+/**
+ * Mounts (or unmounts) NUM_MOUNTPOINTS quickdump backends below PARALLEL_ROOT.
+ * While mounted the cache is disabled, otherwise kdbGet() would not read the backends.
+ *
+ * Needs write access to the system:/elektra configuration.
+ */
+static int setupMountpoints (int mount)
+{
+	static int disabledCache = 0;
+	Key * parentKey = keyNew ("system:/elektra", KEY_END);
+	KDB * handle = kdbOpen (parentKey);
+	KeySet * config = ksNew (0, KS_END);
+	kdbGet (handle, config, parentKey);
+
+	if (mount && !ksLookupByName (config, CACHE_ENABLED, 0))
+	{
+		ksAppendKey (config, keyNew (CACHE_ENABLED, KEY_VALUE, "0", KEY_END));
+		disabledCache = 1;
+	}
+	else if (!mount && disabledCache)
+	{
+		keyDel (ksLookupByName (config, CACHE_ENABLED, KDB_O_POP));
+		disabledCache = 0;
+	}
+
+	for (size_t i = 0; i < NUM_MOUNTPOINTS; ++i)
+	{
+		Key * mountpoint = mountpointConfigKey (i, 0, 0);
+		ksDel (ksCut (config, mountpoint));
+		keyDel (mountpoint);
+		if (!mount) continue;
+
+		char value[KEY_NAME_LENGTH + 1];
+		ksAppendKey (config, mountpointConfigKey (i, 0, 0));
+		snprintf (value, KEY_NAME_LENGTH, "benchmark_parallel_%zu.quickdump", i);
+		ksAppendKey (config, mountpointConfigKey (i, "config", 0));
+		ksAppendKey (config, mountpointConfigKey (i, "config/path", value));
+		ksAppendKey (config, mountpointConfigKey (i, "errorplugins", 0));
+		ksAppendKey (config, mountpointConfigKey (i, "errorplugins/#5#" KDB_DEFAULT_RESOLVER "#resolver#", 0));
+		ksAppendKey (config, mountpointConfigKey (i, "getplugins", 0));
+		ksAppendKey (config, mountpointConfigKey (i, "getplugins/#0#resolver", 0));
+		ksAppendKey (config, mountpointConfigKey (i, "getplugins/#5#quickdump#quickdump#", 0));
+		snprintf (value, KEY_NAME_LENGTH, "%s/mp%zu", PARALLEL_ROOT, i);
+		ksAppendKey (config, mountpointConfigKey (i, "mountpoint", value));
+		ksAppendKey (config, mountpointConfigKey (i, "setplugins", 0));
+		ksAppendKey (config, mountpointConfigKey (i, "setplugins/#0#resolver", 0));
+		ksAppendKey (config, mountpointConfigKey (i, "setplugins/#5#quickdump", 0));
+		ksAppendKey (config, mountpointConfigKey (i, "setplugins/#7#resolver", 0));
+	}
+
+	int ret = kdbSet (handle, config, parentKey);
+	kdbClose (handle, parentKey);
+	ksDel (config);
+	keyDel (parentKey);
+	return ret;
+}
+
+static KDB * openWithWorkers (Key * parentKey, size_t workers)
+{
+	KDB * handle = kdbOpen (parentKey);
+	char value[BUF_SIZ];
+	snprintf (value, BUF_SIZ, "%zu", workers);
+	KeySet * contract = ksNew (1, keyNew ("system:/elektra/ensure/get/workers", KEY_VALUE, value, KEY_END), KS_END);
+	kdbEnsure (handle, contract, parentKey);
+	return handle;
+}
+
+/**
+ * Compares reading many mountpoints sequentially and on worker threads.
+ */
+static void benchmarkParallelGet (void)
+{
+	if (setupMountpoints (1) == -1)
+	{
+		fprintf (stderr, "could not mount backends below %s, skipping parallel kdbGet benchmark\n", PARALLEL_ROOT);
+		return;
+	}
+
+	Key * parentKey = keyNew (PARALLEL_ROOT, KEY_END);
+	KDB * handle = kdbOpen (parentKey);
+	KeySet * returned = ksNew (0, KS_END);
+	kdbGet (handle, returned, parentKey);
+	char name[KEY_NAME_LENGTH + 1];
+	for (size_t i = 0; i < NUM_MOUNTPOINTS; ++i)
+	{
+		for (size_t j = 0; j < NUM_MOUNTPOINT_KEYS; ++j)
+		{
+			snprintf (name, KEY_NAME_LENGTH, "%s/mp%zu/key%zu", PARALLEL_ROOT, i, j);
+			ksAppendKey (returned, keyNew (name, KEY_VALUE, "data", KEY_END));
+		}
+	}
+	kdbSet (handle, returned, parentKey);
+	kdbClose (handle, parentKey);
+	ksDel (returned);
+
+	const size_t workers[] = { 1, 2, 4, 8, NUM_MOUNTPOINTS };
+	for (size_t w = 0; w < sizeof (workers) / sizeof (workers[0]); ++w)
+	{
+		char plugin[BUF_SIZ];
+		snprintf (plugin, BUF_SIZ, "workers=%zu", workers[w]);
+		for (size_t i = 0; i < NUM_RUNS; ++i)
+		{
+			handle = openWithWorkers (parentKey, workers[w]);
+			returned = ksNew (0, KS_END);
+			timeInit ();
+			kdbGet (handle, returned, parentKey);
+			fprintf (stdout, CSV_STR_FMT, plugin, "kdbGet", timeGetDiffMicroseconds ());
+			kdbClose (handle, parentKey);
+			ksDel (returned);
+		}
+	}
+
+	// remove the files again
+	handle = kdbOpen (parentKey);
+	returned = ksNew (0, KS_END);
+	kdbGet (handle, returned, parentKey);
+	ksClear (returned);
+	kdbSet (handle, returned, parentKey);
+	kdbClose (handle, parentKey);
+	ksDel (returned);
+	keyDel (parentKey);
+
+	setupMountpoints (0);
+}
+
 int main (void)
 {
 	benchmarkCreate ();
@@ -63,5 +204,7 @@ int main (void)
 		keyDel (parentKey);
 	}
 
+	benchmarkParallelGet ();
+
 	benchmarkDel ();
 }
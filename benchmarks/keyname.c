@@ -0,0 +1,137 @@
+/**
+ * @file
+ *
+ * @brief Benchmark for setting and adding key names
+ *
+ * Compares keySetName() and keyAddName() with the separate validation,
+ * canonicalization and unescaping, which is used for names with escape
+ * sequences or special parts.
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ */
+
+#include <benchmarks.h>
+
+#define NR_ITERATIONS 20
+
+static const char * const corpusFormats[] = {
+	"user:/sw/org/application/#0/current/dir%d/key%d",
+	"system:/elektra/mountpoints/dir%d/config/path/key%d",
+	"/sw/org/application/#0/current/section%d/subsection/key%d",
+	"spec:/sw/org/application/#0/current/dir%d/key%d",
+	"user:/sw/org/application/#0/current/dir%d/#%d",
+	"user:/sw/org/application/#0/current/dir%d/with\\/slash/key%d",
+	"system:/hosts/ipv4/host%d.example.org/../alias%d",
+};
+
+#define NR_FORMATS (sizeof (corpusFormats) / sizeof (corpusFormats[0]))
+
+static char ** corpus;
+static size_t corpusSize;
+
+static void createCorpus (void)
+{
+	char name[KEY_NAME_LENGTH + 1];
+	corpusSize = NR_FORMATS * num_dir * num_key;
+	corpus = elektraMalloc (corpusSize * sizeof (char *));
+	size_t c = 0;
+	for (int i = 0; i < num_dir; i++)
+	{
+		for (int j = 0; j < num_key; j++)
+		{
+			for (size_t f = 0; f < NR_FORMATS; ++f)
+			{
+				snprintf (name, KEY_NAME_LENGTH, corpusFormats[f], i, j);
+				corpus[c++] = elektraStrDup (name);
+			}
+		}
+	}
+}
+
+static void deleteCorpus (void)
+{
+	for (size_t c = 0; c < corpusSize; ++c)
+	{
+		elektraFree (corpus[c]);
+	}
+	elektraFree (corpus);
+}
+
+static size_t benchmarkSetName (void)
+{
+	size_t sum = 0;
+	Key * key = keyNew ("/", KEY_END);
+	for (int n = 0; n < NR_ITERATIONS; ++n)
+	{
+		for (size_t c = 0; c < corpusSize; ++c)
+		{
+			sum += keySetName (key, corpus[c]);
+		}
+	}
+	keyDel (key);
+	return sum;
+}
+
+static size_t benchmarkCanonicalize (void)
+{
+	size_t sum = 0;
+	char * canonical = NULL;
+	size_t canonicalSize = 0;
+	char * unescaped = NULL;
+	for (int n = 0; n < NR_ITERATIONS; ++n)
+	{
+		for (size_t c = 0; c < corpusSize; ++c)
+		{
+			size_t usize = 0;
+			if (!elektraKeyNameValidate (corpus[c], true)) continue;
+			elektraKeyNameCanonicalize (corpus[c], &canonical, &canonicalSize, 0, &usize);
+			elektraRealloc ((void **) &unescaped, usize);
+			elektraKeyNameUnescape (canonical, unescaped);
+			sum += canonicalSize;
+		}
+	}
+	elektraFree (canonical);
+	elektraFree (unescaped);
+	return sum;
+}
+
+static size_t benchmarkAddName (void)
+{
+	size_t sum = 0;
+	Key * key = keyNew ("/", KEY_END);
+	for (int n = 0; n < NR_ITERATIONS; ++n)
+	{
+		for (size_t c = 0; c < corpusSize; ++c)
+		{
+			keySetName (key, "user:/sw/org/application/#0/current");
+			sum += keyAddName (key, strchr (corpus[c], '/') + 1);
+		}
+	}
+	keyDel (key);
+	return sum;
+}
+
+int main (int argc, char ** argv)
+{
+	if (argc == 3)
+	{
+		num_dir = atoi (argv[1]);
+		num_key = atoi (argv[2]);
+	}
+	printf ("Using %d dirs %d keys\n", num_dir, num_key);
+
+	createCorpus ();
+
+	timeInit ();
+	size_t sum = benchmarkSetName ();
+	timePrint ("keySetName");
+
+	sum += benchmarkCanonicalize ();
+	timePrint ("validate+canonicalize+unescape");
+
+	sum += benchmarkAddName ();
+	timePrint ("keySetName+keyAddName");
+
+	deleteCorpus ();
+	printf ("%zu\n", sum);
+}
@@ -47,6 +47,39 @@ void benchmarkLookupByName (void)
 	}
 }
 
+void benchmarkLookupRandom (void)
+{
+	char name[KEY_NAME_LENGTH + 1];
+	int32_t seed = 1;
+
+	for (int i = 0; i < NUM_DIR * NUM_KEY; i++)
+	{
+		elektraRand (&seed);
+		int dir = seed % NUM_DIR;
+		elektraRand (&seed);
+		int nr = seed % NUM_KEY;
+		snprintf (name, KEY_NAME_LENGTH, "%s/%s%d/%s%d", KEY_ROOT, "dir", dir, "key", nr);
+		ksLookupByName (large, name, 0);
+	}
+}
+
+void benchmarkFillupRandom (void)
+{
+	char name[KEY_NAME_LENGTH + 1];
+	int32_t seed = 1;
+	KeySet * ks = ksNew (0, KS_END);
+
+	for (int i = 0; i < NUM_DIR * NUM_KEY; i++)
+	{
+		elektraRand (&seed);
+		snprintf (name, KEY_NAME_LENGTH, "%s/%s%d", KEY_ROOT, "random", seed);
+		ksAppendKey (ks, keyNew (name, KEY_VALUE, "data", KEY_END));
+		// lookups keep the name prefixes of ks up to date while inserting
+		if (i % NUM_KEY == 0) ksLookupByName (ks, name, 0);
+	}
+	ksDel (ks);
+}
+
 void benchmarkReread (void)
 {
 	kdbGet (kdb, large, key);
@@ -106,6 +139,12 @@ int main (void)
 	benchmarkLookupByName ();
 	timePrint ("Lookup key database");
 
+	benchmarkLookupRandom ();
+	timePrint ("Lookup key database in random order");
+
+	benchmarkFillupRandom ();
+	timePrint ("New large keyset in random order");
+
 	benchmarkReread ();
 	timePrint ("Re read key database");
 
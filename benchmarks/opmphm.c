@@ -2062,6 +2062,117 @@ static void benchmarkPredictionTime (char * name)
  * END ===================================================== Prediction Time =========================================================== END
  */
 
+/**
+ * START ================================================= Append Lookup Time ======================================================== START
+ *
+ * This benchmark measures mixed appends and lookups on one KeySet.
+ * After every append of a new Key lookupsPerAppend random Keys are searched, which either uses the OPMPHM with the
+ * recorded changes or binary search. The OPMPHM is rebuild after OPMPHM_DELTA_MAX changes.
+ * The results are written out in the following format:
+ *
+ * n;lookupsPerAppend;opmphm;binarysearch
+ *
+ * The number of needed seeds for this benchmarks is: nCount + 1
+ */
+
+/**
+ * @brief Measures appends interleaved with lookups.
+ *
+ * @param ks the KeySet, is extended by appends Keys
+ * @param appends the number of Keys to append
+ * @param lookupsPerAppend the number of lookups after each append
+ * @param searchSeed the random seed used to determine the Keys to search
+ * @param option the options passed to the ksLookup (...)
+ *
+ * @retval time in microseconds
+ */
+static size_t benchmarkAppendLookupTimeMeasure (KeySet * ks, size_t appends, size_t lookupsPerAppend, int32_t searchSeed,
+						elektraLookupFlags option)
+{
+	char name[KEY_NAME_LENGTH + 1];
+	struct timeval start;
+	struct timeval end;
+
+	// START MEASUREMENT
+	__asm__("");
+	gettimeofday (&start, 0);
+	__asm__("");
+
+	for (size_t a = 0; a < appends; ++a)
+	{
+		snprintf (name, KEY_NAME_LENGTH, "/appended/%zu", a);
+		ksAppendKey (ks, keyNew (name, KEY_END));
+		for (size_t l = 0; l < lookupsPerAppend; ++l)
+		{
+			Key * search = ks->array[searchSeed % ks->size];
+			if (ksLookup (ks, search, option) != search)
+			{
+				printExit ("Sanity Check Failed: found wrong Key");
+			}
+			elektraRand (&searchSeed);
+		}
+	}
+
+	__asm__("");
+	gettimeofday (&end, 0);
+	__asm__("");
+	// END MEASUREMENT
+
+	return (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec);
+}
+
+static void benchmarkAppendLookupTime (char * name)
+{
+	const size_t n[] = { 1000, 10000, 50000 };
+	const size_t nCount = sizeof (n) / sizeof (n[0]);
+	const size_t lookupsPerAppend[] = { 1, 10, 100 };
+	const size_t lookupsCount = sizeof (lookupsPerAppend) / sizeof (lookupsPerAppend[0]);
+	const size_t appends = 1000;
+	KeySetShape * keySetShapes = getKeySetShapes ();
+	int32_t genSeeds[sizeof (n) / sizeof (n[0])];
+	for (size_t nI = 0; nI < nCount; ++nI)
+	{
+		if (getRandomSeed (&genSeeds[nI]) != &genSeeds[nI]) printExit ("Seed Parsing Error or feed me more seeds");
+	}
+	int32_t searchSeed;
+	if (getRandomSeed (&searchSeed) != &searchSeed) printExit ("Seed Parsing Error or feed me more seeds");
+	// set seed to return by elektraRandGetInitSeed () in the OPMPHM builds
+	elektraRandBenchmarkInitSeed = searchSeed;
+
+	FILE * out = fopen ("benchmark_opmphm_append_lookup_time.csv", "w");
+	if (!out)
+	{
+		printExit ("open out file");
+	}
+	fprintf (out, "n;lookupsPerAppend;opmphm;binarysearch\n");
+
+	printf ("%s\n", name);
+	for (size_t nI = 0; nI < nCount; ++nI)
+	{
+		for (size_t lI = 0; lI < lookupsCount; ++lI)
+		{
+			size_t results[2];
+			const elektraLookupFlags options[] = { KDB_O_OPMPHM | KDB_O_NOCASCADING, KDB_O_BINSEARCH | KDB_O_NOCASCADING };
+			for (size_t oI = 0; oI < 2; ++oI)
+			{
+				int32_t genSeed = genSeeds[nI];
+				KeySet * ks = generateKeySet (n[nI], &genSeed, &keySetShapes[0]);
+				// start with a build OPMPHM
+				(void) ksLookup (ks, ks->array[0], KDB_O_OPMPHM | KDB_O_NOCASCADING);
+				results[oI] = benchmarkAppendLookupTimeMeasure (ks, appends, lookupsPerAppend[lI], searchSeed, options[oI]);
+				ksDel (ks);
+			}
+			fprintf (out, "%zu;%zu;%zu;%zu\n", n[nI], lookupsPerAppend[lI], results[0], results[1]);
+		}
+	}
+	fclose (out);
+	elektraFree (keySetShapes);
+}
+
+/**
+ * END =================================================== Append Lookup Time ========================================================== END
+ */
+
 /**
  * START ================================================= Prints all KeySetShapes =================================================== START
  */
@@ -2102,7 +2213,7 @@ static void benchmarkPrintAllKeySetShapes (char * name)
 int main (int argc, char ** argv)
 {
 	// define all benchmarks
-	size_t benchmarksCount = 9;
+	size_t benchmarksCount = 10;
 #ifdef HAVE_HSEARCHR
 	// hsearchbuildtime
 	++benchmarksCount;
@@ -2158,6 +2269,11 @@ int main (int argc, char ** argv)
 	benchmarks[8].name = benchmarkNamePredictionTime;
 	benchmarks[8].benchmarkF = benchmarkPredictionTime;
 	benchmarks[8].numberOfSeedsNeeded = 3496500;
+	// appendlookuptime
+	char * benchmarkNameAppendLookupTime = "appendlookuptime";
+	benchmarks[9].name = benchmarkNameAppendLookupTime;
+	benchmarks[9].benchmarkF = benchmarkAppendLookupTime;
+	benchmarks[9].numberOfSeedsNeeded = 4;
 #ifdef HAVE_HSEARCHR
 	// hsearchbuildtime
 	char * benchmarkNameHsearchBuildTime = "hsearchbuildtime";
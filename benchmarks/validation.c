@@ -0,0 +1,95 @@
+/**
+ * @file
+ *
+ * @brief Benchmark for the validation plugin
+ *
+ * Validates a large spec whose keys share a few patterns, once with
+ * the compiled patterns of the plugin instance and once compiling the
+ * pattern of every key, like the exported function `validateKey` does.
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ */
+
+#include <benchmarks.h>
+
+#define NR_ITERATIONS 5
+
+static const char * const patterns[][2] = {
+	{ "[0-9]+", "12345" },
+	{ "(true|false)", "true" },
+	{ "[a-z]+@[a-z]+\\.[a-z]{2,}", "user@example.org" },
+	{ "([0-9]{1,3}\\.){3}[0-9]{1,3}", "192.168.0.1" },
+	{ "/([^/]+/)*[^/]+", "/usr/local/share" },
+};
+
+#define NR_PATTERNS (sizeof (patterns) / sizeof (patterns[0]))
+
+static KeySet * createSpec (void)
+{
+	char name[KEY_NAME_LENGTH + 1];
+	KeySet * ks = ksNew (num_dir * num_key, KS_END);
+	for (int i = 0; i < num_dir; i++)
+	{
+		for (int j = 0; j < num_key; j++)
+		{
+			size_t p = (i * num_key + j) % NR_PATTERNS;
+			snprintf (name, KEY_NAME_LENGTH, "%s/dir%d/key%d", KEY_ROOT, i, j);
+			ksAppendKey (ks, keyNew (name, KEY_VALUE, patterns[p][1], KEY_META, "check/validation", patterns[p][0], KEY_META,
+						 "check/validation/match", "line", KEY_END));
+		}
+	}
+	return ks;
+}
+
+int main (int argc, char ** argv)
+{
+	if (argc == 3)
+	{
+		num_dir = atoi (argv[1]);
+		num_key = atoi (argv[2]);
+	}
+	printf ("Using %d dirs %d keys\n", num_dir, num_key);
+
+	KeySet * modules = ksNew (0, KS_END);
+	elektraModulesInit (modules, 0);
+	Key * errorKey = keyNew ("/", KEY_END);
+	Plugin * plugin = elektraPluginOpen ("validation", modules, ksNew (0, KS_END), errorKey);
+	if (!plugin)
+	{
+		fprintf (stderr, "could not open validation plugin\n");
+		return 1;
+	}
+	typedef int (*validateKeyFunc) (Key *, Key *);
+	validateKeyFunc validateKey = (validateKeyFunc) elektraPluginGetFunction (plugin, "validateKey");
+
+	KeySet * ks = createSpec ();
+	Key * parentKey = keyNew (KEY_ROOT, KEY_END);
+	int sum = 0;
+
+	timeInit ();
+	for (int n = 0; n < NR_ITERATIONS; ++n)
+	{
+		ksRewind (ks);
+		sum += plugin->kdbSet (plugin, ks, parentKey);
+	}
+	timePrint ("cached patterns");
+
+	for (int n = 0; n < NR_ITERATIONS && validateKey; ++n)
+	{
+		for (elektraCursor it = 0; it < ksGetSize (ks); ++it)
+		{
+			sum += validateKey (ksAtCursor (ks, it), parentKey);
+		}
+	}
+	timePrint ("compiled per key");
+
+	printf ("%d\n", sum);
+
+	keyDel (parentKey);
+	ksDel (ks);
+	elektraPluginClose (plugin, errorKey);
+	elektraModulesClose (modules, 0);
+	ksDel (modules);
+	keyDel (errorKey);
+	return 0;
+}
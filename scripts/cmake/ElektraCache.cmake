@@ -262,6 +262,13 @@ else (ENABLE_LOGGER)
 	set (HAVE_LOGGER "0")
 endif (ENABLE_LOGGER)
 
+option (ENABLE_TRACE "Allows applications to trace the phases of kdbGet and kdbSet, see elektraTraceEnable." ON)
+if (ENABLE_TRACE)
+	set (HAVE_TRACE "1")
+else (ENABLE_TRACE)
+	set (HAVE_TRACE "0")
+endif (ENABLE_TRACE)
+
 #
 # Target installation folders
 #
@@ -617,6 +617,37 @@ void elektraIoSetBinding (KDB * kdb, ElektraIoInterface * ioBinding);
  */
 ElektraIoInterface * elektraIoGetBinding (KDB * kdb);
 
+/**
+ * Track changes of configuration files for KDB instance.
+ *
+ * Afterwards kdbGet() only asks the resolvers of backends whose files
+ * changed since the last kdbGet() (currently implemented with inotify).
+ * A kdbGet() without changes then does not need to touch any file.
+ *
+ * If an I/O binding is set, changes are read by the binding as soon as
+ * they arrive. Otherwise kdbGet() reads them. So with an I/O binding,
+ * changes are only picked up after the event loop ran.
+ *
+ * Changes on network file systems and of files that are symbolic links
+ * are not tracked, such files are checked by the resolver as before.
+ *
+ * @ingroup kdbio
+ *
+ * @param  kdb KDB instance
+ * @retval 1 on success
+ * @retval 0 if change tracking is not supported or could not be enabled
+ */
+int elektraIoWatchEnable (KDB * kdb);
+
+/**
+ * Stop tracking changes of configuration files for KDB instance.
+ *
+ * @ingroup kdbio
+ *
+ * @param  kdb KDB instance
+ */
+void elektraIoWatchDisable (KDB * kdb);
+
 #ifdef __cplusplus
 }
 }
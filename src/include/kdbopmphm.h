@@ -96,6 +96,41 @@ typedef struct
 	opmphmflag_t flags;	     /*!< internal flags */
 } Opmphm;
 
+/**
+ * Maximum number of changes recorded in a OpmphmDelta, afterwards the OPMPHM needs to be rebuild.
+ */
+#define OPMPHM_DELTA_MAX 32
+
+/**
+ * Order returned by opmphmDeltaMap () for removed elements.
+ */
+#define OPMPHM_DELTA_REMOVED SIZE_MAX
+
+/**
+ * A single insertion or removal of an element
+ */
+typedef struct
+{
+	size_t order; /*!< the order of the inserted or removed element, at the time of the change */
+	int insert;   /*!< 1 for insertion, 0 for removal */
+} OpmphmChange;
+
+/**
+ * Changes since the OPMPHM was build
+ *
+ * Every insertion or removal of an element shifts the order of the following elements.
+ * Instead of rebuilding the OPMPHM after each change, the changes are recorded, so the orders
+ * returned by opmphmLookup () can be mapped to the current orders with opmphmDeltaMap ().
+ * Inserted elements are not part of the OPMPHM, they need to be searched in the changes.
+ */
+typedef struct
+{
+	OpmphmChange changes[OPMPHM_DELTA_MAX]; /*!< the recorded changes, oldest first */
+	size_t size;				/*!< number of recorded changes */
+	size_t inserted;			/*!< number of insertions in changes */
+	size_t removed;				/*!< number of removals in changes */
+} OpmphmDelta;
+
 /**
  * Functions providing `r` and `c`
  */
@@ -141,6 +176,15 @@ int opmphmIsBuild (const Opmphm * opmphm);
 int opmphmCopy (Opmphm * dest, const Opmphm * source);
 void opmphmClear (Opmphm * opmphm);
 
+/**
+ * Delta functions
+ */
+OpmphmDelta * opmphmDeltaNew (void);
+void opmphmDeltaDel (OpmphmDelta * delta);
+void opmphmDeltaClear (OpmphmDelta * delta);
+int opmphmDeltaAdd (OpmphmDelta * delta, size_t order, int insert);
+size_t opmphmDeltaMap (const OpmphmDelta * delta, size_t first, size_t order);
+
 /**
  * Hash function
  * By Bob Jenkins, May 2006
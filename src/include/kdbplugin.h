@@ -72,6 +72,8 @@ typedef enum
 	ELEKTRA_PLUGIN_SET=1<<3,	/*!< Next arg is backend for kdbSet() */
 	ELEKTRA_PLUGIN_ERROR=1<<4,	/*!< Next arg is backend for kdbError() */
 	ELEKTRA_PLUGIN_COMMIT=1<<5,	/*!< Next arg is backend for kdbCommit()*/
+	ELEKTRA_PLUGIN_THREADSAFE=1<<6,	/*!< Next arg is an int, non-zero if kdbGet() may run concurrently */
+	ELEKTRA_PLUGIN_CHECKUPDATE=1<<7,	/*!< Next arg is backend for the batched update check of resolvers */
 	ELEKTRA_PLUGIN_END=0		/*!< End of arguments */
 	// clang-format on
 } plugin_t;
@@ -18,6 +18,7 @@
 #include <kdbmacros.h>
 #include <kdbnotificationinternal.h>
 #include <kdbplugin.h>
+#include <kdbtrace.h>
 #include <kdbtypes.h>
 #ifdef ELEKTRA_ENABLE_OPTIMIZATIONS
 #include <kdbopmphm.h>
@@ -32,6 +33,10 @@
 	it says how much can actually be stored.*/
 #define KEYSET_SIZE 16
 
+/** KeySets with at least this many keys get name prefixes for binary searches,
+	see KeySet.prefixes */
+#define KEYSET_PREFIX_MINSIZE 128
+
 /** How many plugins can exist in an backend. */
 #define NR_OF_PLUGINS 10
 
@@ -78,6 +83,10 @@ extern "C" {
 typedef struct _Trie Trie;
 typedef struct _Split Split;
 typedef struct _Backend Backend;
+typedef struct _ElektraArena ElektraArena;
+typedef struct _ElektraKsBuilder ElektraKsBuilder;
+typedef struct _ElektraWatch ElektraWatch;
+typedef struct _ElektraTrace ElektraTrace;
 
 
 /* These define the type for pointers to all the kdb functions */
@@ -88,6 +97,7 @@ typedef int (*kdbGetPtr) (Plugin * handle, KeySet * returned, Key * parentKey);
 typedef int (*kdbSetPtr) (Plugin * handle, KeySet * returned, Key * parentKey);
 typedef int (*kdbErrorPtr) (Plugin * handle, KeySet * returned, Key * parentKey);
 typedef int (*kdbCommitPtr) (Plugin * handle, KeySet * returned, Key * parentKey);
+typedef int (*kdbCheckUpdatePtr) (Plugin ** handles, KeySet ** returned, Key ** parentKeys, int * results, size_t size, Key * errorKey);
 
 typedef Backend * (*OpenMapper) (const char *, const char *, KeySet *);
 typedef int (*CloseMapper) (Backend *);
@@ -146,11 +156,26 @@ typedef enum {
 			 This flag is set once a Key name has been moved to a mapped region,
 			 and is removed if the name moves out of the mapped region.
 			 It prevents erroneous free() calls on these keys. */
-	KEY_FLAG_MMAP_DATA = 1 << 6	/*!<
+	KEY_FLAG_MMAP_DATA = 1 << 6,	/*!<
 			 Key value lies inside a mmap region.
 			 This flag is set once a Key value has been moved to a mapped region,
 			 and is removed if the value moves out of the mapped region.
 			 It prevents erroneous free() calls on these keys. */
+	KEY_FLAG_ARENA = 1 << 7,	/*!<
+			 Key struct lies inside the arena of a KeySet.
+			 This flag is set together with KEY_FLAG_MMAP_STRUCT for Keys
+			 created by ksArenaKeyNew(). keyDel() releases the arena
+			 instead of freeing the struct. */
+	KEY_FLAG_OWNER = 1 << 8,	/*!<
+			 Key might have the metadata owner.
+			 This flag is set when owner is set or copied and whenever
+			 the metadata is handed out by keyMeta(). Keys without this flag
+			 have no owner, so keyCmp() does not need to look it up. */
+	KEY_FLAG_META_PRIVATE = 1 << 9	/*!<
+			 The metadata keyset of the Key is never shared.
+			 This flag is set when the metadata is handed out by keyMeta()
+			 or its cursor is used. Copies of such Keys get a copy of the
+			 metadata keyset, see elektraMetaShare(). */
 } keyflag_t;
 
 
@@ -290,11 +315,42 @@ struct _KeySet
 	 */
 	ksflag_t flags;
 
+	/**
+	 * The arena for Keys created by ksArenaKeyNew(), NULL if not created by ksNewArena().
+	 */
+	ElektraArena * arena;
+
+	/**
+	 * Name prefixes of the keys, parallel to array, NULL if not built.
+	 *
+	 * Every prefix holds eight bytes of the unescaped name after the first prefixSkip
+	 * bytes, which all keys have in common. Binary searches compare prefixes first and
+	 * only dereference the keys whose prefix matches.
+	 */
+	uint64_t * prefixes;
+	size_t prefixAlloc; /**< Allocated size of prefixes */
+	size_t prefixSkip;  /**< Size of the common start of all unescaped names */
+
+	/**
+	 * Number of further Keys which share this KeySet as their metadata.
+	 *
+	 * Metadata is shared by keyDup(), keyCopy() and keyCopyAllMeta() and
+	 * copied before a Key changes it, see elektraMetaUnshare().
+	 * Only changed with atomic operations, the Keys might be used by
+	 * different threads. A shared KeySet is not changed at all, not
+	 * even its cursor.
+	 */
+	size_t shared;
+
 #ifdef ELEKTRA_ENABLE_OPTIMIZATIONS
 	/**
 	 * The Order Preserving Minimal Perfect Hash Map.
 	 */
 	Opmphm * opmphm;
+	/**
+	 * Insertions and removals since the OPMPHM was build.
+	 */
+	OpmphmDelta * opmphmDelta;
 	/**
 	 * The Order Preserving Minimal Perfect Hash Map Predictor.
 	 */
@@ -342,6 +398,38 @@ struct _KDB
 	KeySet * global; /*!< This keyset can be used by plugins to pass data through
 			the KDB and communicate with other plugins. Plugins shall clean
 			up their parts of the global keyset, which they do not need any more.*/
+
+	size_t getWorkers; /*!< How many threads kdbGet() may use to read backends,
+			0 or 1 for sequential reading. @see kdbEnsure() */
+
+	ElektraWatch * watch; /*!< Tracks changes of the resolved files, 0 if disabled.
+			@see elektraIoWatchEnable() */
+
+	ElektraTrace * trace; /*!< Records the phases of kdbGet() and kdbSet(), 0 if disabled.
+			@see elektraTraceEnable() */
+};
+
+
+/**
+ * Tracks changes of the files resolved by kdbGet().
+ *
+ * Implemented in libelektra-io, see elektraIoWatchEnable().
+ * kdbGet() only asks the resolvers of backends whose files may have changed.
+ */
+struct _ElektraWatch
+{
+	/** Called once by kdbGet() before it checks for updates */
+	void (*refresh) (ElektraWatch * watch);
+
+	/** Returns 1 if the file of the backend did not change since the resolver
+	 * last checked it and sets the file as value of @p parentKey, otherwise 0 */
+	int (*isClean) (ElektraWatch * watch, Backend * backend, Key * parentKey);
+
+	/** Called after the resolver checked the file, which is the value of @p parentKey */
+	void (*checked) (ElektraWatch * watch, Backend * backend, Key * parentKey);
+
+	/** Frees the watch */
+	void (*close) (ElektraWatch * watch);
 };
 
 
@@ -425,12 +513,17 @@ struct _Plugin
 	kdbSetPtr kdbSet;	  /*!< The pointer to kdbSet_template() of the backend. */
 	kdbErrorPtr kdbError; /*!< The pointer to kdbError_template() of the backend. */
 	kdbCommitPtr kdbCommit; /*!< The pointer to kdbCommit_template() of the backend. */
+	kdbCheckUpdatePtr kdbCheckUpdate; /*!< The pointer to the batched update check of a resolver,
+	   see ELEKTRA_PLUGIN_CHECKUPDATE */
 
 	const char * name; /*!< The name of the module responsible for that plugin. */
 
 	size_t refcounter; /*!< This refcounter shows how often the plugin
 	   is used.  Not shared plugins have 1 in it */
 
+	int threadsafe; /*!< Non-zero if kdbGet() may be called concurrently,
+	   see ELEKTRA_PLUGIN_THREADSAFE */
+
 	void * data; /*!< This handle can be used for a plugin to store
 	 any data its want to. */
 
@@ -549,6 +642,7 @@ Plugin * elektraPluginVersion (void);
 /*Trie handling*/
 int trieClose (Trie * trie, Key * errorKey);
 Backend * trieLookup (Trie * trie, const char * name);
+Backend * trieLookupHierarchy (Trie * trie, const char * name, int * exclusive);
 Trie * trieInsert (Trie * trie, const char * name, Backend * value);
 
 /*Mounting handling */
@@ -561,6 +655,7 @@ int mountBackend (KDB * kdb, Backend * backend, Key * errorKey);
 
 Key * mountGetMountpoint (KDB * handle, const char * where);
 Backend * mountGetBackend (KDB * handle, const char * where);
+Backend * mountGetBackendHierarchy (KDB * handle, const char * where, int * exclusive);
 
 void keyInit (Key * key);
 
@@ -575,8 +670,26 @@ size_t ksGetAlloc (const KeySet * ks);
 KeySet * ksDeepDup (const KeySet * source);
 
 Key * elektraKsPopAtCursor (KeySet * ks, elektraCursor pos);
+Key * ksPopAtInternal (KeySet * ks, size_t position);
 
 ssize_t ksSearchInternal (const KeySet * ks, const Key * toAppend);
+ssize_t ksAppendRangeInternal (KeySet * ks, const KeySet * source, size_t start, size_t end);
+elektraCursor ksFindHierarchy (const KeySet * ks, const Key * root, elektraCursor * end);
+
+/*Arena allocated keys*/
+KeySet * ksNewArena (size_t alloc, size_t arenaSize);
+Key * ksArenaKeyNew (KeySet * ks, const char * name, const char * value);
+void elektraArenaKeyDel (Key * key);
+size_t elektraArenaDupSize (const KeySet * source);
+Key * elektraArenaKeyDup (KeySet * ks, const Key * source);
+void elektraArenaDecRef (ElektraArena * arena);
+
+/*Bulk construction of keysets*/
+ElektraKsBuilder * elektraKsBuilderNew (size_t alloc);
+ssize_t elektraKsBuilderAdd (ElektraKsBuilder * builder, Key * key);
+Key * elektraKsBuilderAddBelow (ElektraKsBuilder * builder, const Key * parent, const char * name, const char * value);
+KeySet * elektraKsBuilderFinish (ElektraKsBuilder * builder);
+void elektraKsBuilderDel (ElektraKsBuilder * builder);
 
 /*Used for internal memcpy/memmove*/
 ssize_t elektraMemcpy (Key ** array1, Key ** array2, size_t size);
@@ -585,6 +698,34 @@ ssize_t elektraMemmove (Key ** array1, Key ** array2, size_t size);
 /*Internally used for array handling*/
 int elektraReadArrayNumber (const char * baseName, kdb_long_long_t * oldIndex);
 
+/*Shared metadata*/
+int elektraMetaShare (Key * dest, const Key * source);
+int elektraMetaUnshare (Key * key);
+void elektraMetaRelease (KeySet * meta);
+
+/*Tracing of kdbGet() and kdbSet()*/
+uint64_t elektraTraceNow (void);
+void elektraTraceRecord (KDB * handle, uint64_t start, ElektraTracePhase phase, const Plugin * plugin, const Backend * backend,
+			 int position, int subPosition, const KeySet * ks);
+
+#ifdef HAVE_TRACE
+#define ELEKTRA_TRACE_BEGIN(handle) ((handle) && (handle)->trace ? elektraTraceNow () : 0)
+#define ELEKTRA_TRACE_END(handle, start, phase, plugin, backend, ks)                                                                       \
+	do                                                                                                                                 \
+	{                                                                                                                                  \
+		if (start) elektraTraceRecord (handle, start, phase, plugin, backend, -1, -1, ks);                                          \
+	} while (0)
+#define ELEKTRA_TRACE_END_GLOBAL(handle, start, plugin, position, subPosition, ks)                                                         \
+	do                                                                                                                                 \
+	{                                                                                                                                  \
+		if (start) elektraTraceRecord (handle, start, ELEKTRA_TRACE_GLOBAL, plugin, 0, position, subPosition, ks);                  \
+	} while (0)
+#else
+#define ELEKTRA_TRACE_BEGIN(handle) ((void) (handle), (uint64_t) 0)
+#define ELEKTRA_TRACE_END(handle, start, phase, plugin, backend, ks) ((void) (start), (void) (phase))
+#define ELEKTRA_TRACE_END_GLOBAL(handle, start, plugin, position, subPosition, ks) (void) (start)
+#endif
+
 
 KeySet * ksRenameKeys (KeySet * config, const char * name);
 
@@ -626,6 +767,23 @@ int elektraGlobalError (KDB * handle, KeySet * ks, Key * parentKey, int position
 extern "C" {
 #endif
 
+/**
+ * Number of entries in the key cache of the high-level API, must be a power of two.
+ */
+#define ELEKTRA_KEY_CACHE_SIZE 512
+
+/**
+ * Key resolved by the high-level API, see elektraFindCachedKey().
+ */
+typedef struct _ElektraCachedKey
+{
+	char * name;		 /**<The relative name of the key, as passed by the caller */
+	kdb_long_long_t index;	 /**<The index of the array element, -1 for keys that are no array elements */
+	size_t generation;	 /**<The generation of the configuration, in which the key was resolved */
+	KDBType type;		 /**<The type, which was checked last */
+	Key * key;		 /**<The resolved key */
+} ElektraCachedKey;
+
 struct _Elektra
 {
 	KDB * kdb;
@@ -636,6 +794,10 @@ struct _Elektra
 	ElektraErrorHandler fatalErrorHandler;
 	char * resolvedReference;
 	size_t parentKeyLength;
+	/** Incremented whenever config may have changed, invalidates keyCache */
+	size_t generation;
+	/** Resolved keys, allocated with the first lookup */
+	ElektraCachedKey * keyCache;
 };
 
 struct _ElektraError
@@ -656,6 +818,7 @@ struct _ElektraError
 void elektraSaveKey (Elektra * elektra, Key * key, ElektraError ** error);
 void elektraSetLookupKey (Elektra * elektra, const char * name);
 void elektraSetArrayLookupKey (Elektra * elektra, const char * name, kdb_long_long_t index);
+Key * elektraFindCachedKey (Elektra * elektra, const char * name, kdb_long_long_t index, KDBType type);
 
 ElektraError * elektraErrorCreate (const char * code, const char * description, const char * module, const char * file, kdb_long_t line);
 void elektraErrorAddWarning (ElektraError * error, ElektraError * warning);
@@ -0,0 +1,85 @@
+/**
+ * @file
+ *
+ * @brief Tracing of the phases of kdbGet() and kdbSet().
+ *
+ * Tracing is experimental, the recorded events may change with every release.
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ */
+#ifndef KDBTRACE_H_
+#define KDBTRACE_H_
+
+#include <kdb.h>
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+namespace ckdb
+{
+extern "C" {
+#endif
+
+/**
+ * The phases of kdbGet() and kdbSet() that are traced
+ *
+ * @ingroup kdbtrace
+ */
+typedef enum
+{
+	ELEKTRA_TRACE_GET,	/*!< a whole kdbGet() */
+	ELEKTRA_TRACE_SET,	/*!< a whole kdbSet() */
+	ELEKTRA_TRACE_CACHE,	/*!< loading the cache */
+	ELEKTRA_TRACE_RESOLVER, /*!< resolvers checking for updates or resolving files */
+	ELEKTRA_TRACE_PLUGIN,	/*!< another plugin of a backend */
+	ELEKTRA_TRACE_STORAGE,	/*!< the storage plugin of a backend */
+	ELEKTRA_TRACE_COMMIT,	/*!< a plugin of a backend committing changes */
+	ELEKTRA_TRACE_ROLLBACK, /*!< a plugin of a backend rolling back changes */
+	ELEKTRA_TRACE_GLOBAL,	/*!< a global plugin */
+	ELEKTRA_TRACE_SPLIT,	/*!< dividing keys into backends or merging them */
+} ElektraTracePhase;
+
+/**
+ * The formats elektraTraceDump() can write
+ *
+ * @ingroup kdbtrace
+ */
+typedef enum
+{
+	ELEKTRA_TRACE_FORMAT_JSON,   /*!< a JSON array with one object per event */
+	ELEKTRA_TRACE_FORMAT_CHROME, /*!< the Trace Event Format of Chrome (`about:tracing`) and Perfetto */
+} ElektraTraceFormat;
+
+/**
+ * An event recorded by the tracing of a KDB instance
+ *
+ * The strings are owned by the KDB instance and valid until kdbClose().
+ *
+ * @ingroup kdbtrace
+ */
+typedef struct _ElektraTraceEvent
+{
+	ElektraTracePhase phase;
+	const char * plugin;	  /*!< name of the plugin or NULL */
+	const char * backend;	  /*!< mountpoint of the backend or NULL */
+	const char * position;	  /*!< position of a global plugin, e.g. `PREGETSTORAGE`, or NULL */
+	const char * subPosition; /*!< subposition of a global plugin, e.g. `MAXONCE`, or NULL */
+	uint64_t start;		  /*!< start in nanoseconds of a monotonic clock */
+	uint64_t duration;	  /*!< duration in nanoseconds */
+	uint64_t thread;	  /*!< identifies the thread that ran the phase */
+	size_t keys;		  /*!< size of the keyset afterwards */
+	size_t bytes;		  /*!< size of names and values afterwards, only for whole operations and storage plugins */
+} ElektraTraceEvent;
+
+int elektraTraceEnable (KDB * kdb, size_t capacity);
+void elektraTraceDisable (KDB * kdb);
+size_t elektraTraceRead (KDB * kdb, ElektraTraceEvent * events, size_t size);
+int elektraTraceDump (const ElektraTraceEvent * events, size_t size, ElektraTraceFormat format, FILE * file);
+
+#ifdef __cplusplus
+}
+}
+#endif
+
+#endif
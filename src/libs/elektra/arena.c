@@ -0,0 +1,304 @@
+/**
+ * @file
+ *
+ * @brief Arena allocation for keys of a KeySet.
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ */
+
+#include <string.h>
+
+#include <kdbassert.h>
+#include <kdbprivate.h>
+
+/** size of the first block, if no size was given to ksNewArena() */
+#define ELEKTRA_ARENA_BLOCK_SIZE (64 * 1024)
+/** blocks grow up to this size */
+#define ELEKTRA_ARENA_BLOCK_SIZE_MAX (4 * 1024 * 1024)
+/** alignment of all allocations within the arena */
+#define ELEKTRA_ARENA_ALIGN (sizeof (void *))
+
+typedef struct _ElektraArenaBlock ElektraArenaBlock;
+
+/**
+ * @internal
+ *
+ * A single memory region of the arena, the data follows the header.
+ */
+struct _ElektraArenaBlock
+{
+	ElektraArenaBlock * next; /*!< previously allocated block */
+	size_t size;		  /*!< usable bytes after the header */
+	size_t used;		  /*!< allocated bytes after the header */
+};
+
+/**
+ * @internal
+ *
+ * The arena of a KeySet created with ksNewArena().
+ *
+ * Every Key allocated in the arena holds a reference, as well as the KeySet.
+ * Once all references are gone, all blocks are freed at once.
+ * The references are counted atomically, like KeySet.shared, because the
+ * Keys might be deleted by different threads.
+ */
+struct _ElektraArena
+{
+	ElektraArenaBlock * blocks; /*!< the current block, older blocks are linked */
+	size_t blockSize;	    /*!< size of the next block */
+	size_t refs;		    /*!< KeySet and Keys still using the arena, changed atomically */
+	char * scratch;		    /*!< buffer reused for canonicalizing names */
+	size_t scratchSize;	    /*!< size of scratch */
+};
+
+/**
+ * @internal
+ *
+ * @brief Allocates @p size bytes from the arena, adds a new block if needed.
+ *
+ * @retval NULL on memory error
+ */
+static void * elektraArenaAlloc (ElektraArena * arena, size_t size)
+{
+	size = (size + ELEKTRA_ARENA_ALIGN - 1) & ~(ELEKTRA_ARENA_ALIGN - 1);
+
+	ElektraArenaBlock * block = arena->blocks;
+	if (!block || block->size - block->used < size)
+	{
+		size_t blockSize = arena->blockSize > size ? arena->blockSize : size;
+		block = elektraMalloc (sizeof (ElektraArenaBlock) + blockSize);
+		if (!block) return NULL;
+		block->next = arena->blocks;
+		block->size = blockSize;
+		block->used = 0;
+		arena->blocks = block;
+		if (arena->blockSize < ELEKTRA_ARENA_BLOCK_SIZE_MAX) arena->blockSize *= 2;
+	}
+
+	void * ret = (char *) (block + 1) + block->used;
+	block->used += size;
+	return ret;
+}
+
+/**
+ * @internal
+ *
+ * @brief Drops a reference of the arena, frees it with the last one.
+ *
+ * @param arena the arena to release
+ */
+void elektraArenaDecRef (ElektraArena * arena)
+{
+	ELEKTRA_NOT_NULL (arena);
+	ELEKTRA_ASSERT (__atomic_load_n (&arena->refs, __ATOMIC_RELAXED) > 0, "arena without references");
+	if (__atomic_sub_fetch (&arena->refs, 1, __ATOMIC_ACQ_REL) > 0) return;
+
+	ElektraArenaBlock * block = arena->blocks;
+	while (block)
+	{
+		ElektraArenaBlock * next = block->next;
+		elektraFree (block);
+		block = next;
+	}
+	elektraFree (arena->scratch);
+	elektraFree (arena);
+}
+
+/**
+ * @internal
+ *
+ * @brief Releases the arena of a Key allocated with ksArenaKeyNew().
+ *
+ * Must be the last access to @p key, the Key struct itself might be freed.
+ *
+ * @param key the Key with KEY_FLAG_ARENA set
+ */
+void elektraArenaKeyDel (Key * key)
+{
+	ELEKTRA_ASSERT (test_bit (key->flags, KEY_FLAG_ARENA), "key not allocated in an arena");
+	// the arena is stored right before the Key struct
+	elektraArenaDecRef (((ElektraArena **) key)[-1]);
+}
+
+/**
+ * @brief Creates a KeySet with an arena for its keys.
+ *
+ * Keys created with ksArenaKeyNew() share a few large memory blocks
+ * instead of allocating their struct, names and value separately.
+ * The blocks are freed at once, after the KeySet and the last Key
+ * allocated in the arena were deleted.
+ *
+ * Otherwise the KeySet behaves like one created with ksNew().
+ * Appending Keys which were created with keyNew() is allowed and
+ * arena Keys may be appended to other KeySets.
+ *
+ * @note Creating Keys in the arena is not thread-safe. Keys of one
+ * arena may be deleted concurrently.
+ *
+ * @param alloc the allocation size of the KeySet array, see ksNew()
+ * @param arenaSize the size of the first block in bytes, or 0 for a default
+ *
+ * @return the new KeySet
+ * @retval NULL on memory error
+ * @see ksArenaKeyNew(), ksNew()
+ */
+KeySet * ksNewArena (size_t alloc, size_t arenaSize)
+{
+	ElektraArena * arena = elektraCalloc (sizeof (ElektraArena));
+	if (!arena) return NULL;
+
+	KeySet * ks = ksNew (alloc, KS_END);
+	if (!ks)
+	{
+		elektraFree (arena);
+		return NULL;
+	}
+
+	arena->blockSize = arenaSize ? arenaSize : ELEKTRA_ARENA_BLOCK_SIZE;
+	arena->refs = 1;
+	ks->arena = arena;
+	return ks;
+}
+
+/**
+ * @internal
+ *
+ * @brief Allocates a Key with room for its names and value in the arena.
+ *
+ * The pointers to the names and the value point to the allocated room,
+ * the sizes are set. If @p dataSize is 0, the Key has no value.
+ *
+ * @retval NULL on memory error
+ */
+static Key * elektraArenaKeyAlloc (ElektraArena * arena, size_t keySize, size_t keyUSize, size_t dataSize)
+{
+	char * mem = elektraArenaAlloc (arena, sizeof (ElektraArena *) + sizeof (Key) + keySize + keyUSize + dataSize);
+	if (!mem) return NULL;
+
+	// the arena is stored right before the Key struct, see elektraArenaKeyDel()
+	*(ElektraArena **) mem = arena;
+	Key * key = (Key *) (mem + sizeof (ElektraArena *));
+	keyInit (key);
+
+	key->key = (char *) (key + 1);
+	key->keySize = keySize;
+	key->ukey = key->key + keySize;
+	key->keyUSize = keyUSize;
+	key->flags = KEY_FLAG_SYNC | KEY_FLAG_ARENA | KEY_FLAG_MMAP_STRUCT | KEY_FLAG_MMAP_KEY;
+	if (dataSize > 0)
+	{
+		key->data.c = key->ukey + keyUSize;
+		key->dataSize = dataSize;
+		set_bit (key->flags, KEY_FLAG_MMAP_DATA);
+	}
+
+	__atomic_add_fetch (&arena->refs, 1, __ATOMIC_RELAXED);
+	return key;
+}
+
+/**
+ * @brief Creates a new Key within the arena of the KeySet.
+ *
+ * The Key struct, its names and @p value are allocated in the arena
+ * of @p ks. The Key is not appended to @p ks, use ksAppendKey() with
+ * @p ks or any other KeySet for that.
+ *
+ * Changing name or value later is allowed, the new name or value will
+ * be allocated as usual then.
+ *
+ * @param ks a KeySet created with ksNewArena()
+ * @param name a valid name for the Key, see keyNew()
+ * @param value the string value of the Key or NULL
+ *
+ * @return the new Key
+ * @retval NULL if @p ks has no arena, @p name is invalid or on memory error
+ * @see ksNewArena(), keyNew()
+ */
+Key * ksArenaKeyNew (KeySet * ks, const char * name, const char * value)
+{
+	if (!ks || !ks->arena || !name) return NULL;
+	if (!elektraKeyNameValidate (name, true)) return NULL;
+
+	ElektraArena * arena = ks->arena;
+
+	size_t keySize = arena->scratchSize;
+	size_t keyUSize = 0;
+	elektraKeyNameCanonicalize (name, &arena->scratch, &keySize, 0, &keyUSize);
+	arena->scratchSize = keySize;
+	size_t dataSize = value ? strlen (value) + 1 : 0;
+
+	Key * key = elektraArenaKeyAlloc (arena, keySize, keyUSize, dataSize);
+	if (!key) return NULL;
+
+	memcpy (key->key, arena->scratch, keySize);
+	elektraKeyNameUnescape (key->key, key->ukey);
+	if (value)
+	{
+		memcpy (key->data.c, value, dataSize);
+	}
+	return key;
+}
+
+/**
+ * @internal
+ *
+ * @brief Bytes of the arena needed to duplicate all keys of @p source.
+ *
+ * @param source the KeySet to duplicate with elektraArenaKeyDup()
+ *
+ * @return the size for ksNewArena()
+ */
+size_t elektraArenaDupSize (const KeySet * source)
+{
+	size_t size = 0;
+	for (size_t i = 0; i < source->size; ++i)
+	{
+		const Key * key = source->array[i];
+		size_t keySize = sizeof (ElektraArena *) + sizeof (Key) + key->keySize + key->keyUSize + key->dataSize;
+		size += (keySize + ELEKTRA_ARENA_ALIGN - 1) & ~(ELEKTRA_ARENA_ALIGN - 1);
+	}
+	return size;
+}
+
+/**
+ * @internal
+ *
+ * @brief Duplicates a Key within the arena of the KeySet, see keyDup().
+ *
+ * Names and value of @p source are copied into the arena. The metadata
+ * is shared with @p source until one of them changes it, like with keyDup().
+ *
+ * @param ks a KeySet created with ksNewArena()
+ * @param source the Key to duplicate
+ *
+ * @return the duplicate, with the same sync state as @p source
+ * @retval NULL on memory error
+ */
+Key * elektraArenaKeyDup (KeySet * ks, const Key * source)
+{
+	ELEKTRA_NOT_NULL (ks->arena);
+
+	size_t dataSize = source->data.v ? source->dataSize : 0;
+	Key * key = elektraArenaKeyAlloc (ks->arena, source->keySize, source->keyUSize, dataSize);
+	if (!key) return NULL;
+
+	memcpy (key->key, source->key, source->keySize);
+	memcpy (key->ukey, source->ukey, source->keyUSize);
+	if (dataSize > 0)
+	{
+		memcpy (key->data.v, source->data.v, dataSize);
+	}
+
+	if (elektraMetaShare (key, source) == -1)
+	{
+		elektraArenaKeyDel (key);
+		return NULL;
+	}
+
+	key->flags |= source->flags & KEY_FLAG_OWNER;
+	if (!test_bit (source->flags, KEY_FLAG_SYNC))
+	{
+		clear_bit (key->flags, (keyflag_t) KEY_FLAG_SYNC);
+	}
+	return key;
+}
@@ -20,7 +20,9 @@ int elektraGlobalGet (KDB * handle, KeySet * ks, Key * parentKey, int position,
 	Plugin * plugin;
 	if (handle && (plugin = handle->globalPlugins[position][subPosition]))
 	{
+		uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 		ret = plugin->kdbGet (plugin, ks, parentKey);
+		ELEKTRA_TRACE_END_GLOBAL (handle, traceStart, plugin, position, subPosition, ks);
 	}
 	return ret;
 }
@@ -31,7 +33,9 @@ int elektraGlobalSet (KDB * handle, KeySet * ks, Key * parentKey, int position,
 	Plugin * plugin;
 	if (handle && (plugin = handle->globalPlugins[position][subPosition]))
 	{
+		uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 		ret = plugin->kdbSet (plugin, ks, parentKey);
+		ELEKTRA_TRACE_END_GLOBAL (handle, traceStart, plugin, position, subPosition, ks);
 	}
 	return ret;
 }
@@ -42,7 +46,9 @@ int elektraGlobalError (KDB * handle, KeySet * ks, Key * parentKey, int position
 	Plugin * plugin;
 	if (handle && (plugin = handle->globalPlugins[position][subPosition]))
 	{
+		uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 		ret = plugin->kdbError (plugin, ks, parentKey);
+		ELEKTRA_TRACE_END_GLOBAL (handle, traceStart, plugin, position, subPosition, ks);
 	}
 	return ret;
 }
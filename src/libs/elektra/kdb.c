@@ -45,6 +45,10 @@
 #include <errno.h>
 #endif
 
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
 #include <kdbinternal.h>
 
 
@@ -406,6 +410,8 @@ int kdbClose (KDB * handle, Key * errorKey)
 
 	Key * initialParent = keyDup (errorKey);
 	int errnosave = errno;
+	if (handle->watch) handle->watch->close (handle->watch);
+	elektraTraceDisable (handle);
 	splitDel (handle->split);
 
 	trieClose (handle->trie, errorKey);
@@ -449,20 +455,133 @@ int kdbClose (KDB * handle, Key * errorKey)
 	return 0;
 }
 
+/**
+ * @internal
+ *
+ * How the update check of a backend was done in elektraGetCheckUpdateNeeded().
+ */
+typedef enum
+{
+	CHECK_SEQUENTIAL = 0, ///< by calling kdbGet() of the resolver
+	CHECK_BATCHED,	      ///< by the batched update check of the resolver
+	CHECK_WATCHED,	      ///< not at all, the file did not change according to the watch
+} CheckMode;
+
+/**
+ * @internal
+ *
+ * @brief Run the batched update checks of the resolvers.
+ *
+ * All backends whose resolvers export the same check function
+ * (see ELEKTRA_PLUGIN_CHECKUPDATE) are checked with a single call,
+ * so that the resolver can check all their files in one pass.
+ *
+ * @param handle the KDB instance, for tracing
+ * @param split the split to work with
+ * @param parentKey to add warnings and errors
+ * @param results receives what the kdbGet() of the resolver would have returned
+ * @param modes is set to CHECK_BATCHED for every backend that was checked,
+ *        backends with another mode than CHECK_SEQUENTIAL are skipped
+ *
+ * @retval 0 on success
+ * @retval -1 if a check failed
+ */
+static int elektraGetCheckUpdateBatched (KDB * handle, Split * split, Key * parentKey, int * results, char * modes)
+{
+	size_t size = split->size;
+	Plugin ** handles = elektraMalloc (size * (sizeof (Plugin *) + sizeof (KeySet *) + sizeof (Key *) + sizeof (size_t)));
+	int * groupResults = elektraMalloc (size * sizeof (int));
+	if (!handles || !groupResults)
+	{
+		// not batched, all backends are checked one by one
+		elektraFree (handles);
+		elektraFree (groupResults);
+		return 0;
+	}
+	KeySet ** keysets = (KeySet **) (handles + size);
+	Key ** parents = (Key **) (keysets + size);
+	size_t * indices = (size_t *) (parents + size);
+
+	int ret = 0;
+	for (size_t i = 0; i < size && ret == 0; i++)
+	{
+		Plugin * first = split->handles[i]->getplugins[RESOLVER_PLUGIN];
+		if (modes[i] != CHECK_SEQUENTIAL || !first || !first->kdbCheckUpdate) continue;
+
+		size_t count = 0;
+		for (size_t j = i; j < size; j++)
+		{
+			Plugin * resolver = split->handles[j]->getplugins[RESOLVER_PLUGIN];
+			if (modes[j] != CHECK_SEQUENTIAL || !resolver || resolver->kdbCheckUpdate != first->kdbCheckUpdate) continue;
+
+			ksRewind (split->keysets[j]);
+			keySetString (split->parents[j], "");
+			handles[count] = resolver;
+			keysets[count] = split->keysets[j];
+			parents[count] = split->parents[j];
+			indices[count] = j;
+			modes[j] = CHECK_BATCHED;
+			++count;
+		}
+
+		uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
+		if (first->kdbCheckUpdate (handles, keysets, parents, groupResults, count, parentKey) == ELEKTRA_PLUGIN_STATUS_ERROR)
+		{
+			ret = -1;
+		}
+		ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_RESOLVER, first, 0, 0);
+
+		for (size_t k = 0; k < count; k++)
+		{
+			results[indices[k]] = ret == -1 ? ELEKTRA_PLUGIN_STATUS_ERROR : groupResults[k];
+		}
+	}
+
+	elektraFree (handles);
+	elektraFree (groupResults);
+	return ret;
+}
+
 /**
  * @internal
  *
  * @brief Check if an update is needed at all
  *
+ * Backends whose files did not change according to the watch of @p handle
+ * are skipped. Resolvers with a batched update check are run next,
+ * see elektraGetCheckUpdateBatched().
+ *
  * @retval -2 cache hit
  * @retval -1 an error occurred
  * @retval 0 no update needed
  * @retval number of plugins which need update
  */
-static int elektraGetCheckUpdateNeeded (Split * split, Key * parentKey)
+static int elektraGetCheckUpdateNeeded (KDB * handle, Split * split, Key * parentKey)
 {
 	int updateNeededOccurred = 0;
 	size_t cacheHits = 0;
+
+	int * results = split->size ? elektraMalloc (split->size * sizeof (int)) : 0;
+	char * modes = split->size ? elektraCalloc (split->size) : 0;
+	if (results && modes && handle->watch)
+	{
+		handle->watch->refresh (handle->watch);
+		for (size_t i = 0; i < split->size; i++)
+		{
+			if (handle->watch->isClean (handle->watch, split->handles[i], split->parents[i]))
+			{
+				modes[i] = CHECK_WATCHED;
+				results[i] = ELEKTRA_PLUGIN_STATUS_NO_UPDATE;
+			}
+		}
+	}
+	if (results && modes && elektraGetCheckUpdateBatched (handle, split, parentKey, results, modes) == -1)
+	{
+		elektraFree (results);
+		elektraFree (modes);
+		return -1;
+	}
+
 	for (size_t i = 0; i < split->size; i++)
 	{
 		int ret = -1;
@@ -470,12 +589,21 @@ static int elektraGetCheckUpdateNeeded (Split * split, Key * parentKey)
 		clear_bit (split->syncbits[i], (splitflag_t) SPLIT_FLAG_SYNC);
 
 		Plugin * resolver = backend->getplugins[RESOLVER_PLUGIN];
-		if (resolver && resolver->kdbGet)
+		if (modes && modes[i] != CHECK_SEQUENTIAL)
+		{
+			ret = results[i];
+			ELEKTRA_LOG_DEBUG ("backend: %s,%s ;; ret: %d", keyName (split->parents[i]), keyString (split->parents[i]), ret);
+
+			backendUpdateSize (backend, split->parents[i], 0);
+		}
+		else if (resolver && resolver->kdbGet)
 		{
 			ksRewind (split->keysets[i]);
 			keySetName (parentKey, keyName (split->parents[i]));
 			keySetString (parentKey, "");
+			uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 			ret = resolver->kdbGet (resolver, split->keysets[i], parentKey);
+			ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_RESOLVER, resolver, backend, split->keysets[i]);
 			// store resolved filename
 			keySetString (split->parents[i], keyString (parentKey));
 			// no keys in that backend
@@ -485,6 +613,11 @@ static int elektraGetCheckUpdateNeeded (Split * split, Key * parentKey)
 		}
 		// TODO: set error in else case!
 
+		if (handle->watch && ret != ELEKTRA_PLUGIN_STATUS_ERROR && (!modes || modes[i] != CHECK_WATCHED))
+		{
+			handle->watch->checked (handle->watch, backend, split->parents[i]);
+		}
+
 		switch (ret)
 		{
 		case ELEKTRA_PLUGIN_STATUS_CACHE_HIT:
@@ -505,10 +638,28 @@ static int elektraGetCheckUpdateNeeded (Split * split, Key * parentKey)
 		case ELEKTRA_PLUGIN_STATUS_ERROR:
 			// Ohh, an error occurred, lets stop the
 			// process.
+			elektraFree (results);
+			elektraFree (modes);
 			return -1;
 		}
 	}
 
+	// leave parentKey as the sequential checks would: with the name and file of the last backend
+	for (size_t i = split->size; modes && i > 0; i--)
+	{
+		Plugin * resolver = split->handles[i - 1]->getplugins[RESOLVER_PLUGIN];
+		if (!resolver || !resolver->kdbGet) continue;
+		if (modes[i - 1] != CHECK_SEQUENTIAL)
+		{
+			keySetName (parentKey, keyName (split->parents[i - 1]));
+			keySetString (parentKey, keyString (split->parents[i - 1]));
+		}
+		break;
+	}
+
+	elektraFree (results);
+	elektraFree (modes);
+
 	if (cacheHits == split->size)
 	{
 		ELEKTRA_LOG_DEBUG ("all backends report cache is up-to-date");
@@ -524,15 +675,297 @@ typedef enum
 	LAST
 } UpdatePass;
 
+/**
+ * @internal
+ * @brief Run the get plugins of one backend from position @p start up to (excluding) @p end.
+ *
+ * @param handle the KDB instance, for tracing
+ * @param split the split to work with
+ * @param i the index of the backend in @p split
+ * @param parentKey receives the name and the resolved file of the backend,
+ *        errors and warnings of the plugins are added to it
+ * @param start the first plugin position to run
+ * @param end the position after the last plugin to run
+ *
+ * @retval -1 on error
+ * @retval 0 on success
+ */
+static int elektraGetDoBackendUpdate (KDB * handle, Split * split, size_t i, Key * parentKey, size_t start, size_t end)
+{
+	Backend * backend = split->handles[i];
+	ksRewind (split->keysets[i]);
+	keySetName (parentKey, keyName (split->parents[i]));
+	keySetString (parentKey, keyString (split->parents[i]));
+
+	for (size_t p = start; p < end; ++p)
+	{
+		int ret = 0;
+		if (backend->getplugins[p] && backend->getplugins[p]->kdbGet)
+		{
+			uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
+			ret = backend->getplugins[p]->kdbGet (backend->getplugins[p], split->keysets[i], parentKey);
+			ELEKTRA_TRACE_END (handle, traceStart, p == STORAGE_PLUGIN ? ELEKTRA_TRACE_STORAGE : ELEKTRA_TRACE_PLUGIN,
+					   backend->getplugins[p], backend, split->keysets[i]);
+		}
+
+		if (ret == -1)
+		{
+			// Ohh, an error occurred,
+			// lets stop the process.
+			return -1;
+		}
+	}
+	return 0;
+}
+
+#ifdef HAVE_PTHREAD_H
+
+static int copyError (Key * dest, Key * src);
+
+/**
+ * @internal
+ * @brief State shared between the workers of elektraGetDoUpdateParallel()
+ */
+typedef struct
+{
+	KDB * handle;
+	Split * split;
+	Key ** parentKeys; /*!< Private parent key per backend, NULL if the backend is read sequentially */
+	int * results;	   /*!< Result of elektraGetDoBackendUpdate() per backend */
+	size_t size;	   /*!< Number of backends (without the default split) */
+	size_t start;	   /*!< First plugin position to run */
+	size_t end;	   /*!< Position after the last plugin to run */
+	size_t next;	   /*!< Next backend to take, protected by mutex */
+	pthread_mutex_t mutex;
+} ElektraGetWorkers;
+
+/**
+ * @internal
+ * @brief Takes backends from the shared queue until no backend is left.
+ */
+static void * elektraGetWorker (void * data)
+{
+	ElektraGetWorkers * work = data;
+
+	while (1)
+	{
+		pthread_mutex_lock (&work->mutex);
+		while (work->next < work->size && !work->parentKeys[work->next])
+		{
+			++work->next;
+		}
+		size_t i = work->next++;
+		pthread_mutex_unlock (&work->mutex);
+
+		if (i >= work->size) break;
+
+		work->results[i] = elektraGetDoBackendUpdate (work->handle, work->split, i, work->parentKeys[i], work->start, work->end);
+	}
+	return 0;
+}
+
+/**
+ * @internal
+ * @brief Calculates the name of the warning after @p lastWarning
+ *
+ * Uses the same numbering as the ELEKTRA_ADD_*_WARNING macros,
+ * which wrap around after `#_99`.
+ *
+ * @param lastWarning the value of the `warnings` metakey or NULL
+ * @param buffer receives the array element, e.g. `#3` or `#_12`
+ */
+static void elektraGetNextWarning (const char * lastWarning, char buffer[ELEKTRA_MAX_ARRAY_SIZE])
+{
+	int i = 0;
+	if (lastWarning && strcmp (lastWarning, "#_99") < 0)
+	{
+		i = lastWarning[1] == '_' ? ((lastWarning[2] - '0') * 10 + (lastWarning[3] - '0')) : (lastWarning[1] - '0');
+		i = (i + 1) % 100;
+	}
+	elektraWriteArrayNumber (buffer, i);
+}
+
+/**
+ * @internal
+ * @brief Appends all warnings of @p src to the warnings of @p dest
+ *
+ * @param dest the key to add the warnings to
+ * @param src the key to take the warnings from
+ */
+static void elektraGetCopyWarnings (Key * dest, Key * src)
+{
+	if (!keyGetMeta (src, "warnings")) return;
+
+	const char prefix[] = "meta:/warnings/#";
+	char current[ELEKTRA_MAX_ARRAY_SIZE] = "";
+	char target[ELEKTRA_MAX_ARRAY_SIZE] = "";
+	char * name = 0;
+
+	KeySet * meta = keyMeta (src);
+	for (elektraCursor it = 0; it < ksGetSize (meta); ++it)
+	{
+		const Key * cur = ksAtCursor (meta, it);
+		if (strncmp (keyName (cur), prefix, sizeof (prefix) - 1) != 0) continue;
+
+		const char * element = keyName (cur) + sizeof (prefix) - 2;
+		const char * rest = strchr (element, '/');
+		size_t elementSize = rest ? (size_t) (rest - element) : strlen (element);
+		if (elementSize >= sizeof (current)) continue;
+
+		if (strncmp (current, element, elementSize) != 0 || current[elementSize] != '\0')
+		{
+			// a new warning starts
+			strncpy (current, element, elementSize);
+			current[elementSize] = '\0';
+			const Key * lastWarning = keyGetMeta (dest, "warnings");
+			elektraGetNextWarning (lastWarning ? keyString (lastWarning) : 0, target);
+			keySetMeta (dest, "warnings", target);
+		}
+
+		name = elektraFormat ("warnings/%s%s", target, rest ? rest : "");
+		keySetMeta (dest, name, keyString (cur));
+		elektraFree (name);
+	}
+}
+
+/**
+ * @internal
+ * @brief Do the real update, reading backends on worker threads.
+ *
+ * Backends whose get plugins are all thread-safe (see ELEKTRA_PLUGIN_THREADSAFE)
+ * are read concurrently, every one with a private parent key.
+ * Afterwards warnings and errors are transferred to @p parentKey in the
+ * order of the split, and all other backends are read sequentially in the
+ * same pass. So the outcome is the same as with elektraGetDoUpdate().
+ *
+ * @param handle the KDB instance, for tracing
+ * @param split the split to work with
+ * @param parentKey to add warnings and errors
+ * @param workers the maximum number of threads to use
+ * @param start the first plugin position to run
+ * @param end the position after the last plugin to run
+ *
+ * @retval -1 on error
+ * @retval 0 on success
+ * @retval 1 if less than two backends can be read concurrently, nothing was done
+ */
+static int elektraGetDoUpdateParallel (KDB * handle, Split * split, Key * parentKey, size_t workers, size_t start, size_t end)
+{
+	const int bypassedSplits = 1;
+	ElektraGetWorkers work;
+	size_t concurrent = 0;
+
+	work.handle = handle;
+	work.split = split;
+	work.size = split->size - bypassedSplits;
+	work.next = 0;
+	work.start = start;
+	work.end = end;
+	work.parentKeys = elektraCalloc (sizeof (Key *) * work.size);
+	work.results = elektraCalloc (sizeof (int) * work.size);
+
+	for (size_t i = 0; i < work.size; i++)
+	{
+		if (!test_bit (split->syncbits[i], SPLIT_FLAG_SYNC)) continue;
+
+		Backend * backend = split->handles[i];
+		int threadsafe = 1;
+		for (size_t p = start; p < end; ++p)
+		{
+			Plugin * plugin = backend->getplugins[p];
+			if (plugin && plugin->kdbGet && !plugin->threadsafe) threadsafe = 0;
+		}
+		if (!threadsafe) continue;
+
+		work.parentKeys[i] = keyNew (keyName (split->parents[i]), KEY_END);
+		++concurrent;
+	}
+
+	if (concurrent < 2)
+	{
+		for (size_t i = 0; i < work.size; i++)
+		{
+			keyDel (work.parentKeys[i]);
+		}
+		elektraFree (work.parentKeys);
+		elektraFree (work.results);
+		return 1;
+	}
+
+	if (workers > concurrent) workers = concurrent;
+	pthread_t * threads = elektraMalloc (sizeof (pthread_t) * workers);
+	size_t started = 0;
+	pthread_mutex_init (&work.mutex, 0);
+	// the calling thread is one of the workers
+	for (; started < workers - 1; ++started)
+	{
+		if (pthread_create (&threads[started], 0, elektraGetWorker, &work) != 0) break;
+	}
+	elektraGetWorker (&work);
+	for (size_t t = 0; t < started; ++t)
+	{
+		pthread_join (threads[t], 0);
+	}
+	pthread_mutex_destroy (&work.mutex);
+	elektraFree (threads);
+
+	int ret = 0;
+	for (size_t i = 0; i < work.size; i++)
+	{
+		if (!test_bit (split->syncbits[i], SPLIT_FLAG_SYNC)) continue;
+
+		if (!work.parentKeys[i])
+		{
+			if (elektraGetDoBackendUpdate (handle, split, i, parentKey, start, end) == -1)
+			{
+				ret = -1;
+				break;
+			}
+			continue;
+		}
+
+		keySetName (parentKey, keyName (split->parents[i]));
+		keySetString (parentKey, keyString (split->parents[i]));
+		elektraGetCopyWarnings (parentKey, work.parentKeys[i]);
+		if (work.results[i] == -1)
+		{
+			copyError (parentKey, work.parentKeys[i]);
+			ret = -1;
+			break;
+		}
+	}
+
+	for (size_t i = 0; i < work.size; i++)
+	{
+		keyDel (work.parentKeys[i]);
+	}
+	elektraFree (work.parentKeys);
+	elektraFree (work.results);
+	return ret;
+}
+#endif
+
 /**
  * @internal
  * @brief Do the real update.
  *
+ * @param handle the KDB instance, its getWorkers threads may be used, see elektraGetDoUpdateParallel()
+ * @param split the split to work with
+ * @param parentKey to add warnings and errors
+ *
  * @retval -1 on error
  * @retval 0 on success
  */
-static int elektraGetDoUpdate (Split * split, Key * parentKey)
+static int elektraGetDoUpdate (KDB * handle, Split * split, Key * parentKey)
 {
+#ifdef HAVE_PTHREAD_H
+	if (handle->getWorkers > 1)
+	{
+		int ret = elektraGetDoUpdateParallel (handle, split, parentKey, handle->getWorkers, 1, NR_OF_PLUGINS);
+		if (ret != 1) return ret;
+	}
+#endif
+
 	const int bypassedSplits = 1;
 	for (size_t i = 0; i < split->size - bypassedSplits; i++)
 	{
@@ -541,25 +974,10 @@ static int elektraGetDoUpdate (Split * split, Key * parentKey)
 			// skip it, update is not needed
 			continue;
 		}
-		Backend * backend = split->handles[i];
-		ksRewind (split->keysets[i]);
-		keySetName (parentKey, keyName (split->parents[i]));
-		keySetString (parentKey, keyString (split->parents[i]));
 
-		for (size_t p = 1; p < NR_OF_PLUGINS; ++p)
+		if (elektraGetDoBackendUpdate (handle, split, i, parentKey, 1, NR_OF_PLUGINS) == -1)
 		{
-			int ret = 0;
-			if (backend->getplugins[p] && backend->getplugins[p]->kdbGet)
-			{
-				ret = backend->getplugins[p]->kdbGet (backend->getplugins[p], split->keysets[i], parentKey);
-			}
-
-			if (ret == -1)
-			{
-				// Ohh, an error occurred,
-				// lets stop the process.
-				return -1;
-			}
+			return -1;
 		}
 	}
 	return 0;
@@ -615,6 +1033,26 @@ static int elektraGetDoUpdateWithGlobalHooks (KDB * handle, Split * split, KeySe
 
 	// elektraGlobalGet (handle, ks, parentKey, POSTGETSTORAGE, INIT);
 
+#ifdef HAVE_PTHREAD_H
+	// up to the storage no global plugin runs, so the backends are independent
+	if (run == FIRST && handle->getWorkers > 1)
+	{
+		int ret = elektraGetDoUpdateParallel (handle, split, parentKey, handle->getWorkers, 1, STORAGE_PLUGIN + 1);
+		if (ret == -1)
+		{
+			keySetName (parentKey, keyName (initialParent));
+			elektraGlobalError (handle, ks, parentKey, GETSTORAGE, DEINIT);
+			return -1;
+		}
+		if (ret == 0)
+		{
+			keySetName (parentKey, keyName (initialParent));
+			elektraGlobalGet (handle, ks, parentKey, GETSTORAGE, DEINIT);
+			return 0;
+		}
+	}
+#endif
+
 	for (size_t i = 0; i < split->size - bypassedSplits; i++)
 	{
 		Backend * backend = split->handles[i];
@@ -640,24 +1078,33 @@ static int elektraGetDoUpdateWithGlobalHooks (KDB * handle, Split * split, KeySe
 			{
 				keySetName (parentKey, keyName (initialParent));
 				ksRewind (ks);
+				uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 				handle->globalPlugins[PROCGETSTORAGE][FOREACH]->kdbGet (handle->globalPlugins[PROCGETSTORAGE][FOREACH], ks,
 											parentKey);
+				ELEKTRA_TRACE_END_GLOBAL (handle, traceStart, handle->globalPlugins[PROCGETSTORAGE][FOREACH], PROCGETSTORAGE,
+							  FOREACH, ks);
 				keySetName (parentKey, keyName (split->parents[i]));
 			}
 			if (p == (STORAGE_PLUGIN + 2) && handle->globalPlugins[POSTGETSTORAGE][FOREACH])
 			{
 				keySetName (parentKey, keyName (initialParent));
 				ksRewind (ks);
+				uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 				handle->globalPlugins[POSTGETSTORAGE][FOREACH]->kdbGet (handle->globalPlugins[POSTGETSTORAGE][FOREACH], ks,
 											parentKey);
+				ELEKTRA_TRACE_END_GLOBAL (handle, traceStart, handle->globalPlugins[POSTGETSTORAGE][FOREACH], POSTGETSTORAGE,
+							  FOREACH, ks);
 				keySetName (parentKey, keyName (split->parents[i]));
 			}
 			else if (p == (NR_OF_PLUGINS - 1) && handle->globalPlugins[POSTGETCLEANUP][FOREACH])
 			{
 				keySetName (parentKey, keyName (initialParent));
 				ksRewind (ks);
+				uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 				handle->globalPlugins[POSTGETCLEANUP][FOREACH]->kdbGet (handle->globalPlugins[POSTGETCLEANUP][FOREACH], ks,
 											parentKey);
+				ELEKTRA_TRACE_END_GLOBAL (handle, traceStart, handle->globalPlugins[POSTGETCLEANUP][FOREACH], POSTGETCLEANUP,
+							  FOREACH, ks);
 				keySetName (parentKey, keyName (split->parents[i]));
 			}
 
@@ -671,12 +1118,17 @@ static int elektraGetDoUpdateWithGlobalHooks (KDB * handle, Split * split, KeySe
 						continue;
 					}
 
+					ElektraTracePhase phase = p == STORAGE_PLUGIN ? ELEKTRA_TRACE_STORAGE : ELEKTRA_TRACE_PLUGIN;
+					uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 					ret = backend->getplugins[p]->kdbGet (backend->getplugins[p], split->keysets[i], parentKey);
+					ELEKTRA_TRACE_END (handle, traceStart, phase, backend->getplugins[p], backend, split->keysets[i]);
 				}
 				else
 				{
 					KeySet * cutKS = prepareGlobalKS (ks, parentKey);
+					uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 					ret = backend->getplugins[p]->kdbGet (backend->getplugins[p], cutKS, parentKey);
+					ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_PLUGIN, backend->getplugins[p], backend, cutKS);
 					ksAppend (ks, cutKS);
 					ksDel (cutKS);
 				}
@@ -711,7 +1163,7 @@ static int copyError (Key * dest, Key * src)
 	keySetMeta (dest, keyName (metaKey), keyString (metaKey));
 	while ((metaKey = keyNextMeta (src)) != NULL)
 	{
-		if (strncmp (keyName (metaKey), "error/", 6)) break;
+		if (strncmp (keyName (metaKey), "meta:/error/", sizeof ("meta:/error/") - 1)) break;
 		keySetMeta (dest, keyName (metaKey), keyString (metaKey));
 	}
 	return 1;
@@ -884,9 +1336,14 @@ static int elektraCacheLoadSplit (KDB * handle, Split * split, KeySet * ks, KeyS
 		ks->size = (*cache)->size;
 		ks->alloc = (*cache)->alloc;
 		ks->flags = (*cache)->flags;
+		ks->prefixes = (*cache)->prefixes;
+		ks->prefixAlloc = (*cache)->prefixAlloc;
+		ks->prefixSkip = (*cache)->prefixSkip;
 #ifdef ELEKTRA_ENABLE_OPTIMIZATIONS
 		ks->opmphm = (*cache)->opmphm;
 		ks->opmphmPredictor = (*cache)->opmphmPredictor;
+		// ks keeps its own (cleared) delta, the cached OPMPHM has no pending changes
+		if ((*cache)->opmphmDelta) elektraFree ((*cache)->opmphmDelta);
 #endif
 		elektraFree (*cache);
 		*cache = 0;
@@ -1007,6 +1464,8 @@ int kdbGet (KDB * handle, KeySet * ks, Key * parentKey)
 
 	int errnosave = errno;
 	Key * initialParent = keyDup (parentKey);
+	uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
+	uint64_t phaseStart;
 
 	ELEKTRA_LOG ("now in new kdbGet (%s)", keyName (parentKey));
 
@@ -1046,17 +1505,24 @@ int kdbGet (KDB * handle, KeySet * ks, Key * parentKey)
 	if (ns == KEY_NS_CASCADING) keySetMeta (cacheParent, "cascading", "");
 	if (handle->globalPlugins[PREGETCACHE][MAXONCE])
 	{
+		phaseStart = ELEKTRA_TRACE_BEGIN (handle);
 		elektraCacheLoad (handle, cache, parentKey, initialParent, cacheParent);
+		ELEKTRA_TRACE_END (handle, phaseStart, ELEKTRA_TRACE_CACHE, handle->globalPlugins[PREGETCACHE][MAXONCE], 0, cache);
 	}
 
 	// Check if a update is needed at all
-	switch (elektraGetCheckUpdateNeeded (split, parentKey))
+	phaseStart = ELEKTRA_TRACE_BEGIN (handle);
+	int updateNeeded = elektraGetCheckUpdateNeeded (handle, split, parentKey);
+	ELEKTRA_TRACE_END (handle, phaseStart, ELEKTRA_TRACE_RESOLVER, 0, 0, 0);
+	switch (updateNeeded)
 	{
 	case -2: // We have a cache hit
+		phaseStart = ELEKTRA_TRACE_BEGIN (handle);
 		if (elektraCacheLoadSplit (handle, split, ks, &cache, &cacheParent, parentKey, initialParent, debugGlobalPositions) != 0)
 		{
 			goto cachemiss;
 		}
+		ELEKTRA_TRACE_END (handle, phaseStart, ELEKTRA_TRACE_CACHE, 0, 0, ks);
 
 		keySetName (parentKey, keyName (initialParent));
 		splitUpdateFileName (split, handle, parentKey);
@@ -1064,6 +1530,7 @@ int kdbGet (KDB * handle, KeySet * ks, Key * parentKey)
 		splitDel (split);
 		errno = errnosave;
 		keyDel (oldError);
+		ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_GET, 0, 0, ks);
 		return 1;
 	case 0: // We don't need an update so let's do nothing
 
@@ -1126,6 +1593,7 @@ int kdbGet (KDB * handle, KeySet * ks, Key * parentKey)
 		splitDel (split);
 		errno = errnosave;
 		keyDel (oldError);
+		ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_GET, 0, 0, ks);
 		return 0;
 	case -1:
 		goto error;
@@ -1150,12 +1618,14 @@ cachemiss:
 	}
 
 	// Appoint keys (some in the bypass)
+	phaseStart = ELEKTRA_TRACE_BEGIN (handle);
 	if (splitAppoint (split, handle, ks) == -1)
 	{
 		clearError (parentKey);
 		ELEKTRA_SET_INTERNAL_ERROR (parentKey, "Error in splitAppoint");
 		goto error;
 	}
+	ELEKTRA_TRACE_END (handle, phaseStart, ELEKTRA_TRACE_SPLIT, 0, 0, ks);
 
 	if (handle->globalPlugins[POSTGETSTORAGE][FOREACH] || handle->globalPlugins[POSTGETCLEANUP][FOREACH] ||
 	    handle->globalPlugins[PROCGETSTORAGE][FOREACH] || handle->globalPlugins[PROCGETSTORAGE][INIT] ||
@@ -1173,6 +1643,7 @@ cachemiss:
 
 		keySetName (parentKey, keyName (initialParent));
 
+		phaseStart = ELEKTRA_TRACE_BEGIN (handle);
 		if (splitGet (split, parentKey, handle) == -1)
 		{
 			ELEKTRA_ADD_PLUGIN_MISBEHAVIOR_WARNINGF (parentKey, "Wrong keys in postprocessing: %s", keyName (ksCurrent (ks)));
@@ -1180,6 +1651,7 @@ cachemiss:
 		}
 		ksClear (ks);
 		splitMergeBackends (split, ks);
+		ELEKTRA_TRACE_END (handle, phaseStart, ELEKTRA_TRACE_SPLIT, 0, 0, ks);
 
 		clearError (parentKey);
 		if (elektraGetDoUpdateWithGlobalHooks (handle, split, ks, parentKey, initialParent, LAST) == -1)
@@ -1198,7 +1670,7 @@ cachemiss:
 		   but not for bypassed keys in split->size-1 */
 		clearError (parentKey);
 		// do everything up to position get_storage
-		if (elektraGetDoUpdate (split, parentKey) == -1)
+		if (elektraGetDoUpdate (handle, split, parentKey) == -1)
 		{
 			goto error;
 		}
@@ -1208,6 +1680,7 @@ cachemiss:
 		}
 
 		/* Now post-process the updated keysets */
+		phaseStart = ELEKTRA_TRACE_BEGIN (handle);
 		if (splitGet (split, parentKey, handle) == -1)
 		{
 			ELEKTRA_ADD_PLUGIN_MISBEHAVIOR_WARNINGF (parentKey, "Wrong keys in postprocessing: %s", keyName (ksCurrent (ks)));
@@ -1216,6 +1689,7 @@ cachemiss:
 
 		ksClear (ks);
 		splitMergeBackends (split, ks);
+		ELEKTRA_TRACE_END (handle, phaseStart, ELEKTRA_TRACE_SPLIT, 0, 0, ks);
 	}
 
 	keySetName (parentKey, keyName (initialParent));
@@ -1254,7 +1728,9 @@ cachemiss:
 	cacheParent = 0;
 
 	// the default split is not handled by POSTGETSTORAGE
+	phaseStart = ELEKTRA_TRACE_BEGIN (handle);
 	splitMergeDefault (split, ks);
+	ELEKTRA_TRACE_END (handle, phaseStart, ELEKTRA_TRACE_SPLIT, 0, 0, ks);
 
 	ksRewind (ks);
 
@@ -1265,6 +1741,7 @@ cachemiss:
 	keyDel (oldError);
 	splitDel (split);
 	errno = errnosave;
+	ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_GET, 0, 0, ks);
 	return 1;
 
 error:
@@ -1282,6 +1759,7 @@ error:
 	keyDel (oldError);
 	splitDel (split);
 	errno = errnosave;
+	ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_GET, 0, 0, ks);
 	return -1;
 }
 
@@ -1289,6 +1767,7 @@ error:
  * @internal
  * @brief Does all set steps but not commit
  *
+ * @param handle contains the global plugins and the tracing
  * @param split all information for iteration
  * @param parentKey to add warnings (also passed to plugins for the same reason)
  * @param [out] errorKey may point to which key caused the error or 0 otherwise
@@ -1296,8 +1775,9 @@ error:
  * @retval -1 on error
  * @retval 0 on success
  */
-static int elektraSetPrepare (Split * split, Key * parentKey, Key ** errorKey, Plugin * hooks[][NR_GLOBAL_SUBPOSITIONS])
+static int elektraSetPrepare (KDB * handle, Split * split, Key * parentKey, Key ** errorKey)
 {
+	Plugin *(*hooks)[NR_GLOBAL_SUBPOSITIONS] = handle->globalPlugins;
 	int any_error = 0;
 	for (size_t i = 0; i < split->size; i++)
 	{
@@ -1318,7 +1798,11 @@ static int elektraSetPrepare (Split * split, Key * parentKey, Key ** errorKey, P
 					keySetString (parentKey, "");
 				}
 				keySetName (parentKey, keyName (split->parents[i]));
+				ElektraTracePhase phase =
+					p == 0 ? ELEKTRA_TRACE_RESOLVER : p == STORAGE_PLUGIN ? ELEKTRA_TRACE_STORAGE : ELEKTRA_TRACE_PLUGIN;
+				uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 				ret = backend->setplugins[p]->kdbSet (backend->setplugins[p], split->keysets[i], parentKey);
+				ELEKTRA_TRACE_END (handle, traceStart, phase, backend->setplugins[p], backend, split->keysets[i]);
 
 #if VERBOSE && DEBUG
 				printf ("Prepare %s with keys %zd in plugin: %zu, split: %zu, ret: %d\n", keyName (parentKey),
@@ -1344,7 +1828,10 @@ static int elektraSetPrepare (Split * split, Key * parentKey, Key ** errorKey, P
 				if (hooks[PRESETSTORAGE][FOREACH])
 				{
 					ksRewind (split->keysets[i]);
+					uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 					hooks[PRESETSTORAGE][FOREACH]->kdbSet (hooks[PRESETSTORAGE][FOREACH], split->keysets[i], parentKey);
+					ELEKTRA_TRACE_END_GLOBAL (handle, traceStart, hooks[PRESETSTORAGE][FOREACH], PRESETSTORAGE, FOREACH,
+								  split->keysets[i]);
 				}
 			}
 			else if (p == (STORAGE_PLUGIN - 1))
@@ -1352,7 +1839,10 @@ static int elektraSetPrepare (Split * split, Key * parentKey, Key ** errorKey, P
 				if (hooks[PRESETCLEANUP][FOREACH])
 				{
 					ksRewind (split->keysets[i]);
+					uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 					hooks[PRESETCLEANUP][FOREACH]->kdbSet (hooks[PRESETCLEANUP][FOREACH], split->keysets[i], parentKey);
+					ELEKTRA_TRACE_END_GLOBAL (handle, traceStart, hooks[PRESETCLEANUP][FOREACH], PRESETCLEANUP, FOREACH,
+								  split->keysets[i]);
 				}
 			}
 
@@ -1379,10 +1869,11 @@ static int elektraSetPrepare (Split * split, Key * parentKey, Key ** errorKey, P
  * @internal
  * @brief Does the commit
  *
+ * @param handle contains the tracing
  * @param split all information for iteration
  * @param parentKey to add warnings (also passed to plugins for the same reason)
  */
-static void elektraSetCommit (Split * split, Key * parentKey)
+static void elektraSetCommit (KDB * handle, Split * split, Key * parentKey)
 {
 	for (size_t p = COMMIT_PLUGIN; p < NR_OF_PLUGINS; ++p)
 	{
@@ -1403,6 +1894,7 @@ static void elektraSetCommit (Split * split, Key * parentKey)
 					keyString (parentKey));
 #endif
 				ksRewind (split->keysets[i]);
+				uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 				if (p == COMMIT_PLUGIN)
 				{
 					ret = backend->setplugins[p]->kdbCommit (backend->setplugins[p], split->keysets[i], parentKey);
@@ -1413,6 +1905,8 @@ static void elektraSetCommit (Split * split, Key * parentKey)
 				{
 					ret = backend->setplugins[p]->kdbSet (backend->setplugins[p], split->keysets[i], parentKey);
 				}
+				ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_COMMIT, backend->setplugins[p], backend,
+						   split->keysets[i]);
 			}
 
 			if (ret == -1)
@@ -1428,10 +1922,11 @@ static void elektraSetCommit (Split * split, Key * parentKey)
  * @internal
  * @brief Does the rollback
  *
+ * @param handle contains the tracing
  * @param split all information for iteration
  * @param parentKey to add warnings (also passed to plugins for the same reason)
  */
-static void elektraSetRollback (Split * split, Key * parentKey)
+static void elektraSetRollback (KDB * handle, Split * split, Key * parentKey)
 {
 	for (size_t p = 0; p < NR_OF_PLUGINS; ++p)
 	{
@@ -1444,7 +1939,10 @@ static void elektraSetRollback (Split * split, Key * parentKey)
 			if (backend->errorplugins[p])
 			{
 				keySetName (parentKey, keyName (split->parents[i]));
+				uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 				ret = backend->errorplugins[p]->kdbError (backend->errorplugins[p], split->keysets[i], parentKey);
+				ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_ROLLBACK, backend->errorplugins[p], backend,
+						   split->keysets[i]);
 			}
 
 			if (ret == -1)
@@ -1589,6 +2087,7 @@ int kdbSet (KDB * handle, KeySet * ks, Key * parentKey)
 
 	int errnosave = errno;
 	Key * initialParent = keyDup (parentKey);
+	uint64_t traceStart = ELEKTRA_TRACE_BEGIN (handle);
 
 	ELEKTRA_LOG ("now in new kdbSet (%s) %p %zd", keyName (parentKey), (void *) handle, ksGetSize (ks));
 
@@ -1610,6 +2109,7 @@ int kdbSet (KDB * handle, KeySet * ks, Key * parentKey)
 	ELEKTRA_LOG ("after splitBuildup");
 
 	// 1.) Search for syncbits
+	uint64_t phaseStart = ELEKTRA_TRACE_BEGIN (handle);
 	int syncstate = splitDivide (split, handle, ks);
 	if (syncstate == -1)
 	{
@@ -1623,6 +2123,7 @@ int kdbSet (KDB * handle, KeySet * ks, Key * parentKey)
 
 	// 2.) Search for changed sizes
 	syncstate |= splitSync (split);
+	ELEKTRA_TRACE_END (handle, phaseStart, ELEKTRA_TRACE_SPLIT, 0, 0, ks);
 	ELEKTRA_ASSERT (syncstate <= 1, "syncstate not equal or below 1, but %d", syncstate);
 	if (syncstate != 1)
 	{
@@ -1646,6 +2147,7 @@ int kdbSet (KDB * handle, KeySet * ks, Key * parentKey)
 		splitDel (split);
 		errno = errnosave;
 		keyDel (oldError);
+		ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_SET, 0, 0, ks);
 		ELEKTRA_LOG ("return: %d", syncstate == 0 ? 0 : -1);
 		return syncstate == 0 ? 0 : -1;
 	}
@@ -1655,7 +2157,7 @@ int kdbSet (KDB * handle, KeySet * ks, Key * parentKey)
 	splitPrepare (split);
 
 	clearError (parentKey); // clear previous error to set new one
-	if (elektraSetPrepare (split, parentKey, &errorKey, handle->globalPlugins) == -1)
+	if (elektraSetPrepare (handle, split, parentKey, &errorKey) == -1)
 	{
 		goto error;
 	}
@@ -1670,7 +2172,7 @@ int kdbSet (KDB * handle, KeySet * ks, Key * parentKey)
 	elektraGlobalSet (handle, ks, parentKey, PRECOMMIT, MAXONCE);
 	elektraGlobalSet (handle, ks, parentKey, PRECOMMIT, DEINIT);
 
-	elektraSetCommit (split, parentKey);
+	elektraSetCommit (handle, split, parentKey);
 
 	elektraGlobalSet (handle, ks, parentKey, COMMIT, INIT);
 	elektraGlobalSet (handle, ks, parentKey, COMMIT, MAXONCE);
@@ -1696,6 +2198,7 @@ int kdbSet (KDB * handle, KeySet * ks, Key * parentKey)
 
 	keyDel (oldError);
 	errno = errnosave;
+	ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_SET, 0, 0, ks);
 	ELEKTRA_LOG ("before RETURN 1");
 	return 1;
 
@@ -1706,7 +2209,7 @@ error:
 	elektraGlobalError (handle, ks, parentKey, PREROLLBACK, MAXONCE);
 	elektraGlobalError (handle, ks, parentKey, PREROLLBACK, DEINIT);
 
-	elektraSetRollback (split, parentKey);
+	elektraSetRollback (handle, split, parentKey);
 
 	if (errorKey)
 	{
@@ -1729,6 +2232,7 @@ error:
 	splitDel (split);
 	errno = errnosave;
 	keyDel (oldError);
+	ELEKTRA_TRACE_END (handle, traceStart, ELEKTRA_TRACE_SET, 0, 0, ks);
 	return -1;
 }
 
@@ -2034,6 +2538,13 @@ static int ensurePluginState (KDB * handle ELEKTRA_UNUSED, const char * mountpoi
  *
  * If `<mountpoint>` is NOT `global`, currently only `unmounted` is supported (not `mounted` and `remounted`).
  *
+ * - `system:/elektra/ensure/get/workers` defines how many threads kdbGet() may use to read
+ *   backends. The value `0` or `1` (the default) reads all backends sequentially.
+ *   Only backends where all get plugins after the resolver declared themselves
+ *   thread-safe (see ELEKTRA_PLUGIN_THREADSAFE) are read concurrently. The resolvers
+ *   are always processed sequentially. If global plugins are mounted, only the plugins
+ *   up to the storage plugin are run concurrently.
+ *
  * NOTE: This function only works properly, if the list plugin is mounted in all global positions.
  * If this is not the case, 1 will be returned, because this is seen as an implicit clause in the contract.
  * Additionally any contract that specifies clauses for the list plugin is rejected as malformed.
@@ -2061,6 +2572,26 @@ int kdbEnsure (KDB * handle, KeySet * contract, Key * parentKey)
 		return -1;
 	}
 
+	Key * workers = ksLookupByName (contract, "system:/elektra/ensure/get/workers", 0);
+	if (workers)
+	{
+		int errnosave = errno;
+		const char * workersString = keyString (workers);
+		char * end;
+		errno = 0;
+		unsigned long long value = strtoull (workersString, &end, 10);
+		if (errno != 0 || !isdigit ((unsigned char) *workersString) || *end != '\0')
+		{
+			errno = errnosave;
+			ELEKTRA_SET_INTERFACE_ERRORF (parentKey, "The key '%s' contained the value '%s', but only a number may be used",
+						      keyName (workers), workersString);
+			ksDel (contract);
+			return -1;
+		}
+		errno = errnosave;
+		handle->getWorkers = value;
+	}
+
 	Key * cutpoint = keyNew ("system:/elektra/ensure/plugins", KEY_END);
 	KeySet * pluginsContract = ksCut (contract, cutpoint);
 
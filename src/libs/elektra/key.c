@@ -421,18 +421,13 @@ int keyCopy (Key * dest, const Key * source)
 		dest->data.v = 0;
 	}
 
-	if (source->meta)
-	{
-		dest->meta = ksDup (source->meta);
-		if (!dest->meta) goto memerror;
-	}
-	else
-	{
-		dest->meta = 0;
-	}
+	// the metadata is shared until one of the keys changes it
+	if (elektraMetaShare (dest, source) == -1) goto memerror;
 
 	// successful, now do the irreversible stuff: we obviously modified dest
 	set_bit (dest->flags, KEY_FLAG_SYNC);
+	clear_bit (dest->flags, (keyflag_t) (KEY_FLAG_OWNER | KEY_FLAG_META_PRIVATE));
+	dest->flags |= source->flags & KEY_FLAG_OWNER;
 
 	// copy sizes accordingly
 	dest->keySize = source->keySize;
@@ -443,16 +438,21 @@ int keyCopy (Key * dest, const Key * source)
 	if (!test_bit (dest->flags, KEY_FLAG_MMAP_KEY)) elektraFree (destKey);
 	if (!test_bit (dest->flags, KEY_FLAG_MMAP_KEY)) elektraFree (destUKey);
 	if (!test_bit (dest->flags, KEY_FLAG_MMAP_DATA)) elektraFree (destData);
-	ksDel (destMeta);
+	elektraMetaRelease (destMeta);
+
+	// the new name and value are not in a mapped region or arena
+	clear_bit (dest->flags, (keyflag_t) (KEY_FLAG_MMAP_KEY | KEY_FLAG_MMAP_DATA));
 
 	return 1;
 
 memerror:
-	elektraFree (dest->key);
-	elektraFree (dest->data.v);
-	ksDel (dest->meta);
+	// only free what was duplicated before the error
+	if (dest->key != destKey) elektraFree (dest->key);
+	if (dest->ukey != destUKey) elektraFree (dest->ukey);
+	if (dest->data.v != destData) elektraFree (dest->data.v);
 
 	dest->key = destKey;
+	dest->ukey = destUKey;
 	dest->data.v = destData;
 	dest->meta = destMeta;
 	return -1;
@@ -506,9 +506,13 @@ int keyDel (Key * key)
 
 	keyClearNameValue (key);
 
-	ksDel (key->meta);
+	elektraMetaRelease (key->meta);
 
-	if (!keyInMmap)
+	if (test_bit (key->flags, KEY_FLAG_ARENA))
+	{
+		elektraArenaKeyDel (key);
+	}
+	else if (!keyInMmap)
 	{
 		elektraFree (key);
 	}
@@ -556,14 +560,14 @@ int keyClear (Key * key)
 
 	ref = key->ksReference;
 
-	int keyStructInMmap = test_bit (key->flags, KEY_FLAG_MMAP_STRUCT);
+	int keyStructFlags = key->flags & (KEY_FLAG_MMAP_STRUCT | KEY_FLAG_ARENA);
 
 	keyClearNameValue (key);
 
-	ksDel (key->meta);
+	elektraMetaRelease (key->meta);
 
 	keyInit (key);
-	if (keyStructInMmap) key->flags |= KEY_FLAG_MMAP_STRUCT;
+	key->flags |= keyStructFlags;
 
 	keySetName (key, "/");
 
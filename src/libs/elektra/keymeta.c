@@ -124,6 +124,125 @@
 #endif
 
 
+/**
+ * @internal
+ *
+ * @brief Gives @p dest the metadata of @p source.
+ *
+ * The metadata keyset is shared with @p source, unless @p source
+ * keeps it private (see KEY_FLAG_META_PRIVATE). Then @p dest gets
+ * a copy, like keyDup() always did.
+ *
+ * @param dest the key without metadata keyset to write to
+ * @param source the key to take the metadata from
+ *
+ * @retval 0 on success
+ * @retval -1 on memory error, @p dest has no metadata then
+ */
+int elektraMetaShare (Key * dest, const Key * source)
+{
+	dest->meta = 0;
+	if (!source->meta) return 0;
+
+	if (test_bit (source->flags, KEY_FLAG_META_PRIVATE))
+	{
+		dest->meta = ksDup (source->meta);
+		return dest->meta ? 0 : -1;
+	}
+
+	__atomic_add_fetch (&source->meta->shared, 1, __ATOMIC_RELAXED);
+	dest->meta = source->meta;
+	return 0;
+}
+
+/**
+ * @internal
+ *
+ * @brief Drops one share of @p meta, if other keys share it.
+ *
+ * @param meta the metadata keyset
+ *
+ * @retval 1 if the share was dropped
+ * @retval 0 if no other key shares @p meta
+ */
+static int elektraMetaDropShare (KeySet * meta)
+{
+	size_t shared = __atomic_load_n (&meta->shared, __ATOMIC_ACQUIRE);
+	while (shared > 0)
+	{
+		if (__atomic_compare_exchange_n (&meta->shared, &shared, shared - 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * @internal
+ *
+ * @brief Gives @p key its own metadata keyset, if it shares it with other keys.
+ *
+ * The meta keys themselves stay shared, they are read-only.
+ * The cursor is kept. Must be called before the metadata keyset
+ * of a key is changed, including its cursor.
+ *
+ * @param key the key whose metadata will be changed
+ *
+ * @retval 0 on success
+ * @retval -1 on memory error
+ */
+int elektraMetaUnshare (Key * key)
+{
+	if (!key->meta || __atomic_load_n (&key->meta->shared, __ATOMIC_ACQUIRE) == 0) return 0;
+
+	KeySet * meta = ksDup (key->meta);
+	if (!meta) return -1;
+	meta->current = key->meta->current;
+	meta->cursor = key->meta->cursor;
+
+	if (!elektraMetaDropShare (key->meta))
+	{
+		// the other keys released it meanwhile
+		ksDel (meta);
+		return 0;
+	}
+	key->meta = meta;
+	return 0;
+}
+
+/**
+ * @internal
+ *
+ * @brief Releases the metadata keyset of a key.
+ *
+ * The keyset is deleted when no other key shares it.
+ *
+ * @param meta the metadata keyset or NULL
+ */
+void elektraMetaRelease (KeySet * meta)
+{
+	if (meta && elektraMetaDropShare (meta)) return;
+	ksDel (meta);
+}
+
+/**
+ * @internal
+ *
+ * @brief Keeps the metadata keyset of @p key private from now on.
+ *
+ * @param key the key whose metadata keyset is handed out or whose cursor is used
+ *
+ * @retval 0 on success
+ * @retval -1 on memory error
+ */
+static int elektraMetaMakePrivate (Key * key)
+{
+	if (elektraMetaUnshare (key) == -1) return -1;
+	set_bit (key->flags, KEY_FLAG_META_PRIVATE);
+	return 0;
+}
+
 /**Rewind the internal iterator to first metadata.
  *
  * Use it to set the cursor to the beginning of the Key Meta Infos.
@@ -154,6 +273,7 @@ int keyRewindMeta (Key * key)
 {
 	if (!key) return -1;
 	if (!key->meta) return 0;
+	if (elektraMetaMakePrivate (key) == -1) return -1;
 
 	return ksRewind (key->meta);
 }
@@ -188,6 +308,7 @@ const Key * keyNextMeta (Key * key)
 	Key * ret;
 	if (!key) return 0;
 	if (!key->meta) return 0;
+	if (elektraMetaMakePrivate (key) == -1) return 0;
 
 	ret = ksNext (key->meta);
 
@@ -282,6 +403,7 @@ int keyCopyMeta (Key * dest, const Key * source, const char * metaName)
 	if (!source) return -1;
 	if (!dest) return -1;
 	if (dest->flags & KEY_FLAG_RO_META) return -1;
+	if (elektraMetaUnshare (dest) == -1) return -1;
 
 	ret = (Key *) keyGetMeta (source, metaName);
 
@@ -324,6 +446,7 @@ int keyCopyMeta (Key * dest, const Key * source, const char * metaName)
 
 	// now we can simply append that key
 	ksAppendKey (dest->meta, ret);
+	dest->flags |= source->flags & KEY_FLAG_OWNER;
 
 	return 1;
 }
@@ -372,20 +495,143 @@ int keyCopyAllMeta (Key * dest, const Key * source)
 	if (ksGetSize (source->meta) > 0)
 	{
 		/*Make sure that dest also does not have metaName*/
-		if (dest->meta)
+		if (dest->meta && dest->meta != source->meta)
 		{
+			if (elektraMetaUnshare (dest) == -1) return -1;
 			ksAppend (dest->meta, source->meta);
 		}
-		else
+		else if (!dest->meta)
 		{
-			dest->meta = ksDup (source->meta);
+			// shared until one of the keys changes its metadata
+			if (elektraMetaShare (dest, source) == -1) return -1;
 		}
+		dest->flags |= source->flags & KEY_FLAG_OWNER;
 		return 1;
 	}
 
 	return 0;
 }
 
+/**
+ * @internal
+ *
+ * Size of the buffer for unescaped names in keyGetMeta(),
+ * longer names are looked up with a temporary key.
+ */
+#define ELEKTRA_META_NAME_BUFFER_SIZE 256
+
+/**
+ * @internal
+ *
+ * Builds the unescaped name of metadata without allocation.
+ *
+ * Only names without escape sequences, `%`, `#`, `.` and `..` parts
+ * and namespaces are handled. Like in keyAddName() leading, trailing and
+ * repeated slashes are ignored. All other names need the full
+ * canonicalization of keyNew().
+ *
+ * @param metaName the name of the metadata, without `meta:/`
+ * @param buffer   the buffer for the unescaped name
+ *
+ * @return the size of the unescaped name
+ * @retval 0 if the name needs the full canonicalization or is too long
+ */
+static size_t elektraMetaNameUnescape (const char * metaName, char * buffer)
+{
+	char * out = buffer;
+	char * const end = buffer + ELEKTRA_META_NAME_BUFFER_SIZE;
+	*out++ = KEY_NS_META;
+	*out++ = '\0';
+
+	const char * cur = metaName;
+	while (*cur != '\0')
+	{
+		if (*cur == '/')
+		{
+			++cur;
+			continue;
+		}
+
+		const char * part = cur;
+		while (*cur != '\0' && *cur != '/')
+		{
+			switch (*cur)
+			{
+			case '\\':
+			case '%':
+			case '#':
+			case ':':
+				return 0;
+			}
+			++cur;
+		}
+
+		size_t partSize = cur - part;
+		if (*part == '.' && (partSize == 1 || (partSize == 2 && part[1] == '.'))) return 0;
+		if (out + partSize + 1 >= end) return 0;
+
+		memcpy (out, part, partSize);
+		out += partSize;
+		*out++ = '\0';
+	}
+
+	if (out == buffer + 2)
+	{
+		// root key "meta:/"
+		*out++ = '\0';
+	}
+
+	return out - buffer;
+}
+
+/**
+ * @internal
+ *
+ * Binary search for metadata by its unescaped name.
+ * Like ksLookup() the cursor is set to the found metadata, unless
+ * the keyset is shared with other keys.
+ *
+ * @param meta  the metadata of a key
+ * @param uname the unescaped name
+ * @param usize the size of the unescaped name
+ *
+ * @return the found metadata or 0
+ */
+static Key * elektraMetaLookup (KeySet * meta, const char * uname, size_t usize)
+{
+	size_t left = 0;
+	size_t right = meta->size;
+
+	while (left < right)
+	{
+		size_t middle = left + (right - left) / 2;
+		const Key * cur = meta->array[middle];
+
+		size_t size = cur->keyUSize < usize ? cur->keyUSize : usize;
+		int cmp = memcmp (cur->ukey, uname, size);
+		if (cmp == 0 && cur->keyUSize == usize)
+		{
+			if (__atomic_load_n (&meta->shared, __ATOMIC_ACQUIRE) == 0)
+			{
+				meta->current = middle;
+				meta->cursor = meta->array[middle];
+			}
+			return meta->array[middle];
+		}
+
+		if (cmp < 0 || (cmp == 0 && cur->keyUSize < usize))
+		{
+			left = middle + 1;
+		}
+		else
+		{
+			right = middle;
+		}
+	}
+
+	return 0;
+}
+
 /** Returns the value of a meta-information given by name.
  *
  * You are not allowed to modify the resulting key.
@@ -421,7 +667,17 @@ const Key * keyGetMeta (const Key * key, const char * metaName)
 	if (!metaName) return 0;
 	if (!key->meta) return 0;
 
-	if (strncmp (metaName, "meta:/", sizeof ("meta:/") - 1) == 0)
+	int hasNamespace = strncmp (metaName, "meta:/", sizeof ("meta:/") - 1) == 0;
+
+	// common names are looked up without allocating a key
+	char uname[ELEKTRA_META_NAME_BUFFER_SIZE];
+	size_t usize = elektraMetaNameUnescape (hasNamespace ? metaName + sizeof ("meta:/") - 1 : metaName, uname);
+	if (usize > 0)
+	{
+		return elektraMetaLookup (key->meta, uname, usize);
+	}
+
+	if (hasNamespace)
 	{
 		search = keyNew (metaName, KEY_END);
 	}
@@ -431,7 +687,7 @@ const Key * keyGetMeta (const Key * key, const char * metaName)
 		keyAddName (search, metaName);
 	}
 
-	ret = ksLookup (key->meta, search, 0);
+	ret = elektraMetaLookup (key->meta, search->ukey, search->keyUSize);
 
 	keyDel (search);
 
@@ -481,6 +737,7 @@ ssize_t keySetMeta (Key * key, const char * metaName, const char * newMetaString
 
 	// optimization: we have nothing and want to remove something:
 	if (!key->meta && !newMetaString) return 0;
+	if (elektraMetaUnshare (key) == -1) return -1;
 
 	if (strncmp (metaName, "meta:/", sizeof ("meta:/") - 1) == 0)
 	{
@@ -546,6 +803,11 @@ ssize_t keySetMeta (Key * key, const char * metaName, const char * newMetaString
 	set_bit (toSet->flags, KEY_FLAG_RO_VALUE);
 	set_bit (toSet->flags, KEY_FLAG_RO_META);
 
+	if (toSet->keyUSize == sizeof ("\0\0owner") && memcmp (toSet->ukey + 2, "owner", sizeof ("owner")) == 0)
+	{
+		set_bit (key->flags, KEY_FLAG_OWNER);
+	}
+
 	ksAppendKey (key->meta, toSet);
 	key->flags |= KEY_FLAG_SYNC;
 	return metaStringSize;
@@ -578,7 +840,11 @@ ssize_t keySetMeta (Key * key, const char * metaName, const char * newMetaString
 KeySet * keyMeta (Key * key)
 {
 	if (!key) return 0;
+	// the returned keyset must not change the metadata of copies made later
+	if (elektraMetaMakePrivate (key) == -1) return 0;
 	if (!key->meta) key->meta = ksNew (0, KS_END);
 
+	// the owner might be changed through the returned keyset
+	set_bit (key->flags, KEY_FLAG_OWNER);
 	return key->meta;
 }
@@ -165,6 +165,10 @@
 #include "kdbhelper.h"
 #include "kdbinternal.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 /**
  * Helper method: returns a pointer to the start of the last part of the given key name
  *
@@ -206,6 +210,187 @@ static char * findStartOfLastPart (char * name, size_t len)
 	return cur < start - 1 ? NULL : cur;
 }
 
+/**
+ * Helper method: checks whether a part needs canonicalization or special unescaping
+ *
+ * These are empty parts, `%` parts, `.` and `..` parts and array parts with more than one digit.
+ * Parts like `#10abc`, that only look like array parts, are reported, too.
+ *
+ * @param part the start of the part
+ * @param end the end of the key name
+ *
+ * @retval true if the part is special
+ * @retval false otherwise
+ */
+static bool isSpecialPart (const char * part, const char * end)
+{
+	switch (*part)
+	{
+	case '/':
+		return true;
+	case '%':
+		return part + 1 == end || *(part + 1) == '/';
+	case '.':
+		if (part + 1 == end || *(part + 1) == '/') return true;
+		return *(part + 1) == '.' && (part + 2 == end || *(part + 2) == '/');
+	case '#':
+		return part + 2 < end && isdigit (*(part + 1)) && isdigit (*(part + 2));
+	default:
+		return false;
+	}
+}
+
+/**
+ * Helper method: unescapes the parts of a simple key name and checks that it is simple
+ *
+ * A simple key name has no escape sequences, does not end with a slash and none of
+ * its parts is special according to isSpecialPart(). Its canonical form is the name
+ * itself and its unescaped form only replaces the slashes by zero bytes.
+ *
+ * Both the check and the unescaping are done in a single pass. With SSE2, 16 bytes
+ * are handled at once.
+ *
+ * @param parts the parts of a valid key name, without the slash before the first part
+ * @param len the length of @p parts
+ * @param unescapedParts output buffer with at least @p len + 1 bytes
+ *
+ * @retval true if @p parts is simple, then @p unescapedParts holds the unescaped parts
+ * @retval false otherwise, then the content of @p unescapedParts is undefined
+ */
+static bool unescapeSimpleParts (const char * parts, size_t len, char * unescapedParts)
+{
+	const char * end = parts + len;
+	// the first part starts after a slash, too
+	unsigned int afterSlash = 1;
+	size_t i = 0;
+
+#ifdef __SSE2__
+	const __m128i slash = _mm_set1_epi8 ('/');
+	const __m128i backslash = _mm_set1_epi8 ('\\');
+	const __m128i dot = _mm_set1_epi8 ('.');
+	const __m128i percent = _mm_set1_epi8 ('%');
+	const __m128i hash = _mm_set1_epi8 ('#');
+
+	for (; i + sizeof (__m128i) <= len; i += sizeof (__m128i))
+	{
+		const __m128i chunk = _mm_loadu_si128 ((const __m128i *) (parts + i));
+		const __m128i slashes = _mm_cmpeq_epi8 (chunk, slash);
+		const __m128i special = _mm_or_si128 (_mm_or_si128 (slashes, _mm_cmpeq_epi8 (chunk, dot)),
+						      _mm_or_si128 (_mm_cmpeq_epi8 (chunk, percent), _mm_cmpeq_epi8 (chunk, hash)));
+
+		if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (chunk, backslash)) != 0) return false;
+
+		const unsigned int slashMask = (unsigned int) _mm_movemask_epi8 (slashes);
+		unsigned int candidates = (unsigned int) _mm_movemask_epi8 (special) & (((slashMask << 1) | afterSlash) & 0xFFFF);
+		while (candidates != 0)
+		{
+			// parts starting with one of the characters are rare, check them one by one
+			size_t pos = 0;
+			while (!(candidates & (1u << pos)))
+			{
+				++pos;
+			}
+			if (isSpecialPart (parts + i + pos, end)) return false;
+			candidates &= candidates - 1;
+		}
+
+		_mm_storeu_si128 ((__m128i *) (unescapedParts + i), _mm_andnot_si128 (slashes, chunk));
+		afterSlash = slashMask >> 15;
+	}
+#endif
+
+	for (; i < len; ++i)
+	{
+		const char c = parts[i];
+		if (c == '\\' || (afterSlash && isSpecialPart (parts + i, end)))
+		{
+			return false;
+		}
+		afterSlash = c == '/';
+		unescapedParts[i] = afterSlash ? '\0' : c;
+	}
+
+	unescapedParts[len] = '\0';
+	return !afterSlash;
+}
+
+/**
+ * Helper method: fast path of keySetName() for simple key names
+ *
+ * @param key the key, its name may be changed even if false is returned
+ * @param newName a valid key name
+ *
+ * @retval true if @p newName was simple and is now the name of @p key
+ * @retval false otherwise, elektraKeyNameCanonicalize() and elektraKeyNameUnescape() have to set the name
+ *
+ * @see unescapeSimpleParts() for simple key names
+ */
+static bool setSimpleName (Key * key, const char * newName)
+{
+	const size_t nameLen = strlen (newName);
+	const char * parts = newName;
+	elektraNamespace ns = KEY_NS_CASCADING;
+	if (*newName != '/')
+	{
+		const char * colon = strchr (newName, ':');
+		ns = elektraReadNamespace (newName, colon - newName);
+		parts = colon + 1;
+	}
+	// skip root slash
+	++parts;
+
+	const size_t partsLen = nameLen - (parts - newName);
+	const size_t usize = 2 + partsLen + 1;
+	if (partsLen == 0 || elektraRealloc ((void **) &key->ukey, usize) == -1 ||
+	    !unescapeSimpleParts (parts, partsLen, key->ukey + 2))
+	{
+		return false;
+	}
+
+	if (elektraRealloc ((void **) &key->key, nameLen + 1) == -1) return false;
+
+	memcpy (key->key, newName, nameLen + 1);
+	key->ukey[0] = ns;
+	key->ukey[1] = '\0';
+	key->keySize = nameLen + 1;
+	key->keyUSize = usize;
+	return true;
+}
+
+/**
+ * Helper method: fast path of keyAddName() for simple key names
+ *
+ * @param key the key, its name may be changed even if false is returned
+ * @param newName a valid key name suffix without leading slashes
+ *
+ * @retval true if @p newName was simple and has been added to the name of @p key
+ * @retval false otherwise, elektraKeyNameCanonicalize() and elektraKeyNameUnescape() have to add the name
+ *
+ * @see unescapeSimpleParts() for simple key names
+ */
+static bool addSimpleName (Key * key, const char * newName)
+{
+	// the root key has no part, which has to be separated
+	const bool isRoot = key->keyUSize == 3;
+	const size_t nameLen = strlen (newName);
+	const size_t uoffset = isRoot ? 2 : key->keyUSize;
+	const size_t offset = isRoot ? key->keySize - 1 : key->keySize;
+
+	if (elektraRealloc ((void **) &key->ukey, uoffset + nameLen + 1) == -1 ||
+	    !unescapeSimpleParts (newName, nameLen, key->ukey + uoffset))
+	{
+		return false;
+	}
+
+	if (elektraRealloc ((void **) &key->key, offset + nameLen + 1) == -1) return false;
+
+	if (!isRoot) key->key[offset - 1] = '/';
+	memcpy (key->key + offset, newName, nameLen + 1);
+	key->keySize = offset + nameLen + 1;
+	key->keyUSize = uoffset + nameLen + 1;
+	return true;
+}
+
 
 /*******************************************
  *    General name manipulation methods    *
@@ -473,11 +658,14 @@ ssize_t keySetName (Key * key, const char * newName)
 		clear_bit (key->flags, (keyflag_t) KEY_FLAG_MMAP_KEY);
 	}
 
-	elektraKeyNameCanonicalize (newName, &key->key, &key->keySize, 0, &key->keyUSize);
+	if (!setSimpleName (key, newName))
+	{
+		elektraKeyNameCanonicalize (newName, &key->key, &key->keySize, 0, &key->keyUSize);
 
-	elektraRealloc ((void **) &key->ukey, key->keyUSize);
+		elektraRealloc ((void **) &key->ukey, key->keyUSize);
 
-	elektraKeyNameUnescape (key->key, key->ukey);
+		elektraKeyNameUnescape (key->key, key->ukey);
+	}
 
 	set_bit (key->flags, KEY_FLAG_SYNC);
 
@@ -558,11 +746,14 @@ ssize_t keyAddName (Key * key, const char * newName)
 		clear_bit (key->flags, (keyflag_t) KEY_FLAG_MMAP_KEY);
 	}
 
-	elektraKeyNameCanonicalize (newName, &key->key, &key->keySize, key->keySize, &key->keyUSize);
+	if (!addSimpleName (key, newName))
+	{
+		elektraKeyNameCanonicalize (newName, &key->key, &key->keySize, key->keySize, &key->keyUSize);
 
-	elektraRealloc ((void **) &key->ukey, key->keyUSize);
+		elektraRealloc ((void **) &key->ukey, key->keyUSize);
 
-	elektraKeyNameUnescape (key->key, key->ukey);
+		elektraKeyNameUnescape (key->key, key->ukey);
+	}
 
 	set_bit (key->flags, KEY_FLAG_SYNC);
 	return key->keySize;
@@ -1604,6 +1795,14 @@ ssize_t keySetNamespace (Key * key, elektraNamespace ns)
 
 	size_t newNamespaceLen = strlen (newNamespace);
 
+	if (test_bit (key->flags, KEY_FLAG_MMAP_KEY))
+	{
+		// key was in mmap region, move it out to allow realloc
+		key->key = elektraStrNDup (key->key, key->keySize);
+		key->ukey = elektraStrNDup (key->ukey, key->keyUSize);
+		clear_bit (key->flags, (keyflag_t) KEY_FLAG_MMAP_KEY);
+	}
+
 	if (newNamespaceLen > oldNamespaceLen)
 	{
 		// buffer growing -> realloc first
@@ -38,22 +38,255 @@
 #define ELEKTRA_MAX_PREFIX_SIZE sizeof ("namespace/")
 #define ELEKTRA_MAX_NAMESPACE_SIZE sizeof ("system")
 
+/**
+ * @internal
+ *
+ * @brief The name prefix of a Key, as stored in KeySet.prefixes.
+ *
+ * Consists of the eight bytes of the unescaped name after the first @p skip bytes,
+ * in big-endian order and padded with zeros. If the prefix of one Key is smaller than
+ * the prefix of another Key, keyCompareByName() sorts it first, too. Keys with equal
+ * prefixes have to be compared with keyCompareByName().
+ *
+ * @pre the unescaped name of @p key is at least @p skip bytes long
+ *
+ * @param key the Key
+ * @param skip the number of bytes to skip
+ *
+ * @return the name prefix
+ */
+static inline uint64_t elektraKsPrefix (const Key * key, size_t skip)
+{
+	const unsigned char * name = (const unsigned char *) key->ukey + skip;
+	size_t size = key->keyUSize - skip;
+	uint64_t prefix = 0;
+	for (size_t i = 0; i < sizeof (uint64_t); ++i)
+	{
+		prefix = (prefix << 8) | (i < size ? name[i] : 0);
+	}
+	return prefix;
+}
+
+/**
+ * @internal
+ *
+ * @brief Drops the name prefixes of a KeySet.
+ *
+ * They are built again with the next lookup.
+ *
+ * @param ks the KeySet
+ */
+static void elektraKsPrefixesClear (KeySet * ks)
+{
+	elektraFree (ks->prefixes);
+	ks->prefixes = NULL;
+	ks->prefixAlloc = 0;
+	ks->prefixSkip = 0;
+}
+
+/**
+ * @internal
+ *
+ * @brief Builds the name prefixes of a KeySet.
+ *
+ * The bytes, which all names of @p ks have in common, are skipped.
+ * Because the keys are sorted, these are the bytes the first and the last key have in common.
+ *
+ * @param ks the KeySet
+ *
+ * @retval 0 on success
+ * @retval -1 if @p ks has less than KEYSET_PREFIX_MINSIZE keys or on memory error
+ */
+static int elektraKsPrefixesBuild (KeySet * ks)
+{
+	if (ks->size < KEYSET_PREFIX_MINSIZE) return -1;
+
+	const Key * first = ks->array[0];
+	const Key * last = ks->array[ks->size - 1];
+	size_t maxSkip = first->keyUSize < last->keyUSize ? first->keyUSize : last->keyUSize;
+	size_t skip = 0;
+	while (skip < maxSkip && first->ukey[skip] == last->ukey[skip])
+	{
+		++skip;
+	}
+
+	ks->prefixes = elektraMalloc (sizeof (uint64_t) * ks->alloc);
+	if (!ks->prefixes) return -1;
+	ks->prefixAlloc = ks->alloc;
+	ks->prefixSkip = skip;
+
+	for (size_t i = 0; i < ks->size; ++i)
+	{
+		ks->prefixes[i] = elektraKsPrefix (ks->array[i], skip);
+	}
+	return 0;
+}
+
+/**
+ * @internal
+ *
+ * @brief Updates the name prefixes after a single insertion or removal.
+ *
+ * Drops the prefixes, if an inserted Key does not start with the skipped bytes
+ * or if @p ks got less than KEYSET_PREFIX_MINSIZE keys.
+ *
+ * Must be invoked after the Key was inserted at or removed from @p position.
+ *
+ * @param ks the KeySet
+ * @param position the position of the inserted or removed Key
+ * @param insert 1 for insertions, 0 for removals
+ */
+static void elektraKsPrefixesRecord (KeySet * ks, size_t position, int insert)
+{
+	if (!ks->prefixes) return;
+
+	if (ks->size < KEYSET_PREFIX_MINSIZE)
+	{
+		elektraKsPrefixesClear (ks);
+		return;
+	}
+
+	if (!insert)
+	{
+		memmove (ks->prefixes + position, ks->prefixes + position + 1, (ks->size - position) * sizeof (uint64_t));
+		return;
+	}
+
+	const Key * key = ks->array[position];
+	const Key * other = ks->array[position == 0 ? 1 : 0];
+	if (key->keyUSize < ks->prefixSkip || memcmp (key->ukey, other->ukey, ks->prefixSkip) != 0)
+	{
+		elektraKsPrefixesClear (ks);
+		return;
+	}
+
+	if (ks->size > ks->prefixAlloc)
+	{
+		if (elektraRealloc ((void **) &ks->prefixes, sizeof (uint64_t) * ks->alloc) == -1)
+		{
+			elektraKsPrefixesClear (ks);
+			return;
+		}
+		ks->prefixAlloc = ks->alloc;
+	}
+
+	memmove (ks->prefixes + position + 1, ks->prefixes + position, (ks->size - position - 1) * sizeof (uint64_t));
+	ks->prefixes[position] = elektraKsPrefix (key, ks->prefixSkip);
+}
+
+/**
+ * @internal
+ *
+ * @brief Narrows a binary search for a Key with the name prefixes.
+ *
+ * Only the keys in the range from @p start to @p end have the same prefix as @p key,
+ * so only these need to be compared with keyCompareByName(). If there are none,
+ * @p start is the position, where @p key would be inserted.
+ *
+ * @pre the prefixes of @p ks are built and @p ks is not empty
+ *
+ * @param ks the KeySet
+ * @param key the Key to search
+ * @param start set to the first position with the prefix of @p key
+ * @param end set to the position after the last position with the prefix of @p key
+ *
+ * @retval 0 on success
+ * @retval -1 if @p key does not start with the skipped bytes, @p start and @p end are not changed
+ */
+static int elektraKsPrefixesSearch (const KeySet * ks, const Key * key, size_t * start, size_t * end)
+{
+	size_t skip = ks->prefixSkip;
+	if (key->keyUSize < skip || memcmp (key->ukey, ks->array[0]->ukey, skip) != 0) return -1;
+
+	const uint64_t prefix = elektraKsPrefix (key, skip);
+
+	// branchless lower and upper bound, the compiler uses conditional moves
+	const uint64_t * lower = ks->prefixes;
+	const uint64_t * upper = ks->prefixes;
+	size_t n = ks->size;
+	while (n > 1)
+	{
+		size_t half = n / 2;
+		lower = lower[half] < prefix ? lower + half : lower;
+		upper = upper[half] <= prefix ? upper + half : upper;
+		n -= half;
+	}
+	*start = (size_t) (lower - ks->prefixes) + (*lower < prefix);
+	*end = (size_t) (upper - ks->prefixes) + (*upper <= prefix);
+	return 0;
+}
+
 /**
  * @internal
  *
  * @brief KeySets OPMPHM cleaner.
  *
+ * Resets the OPMPHM without touching the name prefixes.
+ *
+ * @param ks the KeySet
+ */
+static void elektraOpmphmClear (KeySet * ks ELEKTRA_UNUSED)
+{
+#ifdef ELEKTRA_ENABLE_OPTIMIZATIONS
+	set_bit (ks->flags, KS_FLAG_NAME_CHANGE);
+	if (ks && ks->opmphm) opmphmClear (ks->opmphm);
+	if (ks && ks->opmphmDelta) opmphmDeltaClear (ks->opmphmDelta);
+#endif
+}
+
+/**
+ * @internal
+ *
+ * @brief KeySets OPMPHM and name prefix cleaner.
+ *
  * Must be invoked by every function that changes a Key name in a KeySet, adds a Key or
  * removes a Key.
  * Set also the KS_FLAG_NAME_CHANGE KeySet flag.
  *
  * @param ks the KeySet
  */
-static void elektraOpmphmInvalidate (KeySet * ks ELEKTRA_UNUSED)
+static void elektraOpmphmInvalidate (KeySet * ks)
+{
+	elektraKsPrefixesClear (ks);
+	elektraOpmphmClear (ks);
+}
+
+/**
+ * @internal
+ *
+ * @brief Records a single insertion or removal in the OPMPHM delta.
+ *
+ * Keeps a build OPMPHM usable after small changes, see OpmphmDelta.
+ * Falls back to elektraOpmphmClear() if the OPMPHM is not build
+ * or too many changes were recorded since it was build.
+ * The name prefixes are updated, see elektraKsPrefixesRecord().
+ *
+ * Must be invoked after the Key was inserted at or removed from @p position.
+ *
+ * @param ks the KeySet
+ * @param position the position of the inserted or removed Key
+ * @param insert 1 for insertions, 0 for removals
+ */
+static void elektraOpmphmRecord (KeySet * ks, size_t position, int insert)
 {
+	elektraKsPrefixesRecord (ks, position, insert);
 #ifdef ELEKTRA_ENABLE_OPTIMIZATIONS
-	set_bit (ks->flags, KS_FLAG_NAME_CHANGE);
-	if (ks && ks->opmphm) opmphmClear (ks->opmphm);
+	if (!opmphmIsBuild (ks->opmphm))
+	{
+		elektraOpmphmClear (ks);
+		return;
+	}
+	if (!ks->opmphmDelta)
+	{
+		ks->opmphmDelta = opmphmDeltaNew ();
+	}
+	if (!ks->opmphmDelta || opmphmDeltaAdd (ks->opmphmDelta, position, insert) != 0)
+	{
+		// fold the changes in with the next build
+		elektraOpmphmClear (ks);
+	}
+#else
+	elektraOpmphmClear (ks);
 #endif
 }
 
@@ -100,6 +333,26 @@ static void elektraOpmphmCopy (KeySet * dest ELEKTRA_UNUSED, const KeySet * sour
 	{
 		opmphmCopy (dest->opmphm, source->opmphm);
 	}
+	// OPMPHM delta
+	if (dest->opmphmDelta)
+	{
+		opmphmDeltaClear (dest->opmphmDelta);
+	}
+	if (source->opmphmDelta && source->opmphmDelta->size)
+	{
+		if (!dest->opmphmDelta)
+		{
+			dest->opmphmDelta = opmphmDeltaNew ();
+		}
+		if (dest->opmphmDelta)
+		{
+			memcpy (dest->opmphmDelta, source->opmphmDelta, sizeof (OpmphmDelta));
+		}
+		else if (dest->opmphm)
+		{
+			opmphmClear (dest->opmphm);
+		}
+	}
 #endif
 }
 
@@ -327,6 +580,12 @@ KeySet * ksDup (const KeySet * source)
  * This means that you have to keyDel() the contained keys and
  * ksDel() the returned keyset..
  *
+ * The duplicated keys are allocated in the arena of the returned
+ * keyset, see ksNewArena(). Their names and values are copied into
+ * a single block, their metadata is shared like with keyDup().
+ * The block is freed after the keyset and all duplicated keys were
+ * deleted, which may happen in different threads.
+ *
  * the sync status will be as in the original KeySet
  *
  * @param source has to be an initialized source KeySet
@@ -344,21 +603,27 @@ KeySet * ksDeepDup (const KeySet * source)
 	size_t i = 0;
 	KeySet * keyset = 0;
 
-	keyset = ksNew (source->alloc, KS_END);
+	// all duplicates fit into the first block of the arena
+	keyset = ksNewArena (source->alloc > s ? source->alloc : s + 1, elektraArenaDupSize (source));
+	if (!keyset) return 0;
+
 	for (i = 0; i < s; ++i)
 	{
-		Key * k = source->array[i];
-		Key * d = keyDup (k);
-		if (!test_bit (k->flags, KEY_FLAG_SYNC))
-		{
-			keyClearSync (d);
-		}
-		if (ksAppendKey (keyset, d) == -1)
+		Key * d = elektraArenaKeyDup (keyset, source->array[i]);
+		if (!d)
 		{
+			keyset->array[i] = 0;
+			keyset->size = i;
 			ksDel (keyset);
 			return 0;
 		}
+		// source is sorted, so the duplicates can be put in place directly
+		keyLock (d, KEY_LOCK_NAME);
+		keyIncRef (d);
+		keyset->array[i] = d;
 	}
+	keyset->array[s] = 0;
+	keyset->size = s;
 
 	elektraOpmphmCopy (keyset, source);
 	return keyset;
@@ -447,6 +712,10 @@ int ksDel (KeySet * ks)
 	{
 		opmphmDel (ks->opmphm);
 	}
+	if (ks->opmphmDelta)
+	{
+		opmphmDeltaDel (ks->opmphmDelta);
+	}
 	if (ks->opmphmPredictor)
 	{
 		opmphmPredictorDel (ks->opmphmPredictor);
@@ -454,6 +723,12 @@ int ksDel (KeySet * ks)
 
 #endif
 
+	// the arena stays until its last Key is deleted
+	if (ks->arena)
+	{
+		elektraArenaDecRef (ks->arena);
+	}
+
 	if (!test_bit (ks->flags, KS_FLAG_MMAP_STRUCT))
 	{
 		elektraFree (ks);
@@ -527,8 +802,9 @@ static int keyCompareByOwner (const void * p1, const void * p2)
 {
 	Key * key1 = *(Key **) p1;
 	Key * key2 = *(Key **) p2;
-	const char * owner1 = keyValue (keyGetMeta (key1, "owner"));
-	const char * owner2 = keyValue (keyGetMeta (key2, "owner"));
+	// only keys with KEY_FLAG_OWNER can have an owner
+	const char * owner1 = test_bit (key1->flags, KEY_FLAG_OWNER) ? keyValue (keyGetMeta (key1, "owner")) : NULL;
+	const char * owner2 = test_bit (key2->flags, KEY_FLAG_OWNER) ? keyValue (keyGetMeta (key2, "owner")) : NULL;
 	if (!owner1 && !owner2) return 0;
 	if (!owner1) return -1;
 	if (!owner2) return 1;
@@ -720,6 +996,13 @@ ssize_t ksSearchInternal (const KeySet * ks, const Key * toAppend)
 	}
 	cmpresult = 1;
 
+	size_t start, end;
+	if (ks->prefixes && elektraKsPrefixesSearch (ks, toAppend, &start, &end) == 0)
+	{
+		insertpos = left = start;
+		right = (ssize_t) end - 1;
+	}
+
 	while (1)
 	{
 		if (right < left)
@@ -882,9 +1165,106 @@ ssize_t ksAppendKey (KeySet * ks, Key * toAppend)
 			ks->array[insertpos] = toAppend;
 			ksSetCursor (ks, insertpos);
 		}
+		elektraOpmphmRecord (ks, insertpos, 1);
+	}
+
+	return ks->size;
+}
+
+
+/**
+ * @internal
+ *
+ * @brief Merges the keys of @p append into @p ks in linear time.
+ *
+ * Both arrays are sorted by keyCompareByNameOwner(), so they are merged
+ * from the back into the free space at the end of @p ks. Keys of @p ks
+ * that are greater than every key of @p append are never touched, and if
+ * all keys of @p append belong at the end, they are copied as one block.
+ * Keys that exist in both keysets are replaced by the keys of @p append,
+ * like ksAppendKey() would do. The cursor is set to the last key of @p append.
+ *
+ * @pre @p ks has room for at least ks->size + appendSize + 1 keys
+ * @pre @p append is not part of the array of @p ks
+ *
+ * @param ks the keyset to merge into
+ * @param append the sorted keys to merge
+ * @param appendSize the number of keys in @p append
+ * @return the size of @p ks after merging
+ */
+static ssize_t ksMergeInternal (KeySet * ks, Key * const * append, size_t appendSize)
+{
+	Key ** array = ks->array;
+	ssize_t i = ks->size - 1;
+	ssize_t j = appendSize - 1;
+	ssize_t k = ks->size + appendSize - 1;
+	ssize_t cursor = -1;
+	size_t duplicates = 0;
+	size_t inserted = 0;
+
+	if (appendSize > 0 && (i < 0 || keyCompareByNameOwner (&append[0], &array[i]) > 0))
+	{
+		/* all keys belong behind the last key of ks */
+		for (size_t n = 0; n < appendSize; ++n)
+		{
+			keyLock (append[n], KEY_LOCK_NAME);
+			keyIncRef (append[n]);
+		}
+		memcpy (array + ks->size, append, appendSize * sizeof (Key *));
+		ks->size += appendSize;
+		array[ks->size] = 0;
+		ksSetCursor (ks, ks->size - 1);
 		elektraOpmphmInvalidate (ks);
+		return ks->size;
+	}
+
+	while (j >= 0)
+	{
+		int cmp = i >= 0 ? keyCompareByNameOwner (&append[j], &array[i]) : 1;
+		if (cmp < 0)
+		{
+			array[k--] = array[i--];
+			continue;
+		}
+
+		if (cmp == 0)
+		{
+			++duplicates;
+			if (array[i] != append[j])
+			{
+				/* Pop the key of ks and use the other one instead */
+				keyDecRef (array[i]);
+				keyDel (array[i]);
+				keyIncRef (append[j]);
+			}
+			--i;
+		}
+		else
+		{
+			keyLock (append[j], KEY_LOCK_NAME);
+			keyIncRef (append[j]);
+			++inserted;
+		}
+
+		if (cursor == -1) cursor = k;
+		array[k--] = append[j--];
+	}
+
+	/* keys of ks before position i are already in place,
+	   so only close the gap left by duplicates */
+	if (duplicates > 0)
+	{
+		size_t from = i + 1 + duplicates;
+		elektraMemmove (array + i + 1, array + from, ks->size + appendSize - from);
+		cursor -= duplicates;
 	}
 
+	ks->size = ks->size + appendSize - duplicates;
+	array[ks->size] = 0;
+	ksSetCursor (ks, cursor);
+
+	if (inserted > 0) elektraOpmphmInvalidate (ks);
+
 	return ks->size;
 }
 
@@ -917,6 +1297,7 @@ ssize_t ksAppend (KeySet * ks, const KeySet * toAppend)
 
 	if (toAppend->size == 0) return ks->size;
 	if (toAppend->array == NULL) return ks->size;
+	if (ks == toAppend) return ks->size;
 
 	if (ks->array == NULL)
 		toAlloc = KEYSET_SIZE;
@@ -926,14 +1307,40 @@ ssize_t ksAppend (KeySet * ks, const KeySet * toAppend)
 	/* Do only one resize in advance */
 	for (; ks->size + toAppend->size >= toAlloc; toAlloc *= 2)
 		;
-	ksResize (ks, toAlloc - 1);
+	if (ksResize (ks, toAlloc - 1) == -1) return -1;
 
-	/* TODO: here is lots of room for optimizations */
-	for (size_t i = 0; i < toAppend->size; ++i)
-	{
-		ksAppendKey (ks, toAppend->array[i]);
-	}
-	return ks->size;
+	return ksMergeInternal (ks, toAppend->array, toAppend->size);
+}
+
+/**
+ * @internal
+ *
+ * Appends the keys of @p source from position @p start to @p end (exclusive) to @p ks.
+ *
+ * Works like ksAppend() with a part of @p source. If the keys sort after all keys of
+ * @p ks, e.g. when a sorted keyset is divided into consecutive ranges, they are copied
+ * as one block without comparing them. @p source is not changed.
+ *
+ * @param ks the keyset that will receive the keys
+ * @param source the keyset that provides the keys
+ * @param start the position of the first key to append
+ * @param end the position after the last key to append
+ *
+ * @return the size of @p ks after the transfer
+ * @retval -1 on NULL pointers, invalid positions or memory errors
+ */
+ssize_t ksAppendRangeInternal (KeySet * ks, const KeySet * source, size_t start, size_t end)
+{
+	if (!ks || !source) return -1;
+	if (ks == source || start > end || end > source->size) return -1;
+	if (start == end) return ks->size;
+
+	size_t toAlloc = ks->array == NULL ? KEYSET_SIZE : ks->alloc;
+	for (; ks->size + end - start >= toAlloc; toAlloc *= 2)
+		;
+	if (ksResize (ks, toAlloc - 1) == -1) return -1;
+
+	return ksMergeInternal (ks, source->array + start, end - start);
 }
 
 
@@ -975,6 +1382,106 @@ ssize_t ksCopyInternal (KeySet * ks, size_t to, size_t from)
 	return ret;
 }
 
+/**
+ * @internal
+ *
+ * Size of the prefix of the unescaped name, which all keys below or
+ * same as @p root share. For a root key (e.g. `user:/`) the trailing
+ * null byte of the empty part is not shared.
+ */
+static size_t elektraHierarchyPrefixSize (const Key * root)
+{
+	return root->keyUSize == 3 ? 2 : root->keyUSize;
+}
+
+/**
+ * @internal
+ *
+ * Searches the end of the range of keys below or same as @p root.
+ *
+ * All keys in the range share the prefix of the unescaped name of @p root,
+ * so they are contiguous in the sorted array and a binary search suffices.
+ *
+ * @param ks    the keyset to search
+ * @param root  the root of the hierarchy
+ * @param start index of the first key in the range
+ *
+ * @return index after the last key of the range
+ */
+static size_t elektraKsHierarchyEnd (const KeySet * ks, const Key * root, size_t start)
+{
+	size_t prefixSize = elektraHierarchyPrefixSize (root);
+	size_t left = start;
+	size_t right = ks->size;
+
+	while (left < right)
+	{
+		size_t middle = left + (right - left) / 2;
+		const Key * cur = ks->array[middle];
+		if (cur->keyUSize >= prefixSize && memcmp (cur->ukey, root->ukey, prefixSize) == 0)
+		{
+			left = middle + 1;
+		}
+		else
+		{
+			right = middle;
+		}
+	}
+
+	return left;
+}
+
+/**
+ * Finds the range of keys below or same as @p root in @p ks.
+ *
+ * In contrast to ksCut() nothing is removed or copied and the cursor is not
+ * changed. The keys can be accessed with ksAtCursor(). Both boundaries are
+ * found with a binary search, so the costs only depend logarithmically on
+ * the size of @p ks.
+ *
+ * Only keys of the namespace of @p root are part of the range. For a cascading
+ * @p root only cascading keys are returned, the other namespaces have to be
+ * searched separately (e.g. with keySetNamespace() on a copy of @p root).
+ *
+ * @code
+elektraCursor end;
+for (elektraCursor it = ksFindHierarchy (ks, root, &end); it < end; ++it)
+{
+	Key * cur = ksAtCursor (ks, it);
+}
+ * @endcode
+ *
+ * @param ks   the keyset to search
+ * @param root the root of the hierarchy
+ * @param end  the index after the last key of the range will be stored here
+ *
+ * @return the index of the first key of the range, equal to @p end if the range is empty
+ * @retval -1 on NULL pointers
+ */
+elektraCursor ksFindHierarchy (const KeySet * ks, const Key * root, elektraCursor * end)
+{
+	if (!ks || !root || !end) return -1;
+	if (!root->ukey) return -1;
+
+	size_t left = 0;
+	size_t right = ks->size;
+	while (left < right)
+	{
+		size_t middle = left + (right - left) / 2;
+		if (keyCompareByName (&ks->array[middle], &root) < 0)
+		{
+			left = middle + 1;
+		}
+		else
+		{
+			right = middle;
+		}
+	}
+
+	*end = elektraKsHierarchyEnd (ks, root, left);
+	return left;
+}
+
 /**
  * Searches for the start and end indicies corresponding to the given cutpoint.
  *
@@ -1004,9 +1511,17 @@ static int elektraKsFindCutpoint (KeySet * ks, const Key * cutpoint, size_t * fr
 	size_t found = it;
 
 	// search the end of the keyset to cut
-	while (it < ks->size && keyIsBelowOrSame (cutpoint, ks->array[it]) == 1)
+	if (cutpoint->ukey[0] != KEY_NS_CASCADING)
 	{
-		++it;
+		it = elektraKsHierarchyEnd (ks, cutpoint, found);
+	}
+	else
+	{
+		// keys of all namespaces are below a cascading cutpoint
+		while (it < ks->size && keyIsBelowOrSame (cutpoint, ks->array[it]) == 1)
+		{
+			++it;
+		}
 	}
 
 	// correct cursor if cursor is in cut keyset
@@ -1222,20 +1737,45 @@ ksDel (ks2);
  */
 Key * ksPop (KeySet * ks)
 {
-	Key * ret = 0;
-
 	if (!ks) return 0;
 
 	ks->flags |= KS_FLAG_SYNC;
 
 	if (ks->size == 0) return 0;
 
-	elektraOpmphmInvalidate (ks);
+	return ksPopAtInternal (ks, ks->size - 1);
+}
 
+/**
+ * @internal
+ *
+ * @brief Removes the Key at @p position from the KeySet.
+ *
+ * Moves all following keys one position to the front.
+ * Does not modify the cursor.
+ *
+ * @pre @p position is smaller than the size of @p ks
+ *
+ * @param ks the KeySet
+ * @param position the position of the Key to remove
+ * @return the removed Key with decremented reference counter
+ * @see ksPop(), elektraKsPopAtCursor()
+ */
+Key * ksPopAtInternal (KeySet * ks, size_t position)
+{
+	ELEKTRA_ASSERT (position < ks->size, "position %zu not below size %zu", position, ks->size);
+
+	Key * ret = ks->array[position];
+
+	ks->flags |= KS_FLAG_SYNC;
+
+	/* Move the keys after position over the removed key */
+	memmove (ks->array + position, ks->array + position + 1, (ks->size - position - 1) * sizeof (Key *));
 	--ks->size;
-	if (ks->size + 1 < ks->alloc / 2) ksResize (ks, ks->alloc / 2 - 1);
-	ret = ks->array[ks->size];
 	ks->array[ks->size] = 0;
+	elektraOpmphmRecord (ks, position, 0);
+
+	if (ks->size + 1 < ks->alloc / 2) ksResize (ks, ks->alloc / 2 - 1);
 	keyDecRef (ret);
 
 	return ret;
@@ -1758,12 +2298,134 @@ finished:
 	return ret;
 }
 
+/**
+ * @internal
+ *
+ * Whether a cascading lookup can be done without changing the name
+ * of the key. Lookups with callbacks, ::KDB_O_POP or ::KDB_O_OPMPHM
+ * rename the key for every namespace.
+ */
+static int elektraLookupIsDirect (const Key * key, elektraLookupFlags options)
+{
+	return !(options & (KDB_O_POP | KDB_O_OPMPHM)) && !keyGetMeta (key, "callback");
+}
+
+/**
+ * @internal
+ *
+ * Binary search for the Key with the name of @p key in the namespace @p ns.
+ *
+ * The namespace is only compared and not written to @p key, so the name
+ * of @p key is never changed. The namespaces are sorted in the array, so
+ * searches for several namespaces in ascending order can continue at the
+ * position, where the previous search stopped.
+ *
+ * @param ks    the keyset to search
+ * @param key   the key with the name to search for, its namespace is ignored
+ * @param ns    the namespace to search in
+ * @param start index where the search starts, set to the position of the
+ *              found key or where it would be inserted
+ *
+ * @retval 1 if the key was found
+ * @retval 0 otherwise
+ */
+static int elektraKsSearchNamespace (const KeySet * ks, const Key * key, elektraNamespace ns, size_t * start)
+{
+	const char * rest = key->ukey + 1;
+	size_t restSize = key->keyUSize - 1;
+	size_t left = *start;
+	size_t right = ks->size;
+	int found = 0;
+
+	while (left < right)
+	{
+		size_t middle = left + (right - left) / 2;
+		const Key * cur = ks->array[middle];
+
+		int cmp = (int) (unsigned char) cur->ukey[0] - (int) ns;
+		if (cmp == 0)
+		{
+			size_t curSize = cur->keyUSize - 1;
+			cmp = memcmp (cur->ukey + 1, rest, curSize < restSize ? curSize : restSize);
+			if (cmp == 0 && curSize != restSize)
+			{
+				cmp = curSize < restSize ? -1 : 1;
+			}
+		}
+
+		if (cmp < 0)
+		{
+			left = middle + 1;
+		}
+		else
+		{
+			found |= cmp == 0;
+			right = middle;
+		}
+	}
+
+	*start = left;
+	return found;
+}
+
+/**
+ * @internal
+ * @brief Helper for elektraLookupByCascading
+ *
+ * Cascading lookup, which does not change the name of @p key.
+ * It searches the namespaces in the order of the array.
+ * Must only be used if elektraLookupIsDirect() is true.
+ *
+ * @param ks      the keyset to search
+ * @param key     the cascading key
+ * @param options lookup options
+ */
+static Key * elektraLookupByCascadingNamespaces (KeySet * ks, Key * key, elektraLookupFlags options)
+{
+	static const elektraNamespace namespaces[] = { KEY_NS_PROC, KEY_NS_DIR, KEY_NS_USER, KEY_NS_SYSTEM, KEY_NS_DEFAULT };
+	size_t start = 0;
+
+	if (!(options & KDB_O_NOSPEC) && elektraKsSearchNamespace (ks, key, KEY_NS_SPEC, &start))
+	{
+		// we found a spec key, so we know what to do
+		Key * specKey = keyDup (ks->array[start]);
+		keySetBinary (specKey, keyValue (key), keyGetValueSize (key));
+		elektraCopyCallbackMeta (specKey, key);
+		Key * found = elektraLookupBySpec (ks, specKey, options);
+		elektraCopyCallbackMeta (key, specKey);
+		keyDel (specKey);
+		return found;
+	}
+
+	for (size_t i = 0; i < sizeof (namespaces) / sizeof (namespaces[0]); ++i)
+	{
+		if (elektraKsSearchNamespace (ks, key, namespaces[i], &start))
+		{
+			ksSetCursor (ks, start);
+			return ks->array[start];
+		}
+	}
+
+	if (!(options & KDB_O_NODEFAULT))
+	{
+		// search / key itself
+		return ksLookup (ks, key, options | KDB_O_NOCASCADING);
+	}
+
+	return 0;
+}
+
 /**
  * @internal
  * @brief Helper for ksLookup
  */
 static Key * elektraLookupByCascading (KeySet * ks, Key * key, elektraLookupFlags options)
 {
+	if (elektraLookupIsDirect (key, options))
+	{
+		return elektraLookupByCascadingNamespaces (ks, key, options);
+	}
+
 	elektraNamespace oldNS = keyGetNamespace (key);
 	Key * found = 0;
 	Key * specKey = 0;
@@ -1839,9 +2501,13 @@ static Key * elektraLookupBinarySearch (KeySet * ks, Key const * key, elektraLoo
 	elektraCursor cursor = 0;
 	cursor = ksGetCursor (ks);
 	Key ** found;
-	size_t jump = 0;
-	/*If there is a known offset in the beginning jump could be set*/
-	found = (Key **) bsearch (&key, ks->array + jump, ks->size - jump, sizeof (Key *), keyCompareByName);
+	size_t start = 0;
+	size_t end = ks->size;
+	if (ks->size > 0 && (ks->prefixes || elektraKsPrefixesBuild (ks) == 0))
+	{
+		elektraKsPrefixesSearch (ks, key, &start, &end);
+	}
+	found = (Key **) bsearch (&key, ks->array + start, end - start, sizeof (Key *), keyCompareByName);
 
 	if (found)
 	{
@@ -1944,6 +2610,7 @@ static int elektraLookupBuildOpmphm (KeySet * ks)
 	}
 
 	opmphmGraphDel (graph);
+	if (ks->opmphmDelta) opmphmDeltaClear (ks->opmphmDelta);
 	return 0;
 }
 
@@ -1953,6 +2620,9 @@ static int elektraLookupBuildOpmphm (KeySet * ks)
  * @brief Searches for a Key in an already build OPMPHM.
  *
  * The OPMPHM must be build.
+ * Changes recorded in the OPMPHM delta since the build are taken into account:
+ * the order returned by the OPMPHM is mapped to the current position and
+ * inserted Keys are compared directly.
  *
  * @param ks the KeySet
  * @param key the Key to search for
@@ -1967,15 +2637,32 @@ static Key * elektraLookupOpmphmSearch (KeySet * ks, Key const * key, elektraLoo
 	ELEKTRA_ASSERT (opmphmIsBuild (ks->opmphm), "OPMPHM not build");
 	elektraCursor cursor = 0;
 	cursor = ksGetCursor (ks);
-	size_t index = opmphmLookup (ks->opmphm, ks->size, keyName (key));
+	const char * name = keyName (key);
+	const OpmphmDelta * delta = ks->opmphmDelta;
+	size_t index;
+	if (delta && delta->size)
+	{
+		// the OPMPHM contains the keys of the last build
+		size_t buildSize = ks->size + delta->removed - delta->inserted;
+		index = buildSize ? opmphmDeltaMap (delta, 0, opmphmLookup (ks->opmphm, buildSize, name)) : OPMPHM_DELTA_REMOVED;
+		for (size_t i = 0; i < delta->size && (index >= ks->size || strcmp (keyName (ks->array[index]), name)); ++i)
+		{
+			if (delta->changes[i].insert) index = opmphmDeltaMap (delta, i + 1, delta->changes[i].order);
+		}
+	}
+	else
+	{
+		index = opmphmLookup (ks->opmphm, ks->size, name);
+	}
 	if (index >= ks->size)
 	{
+		ksSetCursor (ks, cursor);
 		return 0;
 	}
 
 	Key * found = ks->array[index];
 
-	if (!strcmp (keyName (found), keyName (key)))
+	if (!strcmp (keyName (found), name))
 	{
 		cursor = index;
 		if (options & KDB_O_POP)
@@ -2239,9 +2926,10 @@ Key * ksLookup (KeySet * ks, Key * key, elektraLookupFlags options)
 	else if (!(options & KDB_O_NOCASCADING) && strcmp (name, "") && name[0] == '/')
 	{
 		Key * lookupKey = key;
-		if (test_bit (key->flags, KEY_FLAG_RO_NAME)) lookupKey = keyDup (key);
+		int copy = test_bit (key->flags, KEY_FLAG_RO_NAME) && !elektraLookupIsDirect (key, options & mask);
+		if (copy) lookupKey = keyDup (key);
 		ret = elektraLookupByCascading (ks, lookupKey, options & mask);
-		if (test_bit (key->flags, KEY_FLAG_RO_NAME))
+		if (copy)
 		{
 			elektraCopyCallbackMeta (key, lookupKey);
 			keyDel (lookupKey);
@@ -2415,11 +3103,17 @@ int ksInit (KeySet * ks)
 	ks->size = 0;
 	ks->alloc = 0;
 	ks->flags = 0;
+	ks->arena = NULL;
+	ks->prefixes = NULL;
+	ks->prefixAlloc = 0;
+	ks->prefixSkip = 0;
+	ks->shared = 0;
 
 	ksRewind (ks);
 
 #ifdef ELEKTRA_ENABLE_OPTIMIZATIONS
 	ks->opmphm = NULL;
+	ks->opmphmDelta = NULL;
 	// first lookup should predict so invalidate it
 	elektraOpmphmInvalidate (ks);
 	ks->opmphmPredictor = NULL;
@@ -0,0 +1,265 @@
+/**
+ * @file
+ *
+ * @brief Bulk construction of KeySets, e.g. by storage plugins.
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ */
+
+#include <string.h>
+
+#include <kdbassert.h>
+#include <kdbprivate.h>
+
+/**
+ * @internal
+ *
+ * Keys collected by the builder, in the order they were added.
+ */
+struct _ElektraKsBuilder
+{
+	Key ** array; /*!< the added keys, terminated by NULL */
+	size_t size;  /*!< number of added keys */
+	size_t alloc; /*!< allocated size of array */
+	bool sorted;  /*!< every key was greater than the one added before */
+};
+
+/**
+ * @internal
+ *
+ * @brief Stable merge sort of @p array by keyCmp().
+ *
+ * Halves that are already in order are not merged, so sorted runs,
+ * as produced by most parsers, only need one comparison each.
+ *
+ * @param array the keys to sort
+ * @param buffer room for at least @p size / 2 keys
+ * @param size the number of keys
+ */
+static void elektraKsBuilderSort (Key ** array, Key ** buffer, size_t size)
+{
+	if (size < 2) return;
+
+	size_t half = size / 2;
+	elektraKsBuilderSort (array, buffer, half);
+	elektraKsBuilderSort (array + half, buffer, size - half);
+	if (keyCmp (array[half - 1], array[half]) <= 0) return;
+
+	memcpy (buffer, array, half * sizeof (Key *));
+	size_t i = 0;
+	size_t j = half;
+	size_t k = 0;
+	while (i < half && j < size)
+	{
+		// equal keys are taken from the left to keep the order they were added
+		if (keyCmp (array[j], buffer[i]) < 0)
+			array[k++] = array[j++];
+		else
+			array[k++] = buffer[i++];
+	}
+	while (i < half)
+	{
+		array[k++] = buffer[i++];
+	}
+}
+
+/**
+ * @brief Creates a builder for a KeySet.
+ *
+ * Keys are added with elektraKsBuilderAdd() or elektraKsBuilderAddBelow()
+ * without keeping them sorted. elektraKsBuilderFinish() sorts them once
+ * and returns them as KeySet. Keys which are added in sorted order,
+ * as most storage plugins read them, are not sorted at all.
+ *
+ * @param alloc the expected number of keys, the builder grows if more are added
+ *
+ * @return the new builder
+ * @retval NULL on memory error
+ * @see elektraKsBuilderFinish(), elektraKsBuilderDel()
+ */
+ElektraKsBuilder * elektraKsBuilderNew (size_t alloc)
+{
+	ElektraKsBuilder * builder = elektraCalloc (sizeof (ElektraKsBuilder));
+	if (!builder) return NULL;
+
+	builder->alloc = alloc + 1 < KEYSET_SIZE ? KEYSET_SIZE : alloc + 1;
+	builder->array = elektraMalloc (builder->alloc * sizeof (Key *));
+	if (!builder->array)
+	{
+		elektraFree (builder);
+		return NULL;
+	}
+	builder->array[0] = NULL;
+	builder->sorted = true;
+	return builder;
+}
+
+/**
+ * @brief Adds a Key to the builder.
+ *
+ * Like ksAppendKey(), the name of @p key gets locked and the builder
+ * holds a reference to it. If a Key with the same name was added before,
+ * the Key added last is kept by elektraKsBuilderFinish().
+ *
+ * @param builder the builder
+ * @param key the Key to add, it is deleted if it cannot be added
+ *
+ * @return the number of added keys
+ * @retval -1 on NULL pointers, a Key without name or memory error
+ */
+ssize_t elektraKsBuilderAdd (ElektraKsBuilder * builder, Key * key)
+{
+	if (!key) return -1;
+	if (!builder || !key->key)
+	{
+		keyDel (key);
+		return -1;
+	}
+
+	if (builder->size + 1 >= builder->alloc)
+	{
+		size_t alloc = builder->alloc * 2;
+		if (elektraRealloc ((void **) &builder->array, alloc * sizeof (Key *)) == -1)
+		{
+			keyDel (key);
+			return -1;
+		}
+		builder->alloc = alloc;
+	}
+
+	keyLock (key, KEY_LOCK_NAME);
+	keyIncRef (key);
+
+	if (builder->sorted && builder->size > 0 && keyCmp (builder->array[builder->size - 1], key) >= 0)
+	{
+		builder->sorted = false;
+	}
+	builder->array[builder->size++] = key;
+	builder->array[builder->size] = NULL;
+	return builder->size;
+}
+
+/**
+ * @brief Creates a Key below @p parent and adds it to the builder.
+ *
+ * The name of @p parent is copied as it is, only @p name is validated
+ * and canonicalized, see keyAddName(). This is cheaper than keyNew()
+ * with the name of the parent followed by keyAddName().
+ *
+ * The returned Key is owned by the builder, its value and metadata
+ * may be changed until elektraKsBuilderFinish() is called.
+ *
+ * @param builder the builder
+ * @param parent the Key whose name is used as prefix
+ * @param name the escaped name relative to @p parent, see keyAddName()
+ * @param value the string value of the Key or NULL
+ *
+ * @return the new Key
+ * @retval NULL on NULL pointers, an invalid @p name or memory error
+ */
+Key * elektraKsBuilderAddBelow (ElektraKsBuilder * builder, const Key * parent, const char * name, const char * value)
+{
+	if (!builder || !parent || !parent->key || !name) return NULL;
+
+	Key * key = elektraCalloc (sizeof (Key));
+	if (!key) return NULL;
+	keyInit (key);
+
+	key->key = elektraStrNDup (parent->key, parent->keySize);
+	key->ukey = elektraStrNDup (parent->ukey, parent->keyUSize);
+	key->keySize = parent->keySize;
+	key->keyUSize = parent->keyUSize;
+	key->flags = KEY_FLAG_SYNC;
+
+	if (!key->key || !key->ukey || keyAddName (key, name) < 0 || (value && keySetString (key, value) < 0))
+	{
+		keyDel (key);
+		return NULL;
+	}
+
+	if (elektraKsBuilderAdd (builder, key) == -1) return NULL;
+	return key;
+}
+
+/**
+ * @brief Sorts the added keys and returns them as KeySet.
+ *
+ * Sorting is skipped if the keys were added in order. Of keys with
+ * the same name only the one added last is kept. The array of the
+ * builder is handed over to the KeySet without copying it.
+ *
+ * The builder is freed, it must not be used anymore.
+ *
+ * @param builder the builder
+ *
+ * @return a KeySet with all added keys
+ * @retval NULL on NULL pointers or memory error, the builder is freed then, too
+ */
+KeySet * elektraKsBuilderFinish (ElektraKsBuilder * builder)
+{
+	if (!builder) return NULL;
+
+	Key ** array = builder->array;
+	size_t size = builder->size;
+
+	if (!builder->sorted)
+	{
+		Key ** buffer = elektraMalloc ((size / 2 + 1) * sizeof (Key *));
+		if (!buffer)
+		{
+			elektraKsBuilderDel (builder);
+			return NULL;
+		}
+		elektraKsBuilderSort (array, buffer, size);
+		elektraFree (buffer);
+
+		// keep the key added last of keys with the same name
+		size_t unique = 0;
+		for (size_t i = 0; i < size; ++i)
+		{
+			if (unique > 0 && keyCmp (array[unique - 1], array[i]) == 0)
+			{
+				keyDecRef (array[unique - 1]);
+				keyDel (array[unique - 1]);
+				array[unique - 1] = array[i];
+			}
+			else
+			{
+				array[unique++] = array[i];
+			}
+		}
+		size = unique;
+		array[size] = NULL;
+	}
+
+	KeySet * ks = ksNew (0, KS_END);
+	if (!ks)
+	{
+		elektraKsBuilderDel (builder);
+		return NULL;
+	}
+
+	ks->array = array;
+	ks->size = size;
+	ks->alloc = builder->alloc;
+	elektraFree (builder);
+	return ks;
+}
+
+/**
+ * @brief Frees the builder and all keys that are not referenced elsewhere.
+ *
+ * @param builder the builder to free, or NULL
+ */
+void elektraKsBuilderDel (ElektraKsBuilder * builder)
+{
+	if (!builder) return;
+
+	for (size_t i = 0; i < builder->size; ++i)
+	{
+		keyDecRef (builder->array[i]);
+		keyDel (builder->array[i]);
+	}
+	elektraFree (builder->array);
+	elektraFree (builder);
+}
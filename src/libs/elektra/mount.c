@@ -361,6 +361,14 @@ KeySet * elektraDefaultGlobalConfig (KeySet * keys)
 	{
 		ksAppendKey (config, keyNew ("system:/elektra/globalplugins/postgetcache", KEY_VALUE, "cache", KEY_END));
 		ksAppendKey (config, keyNew ("system:/elektra/globalplugins/pregetcache", KEY_VALUE, "cache", KEY_END));
+
+		// keep cache files in shared memory
+		Key * cacheShared = ksLookupByName (keys, "system:/elektra/cache/shared", 0);
+		if (cacheShared && !elektraStrCmp (keyString (cacheShared), "1"))
+		{
+			ksAppendKey (config, keyNew ("system:/elektra/globalplugins/postgetcache/system/shared", KEY_VALUE, "1", KEY_END));
+			ksAppendKey (config, keyNew ("system:/elektra/globalplugins/pregetcache/system/shared", KEY_VALUE, "1", KEY_END));
+		}
 	}
 
 	return config;
@@ -718,9 +726,35 @@ Key * mountGetMountpoint (KDB * handle, const char * where)
  */
 Backend * mountGetBackend (KDB * handle, const char * where)
 {
-	if (where == NULL || strlen (where) == 0) return handle->defaultBackend;
+	if (where == NULL || where[0] == '\0') return handle->defaultBackend;
 
 	Backend * ret = trieLookup (handle->trie, where);
 	if (!ret) return handle->defaultBackend;
 	return ret;
 }
+
+/**
+ * Lookup a backend handle for a specific key and the keys below it.
+ *
+ * Like mountGetBackend(), but also tells if the returned backend
+ * is responsible for all keys below @p where, i.e. if no other
+ * backend is mounted below @p where.
+ *
+ * @param handle is the data structure, where the mounted directories are saved.
+ * @param where the key name, that should be looked up.
+ * @param [out] exclusive set to 1 if all keys below @p where belong to the returned backend, 0 otherwise
+ * @return the backend handle associated with the key
+ * @ingroup mount
+ */
+Backend * mountGetBackendHierarchy (KDB * handle, const char * where, int * exclusive)
+{
+	if (where == NULL || where[0] == '\0')
+	{
+		*exclusive = handle->trie == NULL;
+		return handle->defaultBackend;
+	}
+
+	Backend * ret = trieLookupHierarchy (handle->trie, where, exclusive);
+	if (!ret) return handle->defaultBackend;
+	return ret;
+}
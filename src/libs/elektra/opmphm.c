@@ -634,6 +634,110 @@ void opmphmClear (Opmphm * opmphm)
 	}
 }
 
+/**
+ * @brief Allocates and initializes an empty OpmphmDelta.
+ *
+ * @retval OpmphmDelta * success
+ * @retval NULL memory error
+ */
+OpmphmDelta * opmphmDeltaNew (void)
+{
+	return elektraCalloc (sizeof (OpmphmDelta));
+}
+
+/**
+ * @brief Deletes the OpmphmDelta.
+ *
+ * @param delta the OpmphmDelta
+ */
+void opmphmDeltaDel (OpmphmDelta * delta)
+{
+	ELEKTRA_NOT_NULL (delta);
+	elektraFree (delta);
+}
+
+/**
+ * @brief Forgets all recorded changes.
+ *
+ * Must be called whenever the OPMPHM is build or cleared.
+ *
+ * @param delta the OpmphmDelta
+ */
+void opmphmDeltaClear (OpmphmDelta * delta)
+{
+	ELEKTRA_NOT_NULL (delta);
+	delta->size = 0;
+	delta->inserted = 0;
+	delta->removed = 0;
+}
+
+/**
+ * @brief Records the insertion or removal of an element.
+ *
+ * @param delta the OpmphmDelta
+ * @param order the order of the inserted or removed element, after previous changes
+ * @param insert 1 for insertions, 0 for removals
+ *
+ * @retval 0 on success
+ * @retval -1 if OPMPHM_DELTA_MAX changes are recorded already
+ */
+int opmphmDeltaAdd (OpmphmDelta * delta, size_t order, int insert)
+{
+	ELEKTRA_NOT_NULL (delta);
+	if (delta->size >= OPMPHM_DELTA_MAX)
+	{
+		return -1;
+	}
+	delta->changes[delta->size].order = order;
+	delta->changes[delta->size].insert = insert;
+	++delta->size;
+	if (insert)
+	{
+		++delta->inserted;
+	}
+	else
+	{
+		++delta->removed;
+	}
+	return 0;
+}
+
+/**
+ * @brief Maps an order through the recorded changes.
+ *
+ * To map an order returned by opmphmLookup () use `first = 0`.
+ * To get the current order of the element inserted with change `i` use
+ * `first = i + 1` and the order of change `i`.
+ *
+ * @param delta the OpmphmDelta
+ * @param first the first change to apply
+ * @param order the order before change `first`
+ *
+ * @return the current order of the element
+ * @retval OPMPHM_DELTA_REMOVED if the element was removed
+ */
+size_t opmphmDeltaMap (const OpmphmDelta * delta, size_t first, size_t order)
+{
+	ELEKTRA_NOT_NULL (delta);
+	for (size_t i = first; i < delta->size; ++i)
+	{
+		const OpmphmChange * change = &delta->changes[i];
+		if (change->insert)
+		{
+			if (order >= change->order) ++order;
+		}
+		else if (order == change->order)
+		{
+			return OPMPHM_DELTA_REMOVED;
+		}
+		else if (order > change->order)
+		{
+			--order;
+		}
+	}
+	return order;
+}
+
 /**
  * Hash function
  * By Bob Jenkins, May 2006
@@ -352,6 +352,95 @@ int splitBuildup (Split * split, KDB * kdb, Key * parentKey)
 }
 
 
+/**
+ * @internal
+ * @brief Compares two positions for qsort()
+ */
+static int splitCompareBoundaries (const void * a, const void * b)
+{
+	size_t x = *(const size_t *) a;
+	size_t y = *(const size_t *) b;
+	return (x > y) - (x < y);
+}
+
+/**
+ * @internal
+ * @brief Finds the position of the first key in @p ks with a namespace of at least @p ns
+ *
+ * @param ks the keyset to search
+ * @param ns the namespace
+ *
+ * @return the position, ks->size if there is no such key
+ */
+static size_t splitNamespaceStart (const KeySet * ks, elektraNamespace ns)
+{
+	size_t left = 0;
+	size_t right = ks->size;
+	while (left < right)
+	{
+		size_t middle = left + (right - left) / 2;
+		if ((unsigned char) ks->array[middle]->ukey[0] < ns)
+		{
+			left = middle + 1;
+		}
+		else
+		{
+			right = middle;
+		}
+	}
+	return left;
+}
+
+/**
+ * @internal
+ * @brief Divides a keyset into ranges of keys that belong to the same backend
+ *
+ * A key belongs to the backend of the deepest mountpoint it is below or same as.
+ * This mountpoint can only change where a namespace or the hierarchy of a mountpoint
+ * starts or ends. As @p ks is sorted, these boundaries are found with binary searches,
+ * so the costs depend on the number of mountpoints and only logarithmically on the
+ * size of @p ks.
+ *
+ * @param handle contains all mountpoints in handle->split
+ * @param ks the keyset to divide
+ * @param [out] size the number of boundaries
+ *
+ * @return the sorted boundaries, starting with 0 and ending with ks->size, to be freed with elektraFree()
+ * @retval 0 on memory errors
+ */
+static size_t * splitFindBoundaries (KDB * handle, KeySet * ks, size_t * size)
+{
+	size_t mountpoints = handle->split ? handle->split->size : 0;
+	size_t * boundaries = elektraMalloc ((2 * mountpoints + KEY_NS_DEFAULT + 2) * sizeof (size_t));
+	if (!boundaries) return 0;
+
+	size_t n = 0;
+	boundaries[n++] = 0;
+	boundaries[n++] = ks->size;
+	for (elektraNamespace ns = KEY_NS_CASCADING; ns <= KEY_NS_DEFAULT; ++ns)
+	{
+		boundaries[n++] = splitNamespaceStart (ks, ns);
+	}
+	for (size_t i = 0; i < mountpoints; ++i)
+	{
+		elektraCursor end;
+		elektraCursor start = ksFindHierarchy (ks, handle->split->parents[i], &end);
+		if (start < 0) continue;
+		boundaries[n++] = start;
+		boundaries[n++] = end;
+	}
+
+	qsort (boundaries, n, sizeof (size_t), splitCompareBoundaries);
+
+	size_t unique = 1;
+	for (size_t i = 1; i < n; ++i)
+	{
+		if (boundaries[i] != boundaries[unique - 1]) boundaries[unique++] = boundaries[i];
+	}
+	*size = unique;
+	return boundaries;
+}
+
 /**
  * Splits up the keysets and search for a sync bit in every key.
  *
@@ -375,33 +464,49 @@ int splitBuildup (Split * split, KDB * kdb, Key * parentKey)
 int splitDivide (Split * split, KDB * handle, KeySet * ks)
 {
 	int needsSync = 0;
-	Key * curKey = 0;
+	size_t size;
+	size_t * boundaries = splitFindBoundaries (handle, ks, &size);
+	if (!boundaries) return -1;
 
-	ksRewind (ks);
-	while ((curKey = ksNext (ks)) != 0)
+	// all keys between two boundaries belong to the same backend
+	for (size_t b = 0; b + 1 < size; ++b)
 	{
+		size_t start = boundaries[b];
+		size_t end = boundaries[b + 1];
+		Key * curKey = ks->array[start];
+
 		// TODO: handle keys in wrong namespaces
 		Backend * curHandle = mountGetBackend (handle, keyName (curKey));
-		if (!curHandle) return -1;
+		if (!curHandle)
+		{
+			ksSetCursor (ks, start);
+			elektraFree (boundaries);
+			return -1;
+		}
 
-		/* If key could be appended to any of the existing split keysets */
+		/* If keys could be appended to any of the existing split keysets */
 		ssize_t curFound = splitSearchBackend (split, curHandle, curKey);
 
 		if (curFound == -1)
 		{
-			ELEKTRA_LOG_DEBUG ("SKIPPING NOT RELEVANT KEY: %p key: %s, string: %s", (void *) curKey, keyName (curKey),
-					   keyString (curKey));
-			continue; // key not relevant in this kdbSet
+			ELEKTRA_LOG_DEBUG ("SKIPPING %zu NOT RELEVANT KEYS, first key: %s", end - start, keyName (curKey));
+			continue; // keys not relevant in this kdbSet
 		}
 
-		ksAppendKey (split->keysets[curFound], curKey);
-		if (keyNeedSync (curKey) == 1)
+		ksAppendRangeInternal (split->keysets[curFound], ks, start, end);
+		for (size_t i = start; i < end; ++i)
 		{
-			split->syncbits[curFound] |= 1;
-			needsSync = 1;
+			if (keyNeedSync (ks->array[i]) == 1)
+			{
+				split->syncbits[curFound] |= 1;
+				needsSync = 1;
+				break;
+			}
 		}
 	}
 
+	elektraFree (boundaries);
+	ksRewind (ks);
 	return needsSync;
 }
 
@@ -442,16 +547,25 @@ void splitUpdateFileName (Split * split, KDB * handle, Key * key)
  */
 int splitAppoint (Split * split, KDB * handle, KeySet * ks)
 {
-	Key * curKey = 0;
 	ssize_t defFound = splitAppend (split, 0, 0, 0);
+	size_t size;
+	size_t * boundaries = splitFindBoundaries (handle, ks, &size);
+	if (!boundaries) return -1;
 
-	ksRewind (ks);
-	while ((curKey = ksNext (ks)) != 0)
+	// all keys between two boundaries belong to the same backend
+	for (size_t b = 0; b + 1 < size; ++b)
 	{
+		size_t start = boundaries[b];
+		Key * curKey = ks->array[start];
+
 		Backend * curHandle = mountGetBackend (handle, keyName (curKey));
-		if (!curHandle) return -1;
+		if (!curHandle)
+		{
+			elektraFree (boundaries);
+			return -1;
+		}
 
-		/* If key could be appended to any of the existing split keysets */
+		/* If keys could be appended to any of the existing split keysets */
 		ssize_t curFound = splitSearchBackend (split, curHandle, curKey);
 
 		if (curFound == -1) curFound = defFound;
@@ -461,9 +575,11 @@ int splitAppoint (Split * split, KDB * handle, KeySet * ks)
 			continue;
 		}
 
-		ksAppendKey (split->keysets[curFound], curKey);
+		ksAppendRangeInternal (split->keysets[curFound], ks, start, boundaries[b + 1]);
 	}
 
+	elektraFree (boundaries);
+	ksRewind (ks);
 	return 1;
 }
 
@@ -511,10 +627,17 @@ static void elektraDropCurrentKey (KeySet * ks, Key * warningKey, const Backend
 static int elektraSplitPostprocess (Split * split, int i, Key * warningKey, KDB * handle)
 {
 	Key * cur = 0;
+	Key * parent = split->parents[i];
+
+	// if no other backend is mounted below the parent, keys below it need no lookup
+	int exclusive = 0;
+	if (mountGetBackendHierarchy (handle, keyName (parent), &exclusive) != split->handles[i]) exclusive = 0;
+
 	ksRewind (split->keysets[i]);
 	while ((cur = ksNext (split->keysets[i])) != 0)
 	{
-		Backend * curHandle = mountGetBackend (handle, keyName (cur));
+		Backend * curHandle =
+			exclusive && keyIsBelowOrSame (parent, cur) == 1 ? split->handles[i] : mountGetBackend (handle, keyName (cur));
 		if (!curHandle) return -1;
 
 		keyClearSync (cur);
@@ -663,6 +786,16 @@ int splitMergeBackends (Split * split, KeySet * dest)
 {
 	/* Bypass default split */
 	const int bypassedSplits = 1;
+
+	/* Do only one resize in advance, ksAppend() then only merges */
+	size_t total = ksGetSize (dest);
+	for (size_t i = 0; i < split->size - bypassedSplits; ++i)
+	{
+		if (test_bit (split->syncbits[i], 0)) continue;
+		total += ksGetSize (split->keysets[i]);
+	}
+	if (total >= dest->alloc) ksResize (dest, total);
+
 	for (size_t i = 0; i < split->size - bypassedSplits; ++i)
 	{
 		if (test_bit (split->syncbits[i], 0))
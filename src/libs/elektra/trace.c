@@ -0,0 +1,362 @@
+/**
+ * @file
+ *
+ * @brief Tracing of the phases of kdbGet() and kdbSet().
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ */
+
+#include "kdbconfig.h"
+
+#include <inttypes.h>
+#include <time.h>
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+#ifndef HAVE_CLOCK_GETTIME
+#include <sys/time.h>
+#endif
+
+#include <kdbglobal.h>
+#include <kdbinternal.h>
+#include <kdbtrace.h>
+
+/** number of events kept, if no capacity was given to elektraTraceEnable() */
+#define ELEKTRA_TRACE_CAPACITY 4096
+
+/**
+ * @internal
+ *
+ * Ring buffer of the events recorded for a KDB instance.
+ */
+struct _ElektraTrace
+{
+	ElektraTraceEvent * events; /*!< the ring buffer */
+	size_t capacity;	    /*!< number of events the ring buffer holds */
+	size_t first;		    /*!< index of the oldest event */
+	size_t size;		    /*!< number of recorded events */
+#ifdef HAVE_PTHREAD_H
+	pthread_mutex_t mutex; /*!< events are also recorded by the workers of kdbGet() */
+#endif
+};
+
+static const char * const phaseNames[] = { "get",     "set",	  "cache",  "resolver", "plugin",
+					   "storage", "commit", "rollback", "global",   "split" };
+
+/**
+ * @internal
+ *
+ * @brief Reads the monotonic clock.
+ *
+ * @return the current time in nanoseconds, never 0
+ */
+uint64_t elektraTraceNow (void)
+{
+#ifdef HAVE_CLOCK_GETTIME
+	struct timespec now;
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec + 1;
+#else
+	struct timeval now;
+	gettimeofday (&now, 0);
+	return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_usec * 1000 + 1;
+#endif
+}
+
+/**
+ * @internal
+ *
+ * @brief Records a phase that started at @p start and ends now.
+ *
+ * Use the macros ELEKTRA_TRACE_BEGIN() and ELEKTRA_TRACE_END() instead,
+ * they do not call any function if tracing is disabled or compiled out.
+ *
+ * The size of names and values of @p ks is only calculated for whole
+ * operations and storage plugins, after the end of the phase.
+ *
+ * @param handle the KDB instance with enabled tracing
+ * @param start the result of elektraTraceNow() at the start of the phase
+ * @param phase the phase that ended
+ * @param plugin the plugin that ran or NULL
+ * @param backend the backend the plugin belongs to or NULL
+ * @param position the position of a global plugin or -1
+ * @param subPosition the subposition of a global plugin or -1
+ * @param ks the keyset after the phase or NULL
+ */
+void elektraTraceRecord (KDB * handle, uint64_t start, ElektraTracePhase phase, const Plugin * plugin, const Backend * backend,
+			 int position, int subPosition, const KeySet * ks)
+{
+	uint64_t end = elektraTraceNow ();
+	ElektraTrace * trace = handle->trace;
+
+	ElektraTraceEvent event = { .phase = phase,
+				    .plugin = plugin ? plugin->name : 0,
+				    .backend = backend && backend->mountpoint ? keyName (backend->mountpoint) : 0,
+				    .position = position >= 0 ? GlobalpluginPositionsStr[position] : 0,
+				    .subPosition = subPosition >= 0 ? GlobalpluginSubPositionsStr[subPosition] : 0,
+				    .start = start,
+				    .duration = end - start,
+				    .thread = 0,
+				    .keys = ks ? ks->size : 0,
+				    .bytes = 0 };
+
+	if (ks && (phase == ELEKTRA_TRACE_GET || phase == ELEKTRA_TRACE_SET || phase == ELEKTRA_TRACE_STORAGE))
+	{
+		for (size_t i = 0; i < ks->size; ++i)
+		{
+			event.bytes += ks->array[i]->keySize + ks->array[i]->dataSize;
+		}
+	}
+
+#ifdef HAVE_PTHREAD_H
+	event.thread = (uint64_t) (uintptr_t) pthread_self ();
+	pthread_mutex_lock (&trace->mutex);
+#endif
+	if (trace->size < trace->capacity)
+	{
+		trace->events[(trace->first + trace->size++) % trace->capacity] = event;
+	}
+	else
+	{
+		// overwrite the oldest event
+		trace->events[trace->first] = event;
+		trace->first = (trace->first + 1) % trace->capacity;
+	}
+#ifdef HAVE_PTHREAD_H
+	pthread_mutex_unlock (&trace->mutex);
+#endif
+}
+
+/**
+ * @brief Starts tracing the phases of kdbGet() and kdbSet().
+ *
+ * Afterwards kdbGet() and kdbSet() record how long resolvers, the cache,
+ * the plugins of every backend, global plugins and splitting took,
+ * together with the number of keys, see ElektraTraceEvent.
+ * The events are read with elektraTraceRead().
+ *
+ * The events are kept in a ring buffer of @p capacity events, if more
+ * events are recorded before they are read, the oldest events are lost.
+ * Enabling tracing again discards all events.
+ *
+ * @ingroup kdbtrace
+ *
+ * @param kdb the KDB instance
+ * @param capacity the number of events to keep, 0 for a default
+ *
+ * @retval 1 on success
+ * @retval 0 if Elektra was compiled without tracing (`ENABLE_TRACE`)
+ * @retval -1 on NULL pointers or memory errors
+ */
+int elektraTraceEnable (KDB * kdb, size_t capacity)
+{
+#ifdef HAVE_TRACE
+	if (!kdb) return -1;
+	if (capacity == 0) capacity = ELEKTRA_TRACE_CAPACITY;
+
+	ElektraTrace * trace = elektraCalloc (sizeof (ElektraTrace));
+	if (!trace) return -1;
+	trace->events = elektraMalloc (capacity * sizeof (ElektraTraceEvent));
+	if (!trace->events)
+	{
+		elektraFree (trace);
+		return -1;
+	}
+	trace->capacity = capacity;
+#ifdef HAVE_PTHREAD_H
+	pthread_mutex_init (&trace->mutex, 0);
+#endif
+
+	elektraTraceDisable (kdb);
+	kdb->trace = trace;
+	return 1;
+#else
+	(void) kdb;
+	(void) capacity;
+	return 0;
+#endif
+}
+
+/**
+ * @brief Stops tracing and discards all events that were not read.
+ *
+ * Called by kdbClose().
+ *
+ * @ingroup kdbtrace
+ *
+ * @param kdb the KDB instance
+ */
+void elektraTraceDisable (KDB * kdb)
+{
+	if (!kdb || !kdb->trace) return;
+
+#ifdef HAVE_PTHREAD_H
+	pthread_mutex_destroy (&kdb->trace->mutex);
+#endif
+	elektraFree (kdb->trace->events);
+	elektraFree (kdb->trace);
+	kdb->trace = 0;
+}
+
+/**
+ * @brief Takes the oldest recorded events out of the ring buffer.
+ *
+ * Events are recorded when a phase ends, so the event of a whole kdbGet()
+ * follows the events of its phases.
+ *
+ * @ingroup kdbtrace
+ *
+ * @param kdb the KDB instance
+ * @param events receives the events
+ * @param size the number of events @p events has room for
+ *
+ * @return the number of events written to @p events,
+ *         0 if there are none or tracing is disabled
+ */
+size_t elektraTraceRead (KDB * kdb, ElektraTraceEvent * events, size_t size)
+{
+	if (!kdb || !kdb->trace || !events) return 0;
+
+	ElektraTrace * trace = kdb->trace;
+#ifdef HAVE_PTHREAD_H
+	pthread_mutex_lock (&trace->mutex);
+#endif
+	if (size > trace->size) size = trace->size;
+	for (size_t i = 0; i < size; ++i)
+	{
+		events[i] = trace->events[(trace->first + i) % trace->capacity];
+	}
+	trace->first = (trace->first + size) % trace->capacity;
+	trace->size -= size;
+#ifdef HAVE_PTHREAD_H
+	pthread_mutex_unlock (&trace->mutex);
+#endif
+	return size;
+}
+
+/**
+ * @internal
+ *
+ * @brief Writes @p string as JSON string, or `null` for NULL.
+ */
+static void traceDumpString (const char * string, FILE * file)
+{
+	if (!string)
+	{
+		fputs ("null", file);
+		return;
+	}
+
+	fputc ('"', file);
+	for (const unsigned char * c = (const unsigned char *) string; *c; ++c)
+	{
+		if (*c == '"' || *c == '\\')
+			fprintf (file, "\\%c", *c);
+		else if (*c < 0x20)
+			fprintf (file, "\\u%04x", *c);
+		else
+			fputc (*c, file);
+	}
+	fputc ('"', file);
+}
+
+/**
+ * @internal
+ *
+ * @brief Numbers threads in the order they appear in the events, starting with 1.
+ */
+static uint64_t traceThreadNumber (uint64_t * threads, size_t * size, uint64_t thread)
+{
+	for (size_t i = 0; i < *size; ++i)
+	{
+		if (threads[i] == thread) return i + 1;
+	}
+	threads[(*size)++] = thread;
+	return *size;
+}
+
+/**
+ * @brief Writes events read by elektraTraceRead() to a file.
+ *
+ * With ELEKTRA_TRACE_FORMAT_JSON, an array with an object per event
+ * is written, with the fields of ElektraTraceEvent and the names of
+ * the phases in lower case.
+ *
+ * With ELEKTRA_TRACE_FORMAT_CHROME, the events are written as complete
+ * events of the Trace Event Format, which can be opened with
+ * `about:tracing` of Chrome or with Perfetto. Times are relative to the
+ * first event. Threads are numbered in the order they appear.
+ *
+ * @ingroup kdbtrace
+ *
+ * @param events the events to write
+ * @param size the number of events
+ * @param format the format to write
+ * @param file the file to write to
+ *
+ * @retval 0 on success
+ * @retval -1 on NULL pointers, memory or write errors
+ */
+int elektraTraceDump (const ElektraTraceEvent * events, size_t size, ElektraTraceFormat format, FILE * file)
+{
+	if ((!events && size > 0) || !file) return -1;
+
+	uint64_t * threads = elektraMalloc ((size ? size : 1) * sizeof (uint64_t));
+	if (!threads) return -1;
+	size_t threadsSize = 0;
+
+	uint64_t origin = UINT64_MAX;
+	for (size_t i = 0; i < size; ++i)
+	{
+		if (events[i].start < origin) origin = events[i].start;
+	}
+
+	fputs (format == ELEKTRA_TRACE_FORMAT_CHROME ? "{\"traceEvents\":[\n" : "[\n", file);
+	for (size_t i = 0; i < size; ++i)
+	{
+		const ElektraTraceEvent * event = &events[i];
+		uint64_t thread = traceThreadNumber (threads, &threadsSize, event->thread);
+		const char * phase = phaseNames[event->phase];
+
+		if (format == ELEKTRA_TRACE_FORMAT_CHROME)
+		{
+			// global plugins are named after their position, as they usually are the list plugin
+			const char * name = event->position ? event->position : event->plugin ? event->plugin : phase;
+			fputs ("{\"name\":", file);
+			traceDumpString (name, file);
+			fputs (",\"cat\":", file);
+			traceDumpString (phase, file);
+			fprintf (file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%" PRIu64 ",\"args\":{\"backend\":",
+				 (event->start - origin) / 1000.0, event->duration / 1000.0, thread);
+			traceDumpString (event->backend, file);
+			fputs (",\"position\":", file);
+			traceDumpString (event->position, file);
+			fputs (",\"subPosition\":", file);
+			traceDumpString (event->subPosition, file);
+			fprintf (file, ",\"keys\":%zu,\"bytes\":%zu}}", event->keys, event->bytes);
+		}
+		else
+		{
+			fputs ("{\"phase\":", file);
+			traceDumpString (phase, file);
+			fputs (",\"plugin\":", file);
+			traceDumpString (event->plugin, file);
+			fputs (",\"backend\":", file);
+			traceDumpString (event->backend, file);
+			fputs (",\"position\":", file);
+			traceDumpString (event->position, file);
+			fputs (",\"subPosition\":", file);
+			traceDumpString (event->subPosition, file);
+			fprintf (file,
+				 ",\"start\":%" PRIu64 ",\"duration\":%" PRIu64 ",\"thread\":%" PRIu64 ",\"keys\":%zu,\"bytes\":%zu}",
+				 event->start, event->duration, thread, event->keys, event->bytes);
+		}
+		fputs (i + 1 < size ? ",\n" : "\n", file);
+	}
+	fputs (format == ELEKTRA_TRACE_FORMAT_CHROME ? "],\"displayTimeUnit\":\"ns\"}\n" : "]\n", file);
+
+	elektraFree (threads);
+	return ferror (file) ? -1 : 0;
+}
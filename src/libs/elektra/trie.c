@@ -33,7 +33,7 @@
 #include "kdbinternal.h"
 
 static char * elektraTrieStartsWith (const char * str, const char * substr);
-static Backend * elektraTriePrefixLookup (Trie * trie, const char * name);
+static Backend * elektraTriePrefixLookup (Trie * trie, const char * name, size_t size, int * exclusive);
 
 /**
  * @brief The Trie structure
@@ -53,16 +53,30 @@ Backend * trieLookup (Trie * trie, const char * name)
 	if (!name) return 0;
 	if (!trie) return 0;
 
-	size_t len = strlen (name) + 2;
-	if (len <= 1) return 0; // would crash otherwise
-	char * where = elektraMalloc (len);
-	strncpy (where, name, len);
-	where[len - 2] = '/';
+	return elektraTriePrefixLookup (trie, name, strlen (name), 0);
+}
 
-	Backend * ret = elektraTriePrefixLookup (trie, where);
-	elektraFree (where);
+/**
+ * Lookups a backend inside the trie and checks whether it owns the whole hierarchy.
+ *
+ * Like trieLookup(), but additionally determines if there are mountpoints
+ * below @p name. If there are none, all keys below or same as @p name
+ * belong to the returned backend, so they do not need to be looked up.
+ *
+ * @param trie the trie object to work with
+ * @param name the name to look up
+ * @param [out] exclusive set to 1 if no mountpoint is below @p name, 0 otherwise
+ * @return the backend if found
+ * @return 0 otherwise
+ * @ingroup trie
+ */
+Backend * trieLookupHierarchy (Trie * trie, const char * name, int * exclusive)
+{
+	*exclusive = 1;
+	if (!name) return 0;
+	if (!trie) return 0;
 
-	return ret;
+	return elektraTriePrefixLookup (trie, name, strlen (name), exclusive);
 }
 
 /**
@@ -241,33 +255,75 @@ static char * elektraTrieStartsWith (const char * str, const char * substr)
 	return 0;
 }
 
-static Backend * elektraTriePrefixLookup (Trie * trie, const char * name)
+/**
+ * @retval 1 if there is a backend for a name longer than the empty string in @p trie
+ * @retval 0 otherwise
+ */
+static int elektraTrieHasValueBelow (const Trie * trie)
 {
-	if (trie == NULL) return NULL;
-
-	unsigned char idx = (unsigned char) name[0];
-	const char * trieText = trie->text[idx];
-
-	if (trieText == NULL)
+	for (size_t i = 0; i < KDB_MAX_UCHAR; ++i)
 	{
-		return trie->empty_value;
+		if (trie->text[i] == NULL) continue;
+		if (trie->value[i]) return 1;
+		const Trie * child = trie->children[i];
+		if (child && (child->empty_value || elektraTrieHasValueBelow (child))) return 1;
 	}
+	return 0;
+}
 
-	void * ret = NULL;
-	if (elektraTrieStartsWith (name, trieText) == 0)
-	{
-		ret = elektraTriePrefixLookup (trie->children[idx], name + trie->textlen[idx]);
-	}
-	else
-	{
-		return trie->empty_value;
-	}
+/**
+ * Walks down the trie along @p name followed by a `/`. The `/` is not part of
+ * @p name, so no copy is needed. Returns the backend of the longest matching prefix.
+ * Root names like `user:/` already end with `/`, it is not added again.
+ *
+ * @param trie the trie to search
+ * @param name the name to look up
+ * @param size the length of @p name
+ * @param [out] exclusive if not 0, set to 0 if there is a backend below @p name
+ */
+static Backend * elektraTriePrefixLookup (Trie * trie, const char * name, size_t size, int * exclusive)
+{
+	Backend * ret = NULL;
+	size_t pos = 0;
+
+	if (size > 0 && name[size - 1] == '/') --size;
 
-	if (ret == NULL && trie->value[idx] == NULL)
+	while (trie != NULL)
 	{
-		return trie->empty_value;
+		if (trie->empty_value) ret = trie->empty_value;
+
+		// bytes left of name + '/'
+		size_t rest = size + 1 - pos;
+		if (rest == 0)
+		{
+			if (exclusive && elektraTrieHasValueBelow (trie)) *exclusive = 0;
+			break;
+		}
+
+		unsigned char idx = pos < size ? (unsigned char) name[pos] : '/';
+		const char * trieText = trie->text[idx];
+		if (trieText == NULL) break;
+
+		size_t textlen = trie->textlen[idx];
+		size_t common = textlen < rest ? textlen : rest;
+		size_t inName = pos + common <= size ? common : size - pos;
+		if (memcmp (name + pos, trieText, inName) != 0 || (inName < common && trieText[inName] != '/')) break;
+
+		if (textlen > rest)
+		{
+			// the text continues after name + '/', so its backends are below name
+			const Trie * child = trie->children[idx];
+			if (exclusive && (trie->value[idx] || (child && (child->empty_value || elektraTrieHasValueBelow (child)))))
+			{
+				*exclusive = 0;
+			}
+			break;
+		}
+
+		if (trie->value[idx]) ret = trie->value[idx];
+		pos += textlen;
+		trie = trie->children[idx];
 	}
-	if (ret == NULL) return trie->value[idx];
 
 	return ret;
 }
@@ -10,6 +10,7 @@
 #include <kdbease.h>
 #include <kdbglobbing.h>
 #include <kdbhelper.h>
+#include <kdbprivate.h>
 
 #include <ctype.h>
 #include <fnmatch.h>
@@ -186,6 +187,63 @@ int elektraKeyGlob (const Key * key, const char * pattern)
 	return rc;
 }
 
+/**
+ * @brief finds the Key below which all matches of a globbing pattern are
+ *
+ * The name of the returned Key consists of the key name parts of @p pattern
+ * before the first part that contains a wildcard or is one of "#", "_" and "__".
+ *
+ * @param pattern the globbing pattern
+ * @return a new Key, which has to be deleted with keyDel(), or NULL if the namespace
+ *         of @p pattern is not literal or the prefix is no canonical key name
+ */
+static Key * elektraGlobPrefix (const char * pattern)
+{
+	const char * special = pattern + strcspn (pattern, "*?[\\");
+	const char * root = strchr (pattern, '/');
+	if (root == NULL || root > special)
+	{
+		return NULL;
+	}
+
+	const char * prefixEnd = root + 1;
+	const char * part = root + 1;
+	while (*part != '\0')
+	{
+		const char * partEnd = strchr (part, '/');
+		if (partEnd == NULL)
+		{
+			partEnd = part + strlen (part);
+		}
+
+		size_t partLen = partEnd - part;
+		if (partEnd > special || (partLen == 1 && (*part == '#' || *part == '_')) || (partLen == 2 && strncmp (part, "__", 2) == 0))
+		{
+			break;
+		}
+
+		prefixEnd = partEnd;
+		part = *partEnd == '\0' ? partEnd : partEnd + 1;
+	}
+
+	size_t nameLen = prefixEnd - pattern;
+	char * name = elektraStrNDup (pattern, nameLen + 1);
+	if (name == NULL)
+	{
+		return NULL;
+	}
+	name[nameLen] = '\0';
+	Key * prefix = keyNew (name, KEY_END);
+	if (prefix != NULL && strcmp (keyName (prefix), name) != 0)
+	{
+		// e.g. "user:/a/../b" would not find "user:/a/../b/*"
+		keyDel (prefix);
+		prefix = NULL;
+	}
+	elektraFree (name);
+	return prefix;
+}
+
 /**
  * @brief filters a given KeySet by applying a globbing pattern
  *
@@ -206,12 +264,20 @@ int elektraKsGlob (KeySet * result, KeySet * input, const char * pattern)
 	if (!pattern) return ELEKTRA_GLOB_NOMATCH;
 
 	int ret = 0;
-	Key * current;
 
-	elektraCursor cursor = ksGetCursor (input);
-	ksRewind (input);
-	while ((current = ksNext (input)) != 0)
+	// only keys below the literal prefix of the pattern can match
+	elektraCursor start = 0;
+	elektraCursor end = ksGetSize (input);
+	Key * prefix = elektraGlobPrefix (pattern);
+	if (prefix != NULL)
+	{
+		start = ksFindHierarchy (input, prefix, &end);
+		keyDel (prefix);
+	}
+
+	for (elektraCursor it = start; it < end; ++it)
 	{
+		Key * current = ksAtCursor (input, it);
 		int rc = elektraKeyGlob (current, pattern);
 		if (rc == 0)
 		{
@@ -219,6 +285,5 @@ int elektraKsGlob (KeySet * result, KeySet * input, const char * pattern)
 			ksAppendKey (result, keyDup (current));
 		}
 	}
-	ksSetCursor (input, cursor);
 	return ret;
 }
@@ -14,6 +14,7 @@
 #include "kdblogger.h"
 #include "kdbprivate.h"
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -174,6 +175,7 @@ Elektra * elektraOpen (const char * application, KeySet * defaults, KeySet * con
 	elektra->lookupKey = keyNew ("/", KEY_END);
 	elektra->fatalErrorHandler = &defaultFatalErrorHandler;
 	elektra->defaults = ksDup (defaults);
+	elektra->generation = 1;
 
 	return elektra;
 }
@@ -253,6 +255,15 @@ void elektraClose (Elektra * elektra)
 		ksDel (elektra->defaults);
 	}
 
+	if (elektra->keyCache != NULL)
+	{
+		for (size_t i = 0; i < ELEKTRA_KEY_CACHE_SIZE; ++i)
+		{
+			elektraFree (elektra->keyCache[i].name);
+		}
+		elektraFree (elektra->keyCache);
+	}
+
 	elektraFree (elektra);
 }
 
@@ -291,8 +302,99 @@ void elektraSetArrayLookupKey (Elektra * elektra, const char * name, kdb_long_lo
 	keyAddName (elektra->lookupKey, arrayPart);
 }
 
+/**
+ * Hash of a relative name and an array index for the key cache.
+ */
+static size_t elektraKeyCacheHash (const char * name, kdb_long_long_t index)
+{
+	// FNV-1a
+	size_t hash = 2166136261u;
+	for (const unsigned char * c = (const unsigned char *) name; *c != '\0'; ++c)
+	{
+		hash = (hash ^ *c) * 16777619u;
+	}
+	hash = (hash ^ (size_t) index) * 16777619u;
+	return hash ^ (hash >> 15);
+}
+
+/**
+ * Finds a Key from its relative name and checks its type metadata, if @p type is not NULL.
+ *
+ * The resolved Key and the checked type are cached per name. As long as the configuration
+ * of @p elektra does not change, a repeated call with the same name only compares the name
+ * and does not build the lookup key or search the KeySet again.
+ *
+ * @param elektra The Elektra instance to use.
+ * @param name    The relative name of the key.
+ * @param index   The index of the array element or -1, if the key is no array element.
+ * @param type    The expected type metadata value.
+ * @return the Key referenced by @p name or NULL, if a fatal error occurs and the fatal error handler returns to this function
+ */
+Key * elektraFindCachedKey (Elektra * elektra, const char * name, kdb_long_long_t index, KDBType type)
+{
+	if (elektra->keyCache == NULL)
+	{
+		elektra->keyCache = elektraCalloc (ELEKTRA_KEY_CACHE_SIZE * sizeof (ElektraCachedKey));
+	}
+
+	ElektraCachedKey * entry = NULL;
+	if (elektra->keyCache != NULL)
+	{
+		entry = &elektra->keyCache[elektraKeyCacheHash (name, index) & (ELEKTRA_KEY_CACHE_SIZE - 1)];
+		if (entry->generation == elektra->generation && entry->index == index && strcmp (entry->name, name) == 0 &&
+		    (type == NULL || type == entry->type))
+		{
+			return entry->key;
+		}
+	}
+
+	if (index < 0)
+	{
+		elektraSetLookupKey (elektra, name);
+	}
+	else
+	{
+		elektraSetArrayLookupKey (elektra, name, index);
+	}
+
+	Key * const resultKey = ksLookup (elektra->config, elektra->lookupKey, 0);
+	if (resultKey == NULL)
+	{
+		elektraFatalError (elektra, elektraErrorKeyNotFound (keyName (elektra->lookupKey)));
+		return NULL;
+	}
+
+	if (type != NULL)
+	{
+		const char * actualType = keyString (keyGetMeta (resultKey, "type"));
+		if (strcmp (actualType, type) != 0)
+		{
+			elektraFatalError (elektra, elektraErrorWrongType (keyName (elektra->lookupKey), type, actualType));
+			return NULL;
+		}
+	}
+
+	if (entry != NULL)
+	{
+		if (entry->name == NULL || strcmp (entry->name, name) != 0)
+		{
+			elektraFree (entry->name);
+			entry->name = elektraStrDup (name);
+		}
+		entry->index = index;
+		entry->generation = entry->name != NULL ? elektra->generation : 0;
+		entry->type = type;
+		entry->key = resultKey;
+	}
+
+	return resultKey;
+}
+
 void elektraSaveKey (Elektra * elektra, Key * key, ElektraError ** error)
 {
+	// the Keys in the cache may be replaced
+	++elektra->generation;
+
 	int ret = 0;
 	do
 	{
@@ -101,25 +101,7 @@ kdb_long_long_t elektraArraySize (Elektra * elektra, const char * name)
  */
 Key * elektraFindArrayElementKey (Elektra * elektra, const char * name, kdb_long_long_t index, KDBType type)
 {
-	elektraSetArrayLookupKey (elektra, name, index);
-	Key * const resultKey = ksLookup (elektra->config, elektra->lookupKey, 0);
-	if (resultKey == NULL)
-	{
-		elektraFatalError (elektra, elektraErrorKeyNotFound (keyName (elektra->lookupKey)));
-		return NULL;
-	}
-
-	if (type != NULL)
-	{
-		const char * actualType = keyString (keyGetMeta (resultKey, "type"));
-		if (strcmp (actualType, type) != 0)
-		{
-			elektraFatalError (elektra, elektraErrorWrongType (keyName (elektra->lookupKey), type, actualType));
-			return NULL;
-		}
-	}
-
-	return resultKey;
+	return elektraFindCachedKey (elektra, name, index, type);
 }
 
 /**
@@ -184,7 +166,6 @@ const char * elektraFindReferenceArrayElement (Elektra * elektra, const char * n
  */
 KDBType elektraGetArrayElementType (Elektra * elektra, const char * keyname, kdb_long_long_t index)
 {
-	elektraSetArrayLookupKey (elektra, keyname, index);
 	const Key * key = elektraFindArrayElementKey (elektra, keyname, index, NULL);
 	const Key * metaKey = keyGetMeta (key, "type");
 	return metaKey == NULL ? NULL : keyString (metaKey);
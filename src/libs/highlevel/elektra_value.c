@@ -44,25 +44,7 @@ extern "C" {
  */
 Key * elektraFindKey (Elektra * elektra, const char * name, KDBType type)
 {
-	elektraSetLookupKey (elektra, name);
-	Key * const resultKey = ksLookup (elektra->config, elektra->lookupKey, 0);
-	if (resultKey == NULL)
-	{
-		elektraFatalError (elektra, elektraErrorKeyNotFound (keyName (elektra->lookupKey)));
-		return NULL;
-	}
-
-	if (type != NULL)
-	{
-		const char * actualType = keyString (keyGetMeta (resultKey, "type"));
-		if (strcmp (actualType, type) != 0)
-		{
-			elektraFatalError (elektra, elektraErrorWrongType (keyName (elektra->lookupKey), type, actualType));
-			return NULL;
-		}
-	}
-
-	return resultKey;
+	return elektraFindCachedKey (elektra, name, -1, type);
 }
 
 /**
@@ -125,7 +107,6 @@ const char * elektraFindReference (Elektra * elektra, const char * name)
  */
 KDBType elektraGetType (Elektra * elektra, const char * keyname)
 {
-	elektraSetLookupKey (elektra, keyname);
 	const Key * key = elektraFindKey (elektra, keyname, NULL);
 	const Key * metaKey = keyGetMeta (key, "type");
 	return metaKey == NULL ? NULL : keyString (metaKey);
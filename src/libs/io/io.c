@@ -7,6 +7,7 @@
  *
  */
 
+#include <kdbconfig.h>
 #include <kdbhelper.h>
 #include <kdbinvoke.h>
 #include <kdbio.h>
@@ -17,10 +18,26 @@
 
 #include <stdio.h>
 
+#ifdef HAVE_SYS_INOTIFY_H
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static void elektraIoWatchSetBinding (ElektraWatch * watch, ElektraIoInterface * ioBinding);
+
 void elektraIoSetBinding (KDB * kdb, ElektraIoInterface * ioBinding)
 {
 	kdb->ioBinding = ioBinding;
 
+	if (kdb->watch)
+	{
+		elektraIoWatchSetBinding (kdb->watch, ioBinding);
+	}
+
 	KeySet * parameters =
 		ksNew (1, keyNew ("/ioBinding", KEY_BINARY, KEY_SIZE, sizeof (ioBinding), KEY_VALUE, &ioBinding, KEY_END), KS_END);
 
@@ -699,3 +716,344 @@ ElektraIoIdleCallback elektraIoIdleGetCallback (ElektraIoIdleOperation * idleOp)
 
 	return idleOp->callback;
 }
+
+// ################################
+// # Change tracking
+// ################################
+
+#ifdef HAVE_SYS_INOTIFY_H
+
+#define ELEKTRA_IO_WATCH_MASK                                                                                                              \
+	(IN_MODIFY | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR)
+
+/**
+ * A resolved file of a backend, which is tracked by the watch.
+ */
+typedef struct
+{
+	Backend * backend;     /**<Backend of the file */
+	elektraNamespace ns;   /**<Namespace of the file */
+	char * filename;   /**<The resolved file */
+	const char * name; /**<Points into filename, to the path component the watched directory contains */
+	size_t nameLen;	   /**<Length of the path component */
+	int wd;		   /**<Watch descriptor of the watched directory, -1 if not watched */
+} WatchEntry;
+
+/**
+ * Change tracking of the resolved files of a KDB instance with inotify.
+ *
+ * The directories of all files are watched, because storage plugins
+ * usually replace files instead of writing to them. If a directory does
+ * not exist, its nearest existing ancestor is watched instead.
+ * Every entry has a dirty bit, which is set whenever an event for its
+ * file arrives and cleared after the resolver checked the file again.
+ */
+typedef struct
+{
+	ElektraWatch watch; /**<Callbacks for kdbGet(), must be the first member */
+
+	int fd;			     /**<inotify file descriptor */
+	ElektraIoFdOperation * fdOp; /**<Operation for fd, if an I/O binding is set */
+
+	WatchEntry * entries; /**<All tracked files */
+	size_t size;	      /**<Number of entries */
+	size_t alloc;	      /**<Allocated number of entries, a multiple of 64 */
+	uint64_t * dirty;     /**<Dirty bit of every entry */
+	size_t hint;	      /**<Index after the last entry found, the split usually has the same order every time */
+} Watch;
+
+static int watchIsDirty (Watch * w, size_t i)
+{
+	return (w->dirty[i / 64] >> (i % 64)) & 1;
+}
+
+static void watchSetDirty (Watch * w, size_t i, int dirty)
+{
+	if (dirty)
+	{
+		w->dirty[i / 64] |= (uint64_t) 1 << (i % 64);
+	}
+	else
+	{
+		w->dirty[i / 64] &= ~((uint64_t) 1 << (i % 64));
+	}
+}
+
+/**
+ * @brief Find the entry of a backend and namespace.
+ *
+ * @return the index of the entry or -1 if there is none
+ */
+static ssize_t watchFind (Watch * w, Backend * backend, elektraNamespace ns)
+{
+	for (size_t n = 0; n < w->size; ++n)
+	{
+		size_t i = (w->hint + n) % w->size;
+		if (w->entries[i].backend == backend && w->entries[i].ns == ns)
+		{
+			w->hint = i + 1;
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+ * @brief Start watching the directory of an entry.
+ *
+ * If the directory does not exist, the nearest existing ancestor is watched.
+ * Symlinked files are not watched, as their targets might be in another directory.
+ */
+static void watchAddDirectory (Watch * w, WatchEntry * entry)
+{
+	struct stat buf;
+	entry->wd = -1;
+	if (lstat (entry->filename, &buf) == 0 && S_ISLNK (buf.st_mode))
+	{
+		return;
+	}
+
+	char * dirname = elektraStrDup (entry->filename);
+	char * slash;
+	while ((slash = strrchr (dirname, '/')) != NULL)
+	{
+		entry->name = entry->filename + (slash - dirname) + 1;
+		entry->nameLen = strlen (slash + 1);
+		slash[slash == dirname ? 1 : 0] = '\0';
+
+		entry->wd = inotify_add_watch (w->fd, dirname, ELEKTRA_IO_WATCH_MASK);
+		if (entry->wd >= 0 || (errno != ENOENT && errno != ENOTDIR) || slash == dirname) break;
+	}
+	ELEKTRA_LOG_DEBUG ("watch %s for %s: %d", dirname, entry->filename, entry->wd);
+	elektraFree (dirname);
+}
+
+/**
+ * @brief Read all pending events and mark the affected entries as dirty.
+ */
+static void watchReadEvents (Watch * w)
+{
+	char buf[4096] __attribute__ ((aligned (__alignof__ (struct inotify_event))));
+	ssize_t len;
+	while ((len = read (w->fd, buf, sizeof (buf))) > 0)
+	{
+		for (char * p = buf; p < buf + len; p += sizeof (struct inotify_event) + ((struct inotify_event *) p)->len)
+		{
+			const struct inotify_event * event = (const struct inotify_event *) p;
+			for (size_t i = 0; i < w->size; ++i)
+			{
+				WatchEntry * entry = &w->entries[i];
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					watchSetDirty (w, i, 1);
+				}
+				else if (entry->wd == event->wd)
+				{
+					// events without name concern the directory itself
+					if (event->len == 0 ||
+					    (strlen (event->name) == entry->nameLen && strncmp (event->name, entry->name, entry->nameLen) == 0))
+					{
+						watchSetDirty (w, i, 1);
+					}
+					if (event->mask & IN_IGNORED)
+					{
+						entry->wd = -1;
+					}
+				}
+			}
+		}
+	}
+}
+
+static void watchRefresh (ElektraWatch * watch)
+{
+	Watch * w = (Watch *) watch;
+	// with an I/O binding the events are read as soon as they arrive
+	if (!w->fdOp)
+	{
+		int errnoSave = errno;
+		watchReadEvents (w);
+		errno = errnoSave;
+	}
+}
+
+static int watchIsClean (ElektraWatch * watch, Backend * backend, Key * parentKey)
+{
+	Watch * w = (Watch *) watch;
+	ssize_t i = watchFind (w, backend, keyGetNamespace (parentKey));
+	if (i < 0 || w->entries[i].wd < 0 || watchIsDirty (w, i))
+	{
+		return 0;
+	}
+
+	keySetString (parentKey, w->entries[i].filename);
+	return 1;
+}
+
+static void watchChecked (ElektraWatch * watch, Backend * backend, Key * parentKey)
+{
+	Watch * w = (Watch *) watch;
+	const char * filename = keyString (parentKey);
+	if (filename[0] != '/') return;
+
+	int errnoSave = errno;
+	ssize_t i = watchFind (w, backend, keyGetNamespace (parentKey));
+	if (i >= 0 && strcmp (w->entries[i].filename, filename) == 0)
+	{
+		WatchEntry * entry = &w->entries[i];
+		int wd = entry->wd;
+		const char * name = entry->name;
+		if (wd < 0 || name[entry->nameLen] != '\0')
+		{
+			// no watch or only the one of an ancestor, try to watch the directory of the file
+			watchAddDirectory (w, entry);
+		}
+
+		// if the same watch existed before the resolver checked the file, no change was missed,
+		// otherwise check the file next time again
+		if (wd >= 0 && entry->wd == wd && entry->name == name)
+		{
+			watchSetDirty (w, i, 0);
+		}
+		errno = errnoSave;
+		return;
+	}
+
+	if (i < 0)
+	{
+		if (w->size == w->alloc)
+		{
+			size_t alloc = w->alloc + 64;
+			if (elektraRealloc ((void **) &w->entries, alloc * sizeof (WatchEntry)) == -1 ||
+			    elektraRealloc ((void **) &w->dirty, alloc / 64 * sizeof (uint64_t)) == -1)
+			{
+				errno = errnoSave;
+				return;
+			}
+			w->alloc = alloc;
+		}
+		i = w->size++;
+		w->entries[i].backend = backend;
+		w->entries[i].ns = keyGetNamespace (parentKey);
+	}
+	else
+	{
+		elektraFree (w->entries[i].filename);
+	}
+
+	WatchEntry * entry = &w->entries[i];
+	entry->filename = elektraStrDup (filename);
+	watchAddDirectory (w, entry);
+	watchSetDirty (w, i, 1);
+	errno = errnoSave;
+}
+
+static void watchFdCallback (ElektraIoFdOperation * fdOp, int flags ELEKTRA_UNUSED)
+{
+	watchReadEvents (elektraIoFdGetData (fdOp));
+}
+
+static void elektraIoWatchSetBinding (ElektraWatch * watch, ElektraIoInterface * ioBinding)
+{
+	Watch * w = (Watch *) watch;
+	if (w->fdOp)
+	{
+		elektraIoBindingRemoveFd (w->fdOp);
+		elektraFree (w->fdOp);
+		w->fdOp = NULL;
+		// events might have been missed in between
+		watchReadEvents (w);
+	}
+
+	if (!ioBinding) return;
+
+	w->fdOp = elektraIoNewFdOperation (w->fd, ELEKTRA_IO_READABLE, 1, watchFdCallback, w);
+	if (w->fdOp && !elektraIoBindingAddFd (ioBinding, w->fdOp))
+	{
+		ELEKTRA_LOG_WARNING ("could not add inotify file descriptor to I/O binding");
+		elektraFree (w->fdOp);
+		w->fdOp = NULL;
+	}
+}
+
+static void watchClose (ElektraWatch * watch)
+{
+	Watch * w = (Watch *) watch;
+	if (w->fdOp)
+	{
+		elektraIoBindingRemoveFd (w->fdOp);
+		elektraFree (w->fdOp);
+	}
+	close (w->fd);
+	for (size_t i = 0; i < w->size; ++i)
+	{
+		elektraFree (w->entries[i].filename);
+	}
+	elektraFree (w->entries);
+	elektraFree (w->dirty);
+	elektraFree (w);
+}
+
+int elektraIoWatchEnable (KDB * kdb)
+{
+	if (kdb == NULL)
+	{
+		ELEKTRA_LOG_WARNING ("kdb cannot be NULL");
+		return 0;
+	}
+	if (kdb->watch) return 1;
+
+	int fd = inotify_init1 (IN_NONBLOCK | IN_CLOEXEC);
+	if (fd == -1)
+	{
+		ELEKTRA_LOG_WARNING ("inotify_init1 failed: %s", strerror (errno));
+		return 0;
+	}
+
+	Watch * w = elektraCalloc (sizeof (Watch));
+	if (!w)
+	{
+		close (fd);
+		return 0;
+	}
+	w->watch.refresh = watchRefresh;
+	w->watch.isClean = watchIsClean;
+	w->watch.checked = watchChecked;
+	w->watch.close = watchClose;
+	w->fd = fd;
+
+	if (kdb->ioBinding)
+	{
+		elektraIoWatchSetBinding (&w->watch, kdb->ioBinding);
+	}
+
+	kdb->watch = &w->watch;
+	return 1;
+}
+
+#else
+
+static void elektraIoWatchSetBinding (ElektraWatch * watch ELEKTRA_UNUSED, ElektraIoInterface * ioBinding ELEKTRA_UNUSED)
+{
+}
+
+int elektraIoWatchEnable (KDB * kdb ELEKTRA_UNUSED)
+{
+	ELEKTRA_LOG_WARNING ("change tracking is not supported on this system");
+	return 0;
+}
+
+#endif
+
+void elektraIoWatchDisable (KDB * kdb)
+{
+	if (kdb == NULL)
+	{
+		ELEKTRA_LOG_WARNING ("kdb cannot be NULL");
+		return;
+	}
+	if (!kdb->watch) return;
+
+	kdb->watch->close (kdb->watch);
+	kdb->watch = NULL;
+}
@@ -41,6 +41,18 @@
  * @c ELEKTRA_PLUGIN_ERROR and
  * @c ELEKTRA_PLUGIN_COMMIT.
  *
+ * Plugins can pass @c ELEKTRA_PLUGIN_THREADSAFE followed by a non-zero
+ * int to declare that their kdbGet() may be called concurrently
+ * (also on the same plugin instance) with different keysets and parent keys.
+ * Such a kdbGet() must not use the global keyset or unsynchronized static state.
+ *
+ * Resolvers can pass @c ELEKTRA_PLUGIN_CHECKUPDATE followed by a function
+ * that checks the files of several backends for updates at once.
+ * It is called with arrays of plugin handles (all exporting the same function),
+ * keysets and parent keys and must store in @c results what kdbGet() would
+ * have returned for every entry. Like kdbGet() it stores the resolved file name
+ * in every parent key. Errors and warnings are added to @c errorKey.
+ *
  * The list is terminated with
  * @c ELEKTRA_PLUGIN_END.
  *
@@ -88,6 +100,12 @@ Plugin * elektraPluginExport (const char * pluginName, ...)
 		case ELEKTRA_PLUGIN_COMMIT:
 			returned->kdbCommit = va_arg (va, kdbCommitPtr);
 			break;
+		case ELEKTRA_PLUGIN_THREADSAFE:
+			returned->threadsafe = va_arg (va, int);
+			break;
+		case ELEKTRA_PLUGIN_CHECKUPDATE:
+			returned->kdbCheckUpdate = va_arg (va, kdbCheckUpdatePtr);
+			break;
 		default:
 			ELEKTRA_ASSERT (0, "plugin passed something unexpected");
 		// fallthrough, will end here
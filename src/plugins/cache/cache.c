@@ -21,6 +21,7 @@
 #include <kdbmodule.h>
 #include <kdbprivate.h>
 
+#include <errno.h>     // errno
 #include <fcntl.h>     // access()
 #include <ftw.h>       // nftw()
 #include <stdint.h>    // nftw()
@@ -33,6 +34,7 @@
 #include <unistd.h>    // access()
 
 #define KDB_CACHE_STORAGE "mmapstorage"
+#define KDB_CACHE_SHM_DIR "/dev/shm"
 #define POSTFIX_SIZE 50
 #define MAX_FD_USED 32
 
@@ -61,13 +63,47 @@ static char * elektraStrConcat (const char * a, const char * b)
 	return ret;
 }
 
+/**
+ * @brief Creates the cache directory of the current user in shared memory.
+ *
+ * Files in shared memory never touch the disk and their pages are shared by all
+ * processes mapping them. The directory is only used, if it is owned by the current
+ * user and not accessible by anyone else.
+ *
+ * @return the newly allocated path of the directory
+ * @retval 0 if there is no shared memory or the directory is not safe to use
+ */
+static char * sharedCacheDirectory (void)
+{
+	struct stat sb;
+	if (stat (KDB_CACHE_SHM_DIR, &sb) != 0 || !S_ISDIR (sb.st_mode)) return 0;
+
+	char * cacheDir = elektraFormat ("%s/elektra-%ld", KDB_CACHE_SHM_DIR, (long) getuid ());
+	if ((mkdir (cacheDir, S_IRWXU) != 0 && errno != EEXIST) || lstat (cacheDir, &sb) != 0 || !S_ISDIR (sb.st_mode) ||
+	    sb.st_uid != getuid () || (sb.st_mode & (S_IRWXG | S_IRWXO)) != 0)
+	{
+		ELEKTRA_LOG_WARNING ("can not use shared memory cache directory %s", cacheDir);
+		elektraFree (cacheDir);
+		return 0;
+	}
+	return cacheDir;
+}
+
 static int resolveCacheDirectory (Plugin * handle, CacheHandle * ch, Key * errorKey)
 {
 	KeySet * resolverConfig;
-	char * cacheDir = getenv ("XDG_CACHE_HOME");
+	char * cacheDir = 0;
+	if (!elektraStrCmp (keyString (ksLookupByName (elektraPluginGetConfig (handle), "/shared", 0)), "1"))
+	{
+		cacheDir = sharedCacheDirectory ();
+	}
+	if (!cacheDir && getenv ("XDG_CACHE_HOME"))
+	{
+		cacheDir = elektraStrConcat (getenv ("XDG_CACHE_HOME"), "/elektra");
+	}
+
 	if (cacheDir)
 	{
-		cacheDir = elektraStrConcat (cacheDir, "/elektra");
 		ch->cachePath = keyNew ("system:/elektracache", KEY_END);
 		resolverConfig = ksNew (5, keyNew ("system:/path", KEY_VALUE, cacheDir, KEY_END), KS_END);
 		elektraFree (cacheDir);
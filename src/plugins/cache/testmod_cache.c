@@ -9,6 +9,8 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <kdb.h>
 #include <kdbconfig.h>
@@ -36,6 +38,58 @@ static void test_basics (void)
 	PLUGIN_CLOSE ();
 }
 
+static void test_shared (void)
+{
+	printf ("test shared\n");
+
+	struct stat sb;
+	if (stat ("/dev/shm", &sb) != 0)
+	{
+		printf ("no shared memory, skipping test\n");
+		return;
+	}
+
+	Key * parentKey = keyNew ("user:/tests/cache", KEY_END);
+	KeySet * conf = ksNew (1, keyNew ("system:/shared", KEY_VALUE, "1", KEY_END), KS_END);
+	PLUGIN_OPEN ("cache");
+
+	char * cacheDir = elektraFormat ("/dev/shm/elektra-%ld", (long) getuid ());
+	succeed_if (lstat (cacheDir, &sb) == 0 && S_ISDIR (sb.st_mode), "cache directory in shared memory was not created");
+	succeed_if ((sb.st_mode & (S_IRWXG | S_IRWXO)) == 0, "cache directory in shared memory is accessible by others");
+
+	KeySet * ks = ksNew (0, KS_END);
+	succeed_if (plugin->kdbGet (plugin, ks, parentKey) == ELEKTRA_PLUGIN_STATUS_ERROR,
+		    "call to kdbGet was successful, but file should not exist yet");
+
+	// the cache is only written with a global keyset
+	plugin->global = ksNew (0, KS_END);
+	KeySet * cached = ksNew (2, keyNew ("user:/tests/cache/a", KEY_VALUE, "a", KEY_END),
+				 keyNew ("user:/tests/cache/b", KEY_VALUE, "b", KEY_END), KS_END);
+	succeed_if (plugin->kdbSet (plugin, cached, parentKey) == ELEKTRA_PLUGIN_STATUS_SUCCESS, "call to kdbSet was not successful");
+
+	char * cacheFile = elektraFormat ("%s/backenduser:/tests/cache/cache.mmap", cacheDir);
+	succeed_if (stat (cacheFile, &sb) == 0, "cache file was not written to shared memory");
+
+	succeed_if (plugin->kdbGet (plugin, ks, parentKey) == ELEKTRA_PLUGIN_STATUS_SUCCESS, "call to kdbGet was not successful");
+	compare_keyset (ks, cached);
+
+	// same request as sent by kdb cache clear
+	KeySet * cleared = ksNew (0, KS_END);
+	keySetMeta (parentKey, "cache/clear", "1");
+	succeed_if (plugin->kdbGet (plugin, cleared, parentKey) == ELEKTRA_PLUGIN_STATUS_SUCCESS, "call to kdbGet was not successful");
+	succeed_if (stat (cacheFile, &sb) != 0, "cache file in shared memory was not removed");
+	succeed_if (ksGetSize (cleared) == 0, "clearing the cache returned keys");
+
+	elektraFree (cacheFile);
+	elektraFree (cacheDir);
+	keyDel (parentKey);
+	ksDel (ks);
+	ksDel (cached);
+	ksDel (cleared);
+	ksDel (plugin->global);
+	PLUGIN_CLOSE ();
+}
+
 static void test_cacheNonBackendKeys (void)
 {
 	KeySet * conf = ksNew (0, KS_END);
@@ -72,6 +126,7 @@ int main (int argc, char ** argv)
 	init (argc, argv);
 
 	test_basics ();
+	test_shared ();
 	test_cacheNonBackendKeys ();
 
 	print_result ("testmod_cache");
@@ -58,6 +58,92 @@ typedef enum
 	NOEXPR = -3,
 } CondResult;
 
+/**
+ * An operand of a single condition, resolved when the condition is compiled
+ */
+typedef struct
+{
+	int invalid;	 /*!< a literal without closing quote */
+	char * literal;	 /*!< the value of a literal enclosed by '' */
+	char * name;	 /*!< the name of the referenced key */
+	Key * reference; /*!< a key with this name for lookups, NULL if the name is invalid */
+} Operand;
+
+/**
+ * Part of a condition, into which the results of nested conditions are filled in
+ */
+typedef struct
+{
+	char * text;
+	size_t * positions; /*!< positions of the results in text */
+	size_t * sources;   /*!< steps with these results */
+	size_t size;
+} Template;
+
+/**
+ * A condition without nested parentheses
+ */
+typedef struct
+{
+	int valid; /*!< the condition has a comparator */
+	Comparator cmpOp;
+	Template condition;
+	Template leftSide;
+	Template rightSide;
+	Operand left;	   /*!< resolved, if leftSide does not contain results */
+	Operand right;	   /*!< resolved, if rightSide does not contain results */
+	CondResult result; /*!< result of the last evaluation */
+} ConditionStep;
+
+/**
+ * The conditions within the parentheses of an expression, innermost first
+ */
+typedef struct
+{
+	ConditionStep * steps;
+	size_t size;
+	int invalid;
+} ConditionExpression;
+
+typedef struct
+{
+	int invalid;	 /*!< the syntax of the assignment is invalid */
+	char * value;	 /*!< the value of a literal */
+	Key * reference; /*!< the key whose value is assigned */
+} ConditionAssign;
+
+/**
+ * A condition compiled for a key and its parent
+ */
+typedef struct
+{
+	char * source;
+	char * parentName;
+	Operation op;
+	int invalid; /*!< the syntax of source is invalid */
+	char * condition;
+	char * thenexpr;
+	char * elseexpr;
+	ConditionExpression conditionExpr;
+	ConditionExpression thenExpr;
+	ConditionExpression elseExpr;
+	ConditionAssign thenAssign;
+	ConditionAssign elseAssign;
+	int thenCompiled; /*!< thenExpr or thenAssign is compiled */
+	int elseCompiled; /*!< elseExpr or elseAssign is compiled */
+} ConditionProgram;
+
+typedef struct
+{
+	regex_t group;	   /*!< a condition without nested parentheses */
+	regex_t condition; /*!< the condition before ? */
+	regex_t thenExpr;  /*!< the expression after ? */
+	regex_t elseExpr;  /*!< the expression after : */
+	KeySet * programs; /*!< programs used by the current call, a pointer to the program is the binary value */
+	KeySet * previous; /*!< programs used by the previous call, they are freed if they are not used again */
+	Key * lookup;
+} ConditionalsData;
+
 static int isValidSuffix (char * suffix, const Key * suffixList)
 {
 	if (!suffixList) return 0;
@@ -186,98 +272,72 @@ static int compareStrings (const char * s1, const char * s2, const Key * suffixL
 	return retval;
 }
 
-static CondResult evalCondition (const Key * curKey, const char * leftSide, Comparator cmpOp, const char * rightSide,
-				 const char * condition, const Key * suffixList, KeySet * ks, Key * parentKey)
+static void resolveOperand (Operand * operand, const char * side, int rightSide, const Key * curKey, const Key * parentKey)
 {
-	char * lookupName = NULL;
-	char * compareTo = NULL;
-	Key * key;
-	int len;
-	long result = 0;
-	if (rightSide)
+	memset (operand, 0, sizeof (Operand));
+	if (!side) return;
+	if (rightSide && side[0] == '\'')
 	{
-		if (rightSide[0] == '\'')
+		// right side of the statement is a literal enclosed by ''
+		const char * endPos = strchr (side + 1, '\'');
+		if (!endPos)
 		{
-			// right side of the statement is a literal enclosed by ''
-			char * endPos = strchr (rightSide + 1, '\'');
-			if (!endPos)
-			{
-				result = ERROR;
-				goto Cleanup;
-			}
-			if (elektraRealloc ((void **) &compareTo, (size_t) (endPos - rightSide)) < 0)
-			{
-				ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey);
-				result = ERROR;
-				goto Cleanup;
-			}
-			memset (compareTo, 0, (size_t) (endPos - rightSide));
-			strncat (compareTo, rightSide + 1, (size_t) (endPos - rightSide - 1));
+			operand->invalid = 1;
+			return;
 		}
-		else if (rightSide && elektraStrLen (rightSide) > 1)
-		{
-			// not a literal, it has to be a key
-			if (rightSide[0] == '@')
-				len = (int) ((size_t) keyGetNameSize (parentKey) + elektraStrLen (rightSide));
-			else if (!strncmp (rightSide, "..", 2) || (rightSide[0] == '.'))
-				len = (int) ((size_t) keyGetNameSize (curKey) + elektraStrLen (rightSide));
-			else
-				len = (int) elektraStrLen (rightSide);
+		operand->literal = elektraCalloc ((size_t) (endPos - side));
+		strncat (operand->literal, side + 1, (size_t) (endPos - side - 1));
+		return;
+	}
+	if (rightSide && elektraStrLen (side) <= 1) return;
 
-			if (elektraRealloc ((void **) &lookupName, (size_t) len) < 0)
-			{
-				ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey);
-				result = ERROR;
-				goto Cleanup;
-			}
-			if (rightSide[0] == '@')
-				snprintf (lookupName, (size_t) len, "%s/%s", keyName (parentKey), rightSide + 1);
-			else if (rightSide[0] == '.') // either starts with . or .., doesn't matter at this point
-				snprintf (lookupName, (size_t) len, "%s/%s", keyName (curKey), rightSide);
-			else
-				snprintf (lookupName, (size_t) len, "%s", rightSide);
+	// not a literal, it has to be a key
+	if (side[0] == '@')
+		operand->name = elektraFormat ("%s/%s", keyName (parentKey), side + 1);
+	else if (side[0] == '.') // either starts with . or .., doesn't matter at this point
+		operand->name = elektraFormat ("%s/%s", keyName (curKey), side);
+	else
+		operand->name = elektraStrDup (side);
+	operand->reference = keyNew (operand->name, KEY_END);
+}
 
-			key = ksLookupByName (ks, lookupName, 0);
-			if (!key)
-			{
-				if (!keyGetMeta (parentKey, "error"))
-				{
-					ELEKTRA_SET_VALIDATION_SEMANTIC_ERRORF (parentKey,
-										"Key %s not found but is required for the evaluation of %s",
-										lookupName, condition);
-				}
-				result = FALSE;
-				goto Cleanup;
-			}
-			if (elektraRealloc ((void **) &compareTo, (size_t) keyGetValueSize (key)) < 0)
+static void freeOperand (Operand * operand)
+{
+	elektraFree (operand->literal);
+	elektraFree (operand->name);
+	keyDel (operand->reference);
+}
+
+static CondResult evalCondition (const char * leftSide, const Operand * left, Comparator cmpOp, const char * rightSide,
+				 const Operand * right, const char * condition, const Key * suffixList, KeySet * ks, Key * parentKey)
+{
+	char * compareTo = NULL;
+	Key * key;
+	long result = 0;
+	if (right->invalid)
+	{
+		return ERROR;
+	}
+	if (right->literal)
+	{
+		compareTo = elektraStrDup (right->literal);
+	}
+	else if (right->name)
+	{
+		key = ksLookup (ks, right->reference, 0);
+		if (!key)
+		{
+			if (!keyGetMeta (parentKey, "error"))
 			{
-				ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey);
-				result = ERROR;
-				goto Cleanup;
+				ELEKTRA_SET_VALIDATION_SEMANTIC_ERRORF (parentKey,
+									"Key %s not found but is required for the evaluation of %s",
+									right->name, condition);
 			}
-			strcpy (compareTo, keyString (key));
+			return FALSE;
 		}
+		compareTo = elektraStrDup (keyString (key));
 	}
-	if (leftSide[0] == '@')
-		len = (int) ((size_t) keyGetNameSize (parentKey) + elektraStrLen (leftSide));
-	else if (!strncmp (leftSide, "..", 2) || (leftSide[0] == '.'))
-		len = (int) ((size_t) keyGetNameSize (curKey) + elektraStrLen (leftSide));
-	else
-		len = (int) elektraStrLen (leftSide);
-
-	if (elektraRealloc ((void **) &lookupName, (size_t) len) < 0)
-	{
-		ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey);
-		result = ERROR;
-		goto Cleanup;
-	}
-	if (leftSide[0] == '@')
-		snprintf (lookupName, (size_t) len, "%s/%s", keyName (parentKey), leftSide + 1);
-	else if (leftSide[0] == '.') // either . or .., doesn't matter here
-		snprintf (lookupName, (size_t) len, "%s/%s", keyName (curKey), leftSide);
-	else
-		snprintf (lookupName, (size_t) len, "%s", leftSide);
-	key = ksLookupByName (ks, lookupName, 0);
+	key = ksLookup (ks, left->reference, 0);
 	if (cmpOp == NEX)
 	{
 		if (key)
@@ -291,7 +351,7 @@ static CondResult evalCondition (const Key * curKey, const char * leftSide, Comp
 		if (!keyGetMeta (parentKey, "error"))
 		{
 			ELEKTRA_SET_VALIDATION_SEMANTIC_ERRORF (parentKey, "Key %s not found but is required for the evaluation of %s",
-								lookupName, condition);
+								left->name, condition);
 		}
 		result = FALSE;
 		goto Cleanup;
@@ -337,7 +397,6 @@ static CondResult evalCondition (const Key * curKey, const char * leftSide, Comp
 	}
 // freeing allocated heap
 Cleanup:
-	if (lookupName) elektraFree (lookupName);
 	if (compareTo) elektraFree (compareTo);
 	return (CondResult) result;
 }
@@ -402,19 +461,32 @@ static char * condition2cmpOp (const char * condition, Comparator * cmpOp)
 	return opStr;
 }
 
-static CondResult parseSingleCondition (const Key * key, const char * condition, const Key * suffixList, KeySet * ks, Key * parentKey)
+/**
+ * @brief Splits a condition without nested parentheses at its comparator.
+ *
+ * @param condition the condition
+ * @param cmpOp set to the comparator
+ * @param leftSide set to the left side
+ * @param leftOffset set to the position of the left side in @p condition
+ * @param rightSide set to the right side, or NULL if the comparator has none
+ * @param rightOffset set to the position of the right side in @p condition
+ *
+ * @retval 0 on success
+ * @retval -1 if @p condition has no comparator
+ */
+static int splitSingleCondition (const char * condition, Comparator * cmpOp, char ** leftSide, size_t * leftOffset, char ** rightSide,
+				 size_t * rightOffset)
 {
-	Comparator cmpOp;
 	char * opStr;
-	opStr = condition2cmpOp (condition, &cmpOp);
+	opStr = condition2cmpOp (condition, cmpOp);
 
 	if (!opStr)
 	{
-		return ERROR;
+		return -1;
 	}
 
 	size_t opLen;
-	if (cmpOp == LT || cmpOp == GT || cmpOp == NEX)
+	if (*cmpOp == LT || *cmpOp == GT || *cmpOp == NEX)
 	{
 		opLen = 1;
 	}
@@ -435,7 +507,7 @@ static CondResult parseSingleCondition (const Key * key, const char * condition,
 	while (isspace (*ptr))
 	{
 		++ptr;
-		if ((cmpOp == NEX) && (*ptr == '!') && firstNot)
+		if ((*cmpOp == NEX) && (*ptr == '!') && firstNot)
 		{
 			firstNot = 0;
 			++ptr;
@@ -451,15 +523,16 @@ static CondResult parseSingleCondition (const Key * key, const char * condition,
 		++endPos;
 	}
 	int len = (int) ((unsigned long) (opStr - condition) - endPos - startPos + 2);
-	char * leftSide = elektraMalloc ((size_t) len);
-	char * rightSide = NULL;
-	strncpy (leftSide, condition + startPos, (size_t) (len - 2));
-	leftSide[len - 2] = '\0';
+	*leftSide = elektraMalloc ((size_t) len);
+	*leftOffset = startPos;
+	*rightSide = NULL;
+	strncpy (*leftSide, condition + startPos, (size_t) (len - 2));
+	(*leftSide)[len - 2] = '\0';
 	startPos = 0;
 	endPos = 0;
-	if (cmpOp == NEX)
+	if (*cmpOp == NEX)
 	{
-		goto parseSingleEnd;
+		return 0;
 	}
 	ptr = opStr + opLen;
 	while (isspace (*ptr))
@@ -474,323 +547,462 @@ static CondResult parseSingleCondition (const Key * key, const char * condition,
 		++endPos;
 	}
 	len = (int) (elektraStrLen (condition) - (unsigned long) (opStr - condition) - opLen - endPos - startPos);
-	rightSide = elektraMalloc ((size_t) len);
-	strncpy (rightSide, opStr + opLen + startPos, (size_t) (len - 1));
-	rightSide[len - 1] = '\0';
-	CondResult ret;
-
-parseSingleEnd:
-	ret = evalCondition (key, leftSide, cmpOp, rightSide, condition, suffixList, ks, parentKey);
-	if (rightSide) elektraFree (rightSide);
-	elektraFree (leftSide);
-	return ret;
+	*rightSide = elektraMalloc ((size_t) len);
+	*rightOffset = (size_t) (opStr - condition) + opLen + startPos;
+	strncpy (*rightSide, opStr + opLen + startPos, (size_t) (len - 1));
+	(*rightSide)[len - 1] = '\0';
+	return 0;
 }
 
-static const char * isAssign (Key * key, char * expr, Key * parentKey, KeySet * ks)
+/**
+ * @brief Takes @p text and remembers where results of nested conditions are.
+ *
+ * @param sources for every character of @p text, the step whose result it is plus one, or 0
+ */
+static void templateInit (Template * template, char * text, const size_t * sources)
 {
-	char * firstPtr = expr + 1;
-	char * lastPtr = expr + elektraStrLen (expr) - 3;
-	while (isspace (*firstPtr))
-		++firstPtr;
-	while (isspace (*lastPtr))
-		--lastPtr;
-	if (*firstPtr != '\'' || *lastPtr != '\'')
+	size_t length = strlen (text);
+	template->text = text;
+	template->size = 0;
+	template->positions = NULL;
+	template->sources = NULL;
+	for (size_t i = 0; i < length; ++i)
 	{
-		if (lastPtr <= firstPtr)
-		{
-			ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
-				parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information", expr);
-			return NULL;
-		}
-		*(lastPtr + 1) = '\0';
-		Key * lookupKey;
-		if (*firstPtr == '@')
-		{
-			lookupKey = keyDup (parentKey);
-			++firstPtr;
-			keyAddName (lookupKey, firstPtr);
-		}
-		else if (!strncmp (firstPtr, "..", 2) || !strncmp (firstPtr, ".", 1))
-		{
-			lookupKey = keyDup (key);
-			keyAddName (lookupKey, firstPtr);
-		}
-		else
-		{
-			lookupKey = keyNew (firstPtr, KEY_END);
-		}
-		Key * assign = ksLookup (ks, lookupKey, KDB_O_NONE);
-		if (!assign)
-		{
-			ELEKTRA_SET_VALIDATION_SEMANTIC_ERRORF (parentKey, "Key %s not found", keyName (lookupKey));
-			keyDel (lookupKey);
-			return NULL;
-		}
-		else
-		{
-			keyDel (lookupKey);
-			return keyString (assign);
-		}
+		if (sources[i]) ++template->size;
 	}
-	else
+	if (!template->size) return;
+	template->positions = elektraMalloc (template->size * sizeof (size_t));
+	template->sources = elektraMalloc (template->size * sizeof (size_t));
+	for (size_t i = 0, r = 0; i < length; ++i)
 	{
-		if (firstPtr == lastPtr) // only one quote in the assign string, invalid syntax
-		{
-			ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
-				parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information", expr);
-			return NULL;
-		}
-		char * nextMark = strchr (firstPtr + 1, '\'');
-		if (nextMark != lastPtr) // more than two quotes, invalid syntax too
-		{
-			ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
-				parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information", expr);
-			return NULL;
-		}
-		*lastPtr = '\0';
-		*firstPtr = '\0';
-		++firstPtr;
-		return firstPtr;
+		if (!sources[i]) continue;
+		template->positions[r] = i;
+		template->sources[r] = sources[i] - 1;
+		++r;
 	}
 }
 
-static CondResult parseCondition (Key * key, const char * condition, const Key * suffixList, KeySet * ks, Key * parentKey)
+static char * templateFill (const Template * template, const ConditionStep * steps)
 {
-	CondResult result = FALSE;
-	const char * regexString = "((\\(([^\\(\\)]*)\\)))";
-	regex_t regex;
-
-	if ((regcomp (&regex, regexString, REG_EXTENDED | REG_NEWLINE)))
+	char * text = elektraStrDup (template->text);
+	for (size_t i = 0; i < template->size; ++i)
 	{
-		ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey); // the regex compiles so the only
-		// possible error would be out of
-		// memory
-		ksDel (ks);
-		return ERROR;
+		text[template->positions[i]] = (steps[template->sources[i]].result == TRUE) ? '1' : '0';
 	}
+	return text;
+}
 
+static void templateFree (Template * template)
+{
+	elektraFree (template->text);
+	elektraFree (template->positions);
+	elektraFree (template->sources);
+}
+
+/**
+ * @brief Compiles a condition with parentheses into conditions without nested parentheses.
+ *
+ * The innermost parentheses are replaced by the result of their condition, until no parentheses are left.
+ * The position of every result is remembered, the evaluation fills in the actual results.
+ */
+static void compileExpression (ConditionExpression * expr, const char * condition, const regex_t * regex, const Key * curKey,
+			       const Key * parentKey)
+{
+	memset (expr, 0, sizeof (ConditionExpression));
 	char * localCondition = elektraStrDup (condition);
+	size_t * sources = elektraCalloc ((strlen (localCondition) + 2) * sizeof (size_t));
 	size_t subMatches = 4;
 	regmatch_t m[subMatches];
-	char * ptr = localCondition;
 	while (1)
 	{
-		int nomatch = regexec (&regex, ptr, subMatches, m, 0);
+		int nomatch = regexec (regex, localCondition, subMatches, m, 0);
 		if (nomatch)
 		{
 			break;
 		}
 		if (m[3].rm_so == -1)
 		{
-			result = -1;
+			expr->invalid = 1;
 			break;
 		}
-		int startPos;
-		int endPos;
-		startPos = (int) (m[3].rm_so + (ptr - localCondition));
-		endPos = (int) (m[3].rm_eo + (ptr - localCondition));
+		int startPos = (int) m[3].rm_so;
+		int endPos = (int) m[3].rm_eo;
 		char * singleCondition = elektraMalloc ((size_t) (endPos - startPos + 1));
 		strncpy (singleCondition, localCondition + startPos, (size_t) (endPos - startPos));
 		singleCondition[endPos - startPos] = '\0';
-		result = parseSingleCondition (key, singleCondition, suffixList, ks, parentKey);
+
+		elektraRealloc ((void **) &expr->steps, (expr->size + 1) * sizeof (ConditionStep));
+		ConditionStep * step = &expr->steps[expr->size];
+		memset (step, 0, sizeof (ConditionStep));
+		templateInit (&step->condition, singleCondition, sources + startPos);
+
+		char * leftSide;
+		char * rightSide;
+		size_t leftOffset = 0;
+		size_t rightOffset = 0;
+		if (splitSingleCondition (singleCondition, &step->cmpOp, &leftSide, &leftOffset, &rightSide, &rightOffset) == 0)
+		{
+			step->valid = 1;
+			templateInit (&step->leftSide, leftSide, sources + startPos + leftOffset);
+			if (!step->leftSide.size) resolveOperand (&step->left, leftSide, 0, curKey, parentKey);
+			if (rightSide)
+			{
+				templateInit (&step->rightSide, rightSide, sources + startPos + rightOffset);
+				if (!step->rightSide.size) resolveOperand (&step->right, rightSide, 1, curKey, parentKey);
+			}
+		}
+
 		for (int i = startPos - 1; i < endPos + 1; ++i)
+		{
 			localCondition[i] = ' ';
+			sources[i] = 0;
+		}
 		localCondition[startPos - 1] = '\'';
-		localCondition[startPos] = (result == TRUE) ? '1' : '0';
+		localCondition[startPos] = '0';
 		localCondition[startPos + 1] = '\'';
-		elektraFree (singleCondition);
+		sources[startPos] = ++expr->size;
 	}
+	elektraFree (sources);
 	elektraFree (localCondition);
-	regfree (&regex);
+}
+
+static void freeExpression (ConditionExpression * expr)
+{
+	for (size_t i = 0; i < expr->size; ++i)
+	{
+		ConditionStep * step = &expr->steps[i];
+		templateFree (&step->condition);
+		templateFree (&step->leftSide);
+		templateFree (&step->rightSide);
+		freeOperand (&step->left);
+		freeOperand (&step->right);
+	}
+	elektraFree (expr->steps);
+}
+
+static CondResult evalExpression (ConditionExpression * expr, Key * key, const Key * suffixList, KeySet * ks, Key * parentKey)
+{
+	CondResult result = FALSE;
+	for (size_t i = 0; i < expr->size; ++i)
+	{
+		ConditionStep * step = &expr->steps[i];
+		if (!step->valid)
+		{
+			result = step->result = ERROR;
+			continue;
+		}
+
+		// results of nested conditions have to be filled in, before the sides can be resolved
+		char * condition = step->condition.size ? templateFill (&step->condition, expr->steps) : step->condition.text;
+		char * leftSide = step->leftSide.size ? templateFill (&step->leftSide, expr->steps) : step->leftSide.text;
+		char * rightSide = step->rightSide.size ? templateFill (&step->rightSide, expr->steps) : step->rightSide.text;
+		Operand left = step->left;
+		Operand right = step->right;
+		if (step->leftSide.size) resolveOperand (&left, leftSide, 0, key, parentKey);
+		if (step->rightSide.size) resolveOperand (&right, rightSide, 1, key, parentKey);
+
+		result = step->result =
+			evalCondition (leftSide, &left, step->cmpOp, rightSide, &right, condition, suffixList, ks, parentKey);
+
+		if (step->leftSide.size)
+		{
+			freeOperand (&left);
+			elektraFree (leftSide);
+		}
+		if (step->rightSide.size)
+		{
+			freeOperand (&right);
+			elektraFree (rightSide);
+		}
+		if (step->condition.size) elektraFree (condition);
+	}
+	if (expr->invalid) result = ERROR;
 	return result;
 }
 
+static void compileAssign (ConditionAssign * assign, const char * expr, const Key * key, const Key * parentKey)
+{
+	memset (assign, 0, sizeof (ConditionAssign));
+	char * localExpr = elektraStrDup (expr);
+	char * firstPtr = localExpr + 1;
+	char * lastPtr = localExpr + elektraStrLen (localExpr) - 3;
+	while (isspace (*firstPtr))
+		++firstPtr;
+	while (isspace (*lastPtr))
+		--lastPtr;
+	if (*firstPtr != '\'' || *lastPtr != '\'')
+	{
+		if (lastPtr <= firstPtr)
+		{
+			assign->invalid = 1;
+		}
+		else
+		{
+			*(lastPtr + 1) = '\0';
+			if (*firstPtr == '@')
+			{
+				assign->reference = keyNew (keyName (parentKey), KEY_END);
+				keyAddName (assign->reference, firstPtr + 1);
+			}
+			else if (!strncmp (firstPtr, "..", 2) || !strncmp (firstPtr, ".", 1))
+			{
+				assign->reference = keyNew (keyName (key), KEY_END);
+				keyAddName (assign->reference, firstPtr);
+			}
+			else
+			{
+				assign->reference = keyNew (firstPtr, KEY_END);
+			}
+		}
+	}
+	else
+	{
+		// only one quote or more than two quotes in the assign string are invalid
+		char * nextMark = strchr (firstPtr + 1, '\'');
+		if (firstPtr == lastPtr || nextMark != lastPtr)
+		{
+			assign->invalid = 1;
+		}
+		else
+		{
+			*lastPtr = '\0';
+			assign->value = elektraStrDup (firstPtr + 1);
+		}
+	}
+	elektraFree (localExpr);
+}
 
-static CondResult parseConditionString (const Key * meta, const Key * suffixList, Key * parentKey, Key * key, KeySet * ks, Operation op)
+static const char * isAssign (const ConditionAssign * assign, const char * expr, Key * parentKey, KeySet * ks)
 {
-	const char * conditionString = keyString (meta);
-	const char * regexString1 = "(\\(((.*)?)\\))[[:space:]]*\\?";
-	const char * regexString2 = "\\?[[:space:]]*(\\(((.*)?)\\))";
-	const char * regexString3 = "[[:space:]]*:[[:space:]]*(\\(((.*)?)\\))";
-	regex_t regex1, regex2, regex3;
-	CondResult ret;
-	if ((ret = regcomp (&regex1, regexString1, REGEX_FLAGS_CONDITION)))
+	if (assign->invalid)
 	{
-		ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey); // the regex compiles so the only
-		// possible error would be out of
-		// memory
-		ksDel (ks);
-		return ERROR;
+		ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
+			parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information", expr);
+		return NULL;
 	}
-	if ((ret = regcomp (&regex2, regexString2, REGEX_FLAGS_CONDITION)))
+	if (assign->value)
 	{
-		ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey); // the regex compiles so the only
-		// possible error would be out of
-		// memory
-		regfree (&regex1);
-		ksDel (ks);
-		return ERROR;
+		return assign->value;
 	}
-	if ((ret = regcomp (&regex3, regexString3, REGEX_FLAGS_CONDITION)))
+	Key * found = ksLookup (ks, assign->reference, KDB_O_NONE);
+	if (!found)
 	{
-		ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey); // the regex compiles so the only
-		// possible error would be out of
-		// memory
-		regfree (&regex1);
-		regfree (&regex2);
-		ksDel (ks);
-		return ERROR;
+		ELEKTRA_SET_VALIDATION_SEMANTIC_ERRORF (parentKey, "Key %s not found", keyName (assign->reference));
+		return NULL;
 	}
+	return keyString (found);
+}
+
+static char * copyMatch (const char * string, const regmatch_t * match)
+{
+	size_t length = (size_t) (match->rm_eo - match->rm_so);
+	char * copy = elektraMalloc (length + 1);
+	strncpy (copy, string + match->rm_so, length);
+	copy[length] = '\0';
+	return copy;
+}
+
+static ConditionProgram * compileProgram (ConditionalsData * data, const char * conditionString, Operation op, const Key * key,
+					  const Key * parentKey)
+{
+	ConditionProgram * program = elektraCalloc (sizeof (ConditionProgram));
+	program->source = elektraStrDup (conditionString);
+	program->parentName = elektraStrDup (keyName (parentKey));
+	program->op = op;
+
 	size_t subMatches = 6;
 	regmatch_t m[subMatches];
-	int nomatch = regexec (&regex1, conditionString, subMatches, m, 0);
-	if (nomatch)
+	if (regexec (&data->condition, conditionString, subMatches, m, 0) || m[1].rm_so == -1)
 	{
-		ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
-			parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information", conditionString);
-		regfree (&regex1);
-		regfree (&regex2);
-		regfree (&regex3);
-		ksDel (ks);
-		return ERROR;
+		program->invalid = 1;
+		return program;
 	}
-	if (m[1].rm_so == -1)
+	program->condition = copyMatch (conditionString, &m[1]);
+	if (regexec (&data->thenExpr, conditionString, subMatches, m, 0) || m[1].rm_so == -1)
 	{
-		ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
-			parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information", conditionString);
-		regfree (&regex1);
-		regfree (&regex2);
-		regfree (&regex3);
-		ksDel (ks);
-		return ERROR;
+		program->invalid = 1;
+		return program;
 	}
-	int startPos = (int) m[1].rm_so;
-	int endPos = (int) m[1].rm_eo;
-	char * condition = elektraMalloc ((size_t) (endPos - startPos + 1));
-	char * thenexpr = NULL;
-	char * elseexpr = NULL;
-	strncpy (condition, conditionString + startPos, (size_t) (endPos - startPos));
-	condition[endPos - startPos] = '\0';
-	nomatch = regexec (&regex2, conditionString, subMatches, m, 0);
-	if (nomatch)
+	program->thenexpr = copyMatch (conditionString, &m[1]);
+	if (!regexec (&data->elseExpr, conditionString, subMatches, m, 0))
 	{
-		ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
-			parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information", conditionString);
-		regfree (&regex1);
-		regfree (&regex2);
-		regfree (&regex3);
-		ksDel (ks);
-		return ERROR;
+		if (m[1].rm_so == -1)
+		{
+			program->invalid = 1;
+			return program;
+		}
+		program->thenexpr[strlen (program->thenexpr) - (size_t) ((m[0].rm_eo - m[0].rm_so))] = '\0';
+		program->elseexpr = copyMatch (conditionString, &m[1]);
 	}
-	if (m[1].rm_so == -1)
+
+	compileExpression (&program->conditionExpr, program->condition, &data->group, key, parentKey);
+	return program;
+}
+
+/**
+ * @brief Compiles the then or else branch of @p program, when it is taken for the first time.
+ *
+ * Branches that are never taken are never parsed, like before conditions were compiled.
+ */
+static void compileBranch (ConditionalsData * data, ConditionProgram * program, int elseBranch, const Key * key, const Key * parentKey)
+{
+	int * compiled = elseBranch ? &program->elseCompiled : &program->thenCompiled;
+	if (*compiled) return;
+	*compiled = 1;
+
+	const char * expr = elseBranch ? program->elseexpr : program->thenexpr;
+	if (program->op == ASSIGN)
 	{
-		ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
-			parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information", conditionString);
-		regfree (&regex1);
-		regfree (&regex2);
-		regfree (&regex3);
-		ksDel (ks);
-		return ERROR;
+		compileAssign (elseBranch ? &program->elseAssign : &program->thenAssign, expr, key, parentKey);
+	}
+	else
+	{
+		compileExpression (elseBranch ? &program->elseExpr : &program->thenExpr, expr, &data->group, key, parentKey);
 	}
+}
 
-	startPos = (int) m[1].rm_so;
-	endPos = (int) m[1].rm_eo;
-	thenexpr = elektraMalloc ((size_t) (endPos - startPos + 1));
-	strncpy (thenexpr, conditionString + startPos, (size_t) (endPos - startPos));
-	thenexpr[endPos - startPos] = '\0';
+static void freeProgram (ConditionProgram * program)
+{
+	freeExpression (&program->conditionExpr);
+	freeExpression (&program->thenExpr);
+	freeExpression (&program->elseExpr);
+	elektraFree (program->thenAssign.value);
+	keyDel (program->thenAssign.reference);
+	elektraFree (program->elseAssign.value);
+	keyDel (program->elseAssign.reference);
+	elektraFree (program->condition);
+	elektraFree (program->thenexpr);
+	elektraFree (program->elseexpr);
+	elektraFree (program->source);
+	elektraFree (program->parentName);
+	elektraFree (program);
+}
 
-	nomatch = regexec (&regex3, conditionString, subMatches, m, 0);
-	if (!nomatch)
+static void freePrograms (KeySet * programs)
+{
+	for (elektraCursor it = 0; it < ksGetSize (programs); ++it)
 	{
-		if (m[1].rm_so == -1)
+		freeProgram (*(ConditionProgram * const *) keyValue (ksAtCursor (programs, it)));
+	}
+	ksDel (programs);
+}
+
+/**
+ * @brief Returns the program for the condition @p meta of @p key.
+ *
+ * Programs are compiled on first use and reused as long as the condition and the parent stay the same.
+ */
+static ConditionProgram * getProgram (ConditionalsData * data, const Key * meta, Operation op, const Key * key, const Key * parentKey)
+{
+	keySetName (data->lookup, keyName (key));
+	keyAddBaseName (data->lookup, keyName (meta));
+	Key * entry = ksLookup (data->programs, data->lookup, KDB_O_NONE);
+	if (!entry && (entry = ksLookup (data->previous, data->lookup, KDB_O_POP)) != NULL)
+	{
+		ksAppendKey (data->programs, entry);
+	}
+
+	ConditionProgram * program = entry ? *(ConditionProgram * const *) keyValue (entry) : NULL;
+	if (program &&
+	    (program->op != op || strcmp (program->source, keyString (meta)) || strcmp (program->parentName, keyName (parentKey))))
+	{
+		freeProgram (program);
+		program = NULL;
+	}
+	if (!program)
+	{
+		program = compileProgram (data, keyString (meta), op, key, parentKey);
+		if (!entry)
 		{
-			ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
-				parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information",
-				conditionString);
-			regfree (&regex1);
-			regfree (&regex2);
-			regfree (&regex3);
-			ksDel (ks);
-			return ERROR;
+			entry = keyNew (keyName (data->lookup), KEY_END);
+			ksAppendKey (data->programs, entry);
 		}
-		thenexpr[strlen (thenexpr) - (size_t) ((m[0].rm_eo - m[0].rm_so))] = '\0';
-		startPos = (int) m[1].rm_so;
-		endPos = (int) m[1].rm_eo;
-		elseexpr = elektraMalloc ((size_t) (endPos - startPos + 1));
-		strncpy (elseexpr, conditionString + startPos, (size_t) (endPos - startPos));
-		elseexpr[endPos - startPos] = '\0';
+		keySetBinary (entry, &program, sizeof (program));
+	}
+	return program;
+}
+
+static CondResult parseConditionString (ConditionalsData * data, const Key * meta, const Key * suffixList, Key * parentKey, Key * key,
+					KeySet * ks, Operation op)
+{
+	const char * conditionString = keyString (meta);
+	ConditionProgram * program = getProgram (data, meta, op, key, parentKey);
+	CondResult ret;
+	if (program->invalid)
+	{
+		ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
+			parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information", conditionString);
+		return ERROR;
 	}
 
-	ret = parseCondition (key, condition, suffixList, ks, parentKey);
+	ret = evalExpression (&program->conditionExpr, key, suffixList, ks, parentKey);
 	if (ret == TRUE)
 	{
+		compileBranch (data, program, 0, key, parentKey);
 		if (op == ASSIGN)
 		{
-			const char * assign = isAssign (key, thenexpr, parentKey, ks);
+			const char * assign = isAssign (&program->thenAssign, program->thenexpr, parentKey, ks);
 			if (assign != NULL)
 			{
 				keySetString (key, assign);
 				ret = TRUE;
-				goto CleanUp;
 			}
 			else
 			{
 				ret = ERROR;
-				goto CleanUp;
 			}
 		}
 		else
 		{
-			ret = parseCondition (key, thenexpr, suffixList, ks, parentKey);
+			ret = evalExpression (&program->thenExpr, key, suffixList, ks, parentKey);
 			if (ret == FALSE)
 			{
 				ELEKTRA_SET_VALIDATION_SEMANTIC_ERRORF (parentKey, "Validation of Key %s: %s failed. (%s failed)",
 									keyName (key) + strlen (keyName (parentKey)) + 1, conditionString,
-									thenexpr);
+									program->thenexpr);
 			}
 			else if (ret == ERROR)
 			{
 				ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
 					parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information",
-					thenexpr);
+					program->thenexpr);
 			}
 		}
 	}
 	else if (ret == FALSE)
 	{
-		if (elseexpr)
+		if (program->elseexpr)
 		{
+			compileBranch (data, program, 1, key, parentKey);
 			if (op == ASSIGN)
 			{
-				const char * assign = isAssign (key, elseexpr, parentKey, ks);
+				const char * assign = isAssign (&program->elseAssign, program->elseexpr, parentKey, ks);
 				if (assign != NULL)
 				{
 					keySetString (key, assign);
 					ret = TRUE;
-					goto CleanUp;
 				}
 				else
 				{
 					ret = ERROR;
-					goto CleanUp;
 				}
 			}
 			else
 			{
-				ret = parseCondition (key, elseexpr, suffixList, ks, parentKey);
+				ret = evalExpression (&program->elseExpr, key, suffixList, ks, parentKey);
 
 				if (ret == FALSE)
 				{
 					ELEKTRA_SET_VALIDATION_SEMANTIC_ERRORF (parentKey, "Validation of Key %s: %s failed. (%s failed)",
 										keyName (key) + strlen (keyName (parentKey)) + 1,
-										conditionString, elseexpr);
+										conditionString, program->elseexpr);
 				}
 				else if (ret == ERROR)
 				{
 					ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
 						parentKey,
 						"Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information",
-						elseexpr);
+						program->elseexpr);
 				}
 			}
 		}
@@ -802,24 +1014,17 @@ static CondResult parseConditionString (const Key * meta, const Key * suffixList
 	else if (ret == ERROR)
 	{
 		ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (
-			parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information", condition);
+			parentKey, "Invalid syntax: '%s'. Check kdb plugin-info conditionals for additional information",
+			program->condition);
 	}
-
-CleanUp:
-	elektraFree (condition);
-	elektraFree (thenexpr);
-	if (elseexpr) elektraFree (elseexpr);
-	regfree (&regex1);
-	regfree (&regex2);
-	regfree (&regex3);
-	ksDel (ks);
 	return ret;
 }
 
-static CondResult evaluateKey (const Key * meta, const Key * suffixList, Key * parentKey, Key * key, KeySet * ks, Operation op)
+static CondResult evaluateKey (ConditionalsData * data, const Key * meta, const Key * suffixList, Key * parentKey, Key * key, KeySet * ks,
+			       Operation op)
 {
 	CondResult result;
-	result = parseConditionString (meta, suffixList, parentKey, key, ksDup (ks), op);
+	result = parseConditionString (data, meta, suffixList, parentKey, key, ks, op);
 	if (result == ERROR)
 	{
 		return ERROR;
@@ -839,7 +1044,8 @@ static CondResult evaluateKey (const Key * meta, const Key * suffixList, Key * p
 	return TRUE;
 }
 
-static CondResult evalMultipleConditions (Key * key, const Key * meta, const Key * suffixList, Key * parentKey, KeySet * returned)
+static CondResult evalMultipleConditions (ConditionalsData * data, Key * key, const Key * meta, const Key * suffixList, Key * parentKey,
+					  KeySet * returned)
 {
 	int countSucceeded = 0;
 	int countFailed = 0;
@@ -850,7 +1056,7 @@ static CondResult evalMultipleConditions (Key * key, const Key * meta, const Key
 	while ((c = ksNext (condKS)) != NULL)
 	{
 		if (!keyCmp (c, meta)) continue;
-		result = evaluateKey (c, suffixList, parentKey, key, returned, CONDITION);
+		result = evaluateKey (data, c, suffixList, parentKey, key, returned, CONDITION);
 		if (result == TRUE)
 			++countSucceeded;
 		else if (result == ERROR)
@@ -885,7 +1091,46 @@ static CondResult evalMultipleConditions (Key * key, const Key * meta, const Key
 	}
 }
 
-int elektraConditionalsGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned ELEKTRA_UNUSED, Key * parentKey ELEKTRA_UNUSED)
+int elektraConditionalsOpen (Plugin * handle, Key * errorKey)
+{
+	ConditionalsData * data = elektraCalloc (sizeof (ConditionalsData));
+	if (!data)
+	{
+		ELEKTRA_SET_OUT_OF_MEMORY_ERROR (errorKey);
+		return -1;
+	}
+	// the regexes compile, so the only possible error would be out of memory
+	if (regcomp (&data->group, "((\\(([^\\(\\)]*)\\)))", REG_EXTENDED | REG_NEWLINE) ||
+	    regcomp (&data->condition, "(\\(((.*)?)\\))[[:space:]]*\\?", REGEX_FLAGS_CONDITION) ||
+	    regcomp (&data->thenExpr, "\\?[[:space:]]*(\\(((.*)?)\\))", REGEX_FLAGS_CONDITION) ||
+	    regcomp (&data->elseExpr, "[[:space:]]*:[[:space:]]*(\\(((.*)?)\\))", REGEX_FLAGS_CONDITION))
+	{
+		elektraFree (data);
+		ELEKTRA_SET_OUT_OF_MEMORY_ERROR (errorKey);
+		return -1;
+	}
+	data->programs = ksNew (0, KS_END);
+	data->lookup = keyNew ("/", KEY_END);
+	elektraPluginSetData (handle, data);
+	return 1;
+}
+
+int elektraConditionalsClose (Plugin * handle, Key * errorKey ELEKTRA_UNUSED)
+{
+	ConditionalsData * data = elektraPluginGetData (handle);
+	if (!data) return 1;
+	regfree (&data->group);
+	regfree (&data->condition);
+	regfree (&data->thenExpr);
+	regfree (&data->elseExpr);
+	freePrograms (data->programs);
+	keyDel (data->lookup);
+	elektraFree (data);
+	elektraPluginSetData (handle, NULL);
+	return 1;
+}
+
+int elektraConditionalsGet (Plugin * handle, KeySet * returned, Key * parentKey)
 {
 	if (!strcmp (keyName (parentKey), "system:/elektra/modules/conditionals"))
 	{
@@ -893,6 +1138,8 @@ int elektraConditionalsGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned EL
 			30,
 			keyNew ("system:/elektra/modules/conditionals", KEY_VALUE, "conditionals plugin waits for your orders", KEY_END),
 			keyNew ("system:/elektra/modules/conditionals/exports", KEY_END),
+			keyNew ("system:/elektra/modules/conditionals/exports/open", KEY_FUNC, elektraConditionalsOpen, KEY_END),
+			keyNew ("system:/elektra/modules/conditionals/exports/close", KEY_FUNC, elektraConditionalsClose, KEY_END),
 			keyNew ("system:/elektra/modules/conditionals/exports/get", KEY_FUNC, elektraConditionalsGet, KEY_END),
 			keyNew ("system:/elektra/modules/conditionals/exports/set", KEY_FUNC, elektraConditionalsSet, KEY_END),
 #include ELEKTRA_README
@@ -902,11 +1149,14 @@ int elektraConditionalsGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned EL
 
 		return 1; /* success */
 	}
-	Key * cur;
-	ksRewind (returned);
+	ConditionalsData * data = elektraPluginGetData (handle);
+	data->previous = data->programs;
+	data->programs = ksNew ((size_t) ksGetSize (data->previous), KS_END);
 	CondResult ret = FALSE;
-	while ((cur = ksNext (returned)) != NULL)
+	// lookups of the conditions move the cursor of returned
+	for (elektraCursor it = 0; it < ksGetSize (returned); ++it)
 	{
+		Key * cur = ksAtCursor (returned, it);
 		Key * conditionMeta = (Key *) keyGetMeta (cur, "check/condition");
 		Key * assignMeta = (Key *) keyGetMeta (cur, "assign/condition");
 		Key * suffixList = (Key *) keyGetMeta (cur, "condition/validsuffix");
@@ -918,7 +1168,7 @@ int elektraConditionalsGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned EL
 		{
 			CondResult result;
 
-			result = evaluateKey (conditionMeta, suffixList, parentKey, cur, returned, CONDITION);
+			result = evaluateKey (data, conditionMeta, suffixList, parentKey, cur, returned, CONDITION);
 			if (result == NOEXPR)
 			{
 				ret |= TRUE;
@@ -931,19 +1181,19 @@ int elektraConditionalsGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned EL
 		else if (allConditionMeta)
 		{
 			CondResult result;
-			result = evalMultipleConditions (cur, allConditionMeta, suffixList, parentKey, returned);
+			result = evalMultipleConditions (data, cur, allConditionMeta, suffixList, parentKey, returned);
 			ret |= result;
 		}
 		else if (anyConditionMeta)
 		{
 			CondResult result;
-			result = evalMultipleConditions (cur, anyConditionMeta, suffixList, parentKey, returned);
+			result = evalMultipleConditions (data, cur, anyConditionMeta, suffixList, parentKey, returned);
 			ret |= result;
 		}
 		else if (noneConditionMeta)
 		{
 			CondResult result;
-			result = evalMultipleConditions (cur, noneConditionMeta, suffixList, parentKey, returned);
+			result = evalMultipleConditions (data, cur, noneConditionMeta, suffixList, parentKey, returned);
 			ret |= result;
 		}
 
@@ -956,7 +1206,7 @@ int elektraConditionalsGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned EL
 				while ((a = ksNext (assignKS)) != NULL)
 				{
 					if (keyCmp (a, assignMeta) == 0) continue;
-					CondResult result = evaluateKey (a, suffixList, parentKey, cur, returned, ASSIGN);
+					CondResult result = evaluateKey (data, a, suffixList, parentKey, cur, returned, ASSIGN);
 					if (result == TRUE)
 					{
 						ret |= TRUE;
@@ -975,22 +1225,28 @@ int elektraConditionalsGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned EL
 			}
 			else
 			{
-				ret |= evaluateKey (assignMeta, suffixList, parentKey, cur, returned, ASSIGN);
+				ret |= evaluateKey (data, assignMeta, suffixList, parentKey, cur, returned, ASSIGN);
 			}
 		}
 	}
+	// programs of keys that were not evaluated again are not needed anymore
+	freePrograms (data->previous);
+	data->previous = NULL;
 	if (ret == TRUE) keySetMeta (parentKey, "error", 0);
 	return ret; /* success */
 }
 
 
-int elektraConditionalsSet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned ELEKTRA_UNUSED, Key * parentKey ELEKTRA_UNUSED)
+int elektraConditionalsSet (Plugin * handle, KeySet * returned, Key * parentKey)
 {
-	Key * cur;
-	ksRewind (returned);
+	ConditionalsData * data = elektraPluginGetData (handle);
+	data->previous = data->programs;
+	data->programs = ksNew ((size_t) ksGetSize (data->previous), KS_END);
 	CondResult ret = FALSE;
-	while ((cur = ksNext (returned)) != NULL)
+	// lookups of the conditions move the cursor of returned
+	for (elektraCursor it = 0; it < ksGetSize (returned); ++it)
 	{
+		Key * cur = ksAtCursor (returned, it);
 		Key * conditionMeta = (Key *) keyGetMeta (cur, "check/condition");
 		Key * assignMeta = (Key *) keyGetMeta (cur, "assign/condition");
 		Key * suffixList = (Key *) keyGetMeta (cur, "condition/validsuffix");
@@ -1002,7 +1258,7 @@ int elektraConditionalsSet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned EL
 		{
 			CondResult result;
 
-			result = evaluateKey (conditionMeta, suffixList, parentKey, cur, returned, CONDITION);
+			result = evaluateKey (data, conditionMeta, suffixList, parentKey, cur, returned, CONDITION);
 			if (result == NOEXPR)
 			{
 				ret |= TRUE;
@@ -1015,19 +1271,19 @@ int elektraConditionalsSet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned EL
 		else if (allConditionMeta)
 		{
 			CondResult result;
-			result = evalMultipleConditions (cur, allConditionMeta, suffixList, parentKey, returned);
+			result = evalMultipleConditions (data, cur, allConditionMeta, suffixList, parentKey, returned);
 			ret |= result;
 		}
 		else if (anyConditionMeta)
 		{
 			CondResult result;
-			result = evalMultipleConditions (cur, anyConditionMeta, suffixList, parentKey, returned);
+			result = evalMultipleConditions (data, cur, anyConditionMeta, suffixList, parentKey, returned);
 			ret |= result;
 		}
 		else if (noneConditionMeta)
 		{
 			CondResult result;
-			result = evalMultipleConditions (cur, noneConditionMeta, suffixList, parentKey, returned);
+			result = evalMultipleConditions (data, cur, noneConditionMeta, suffixList, parentKey, returned);
 			ret |= result;
 		}
 
@@ -1040,7 +1296,7 @@ int elektraConditionalsSet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned EL
 				while ((a = ksNext (assignKS)) != NULL)
 				{
 					if (keyCmp (a, assignMeta) == 0) continue;
-					CondResult result = evaluateKey (a, suffixList, parentKey, cur, returned, ASSIGN);
+					CondResult result = evaluateKey (data, a, suffixList, parentKey, cur, returned, ASSIGN);
 					if (result == TRUE)
 					{
 						ret |= TRUE;
@@ -1059,10 +1315,13 @@ int elektraConditionalsSet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned EL
 			}
 			else
 			{
-				ret |= evaluateKey (assignMeta, suffixList, parentKey, cur, returned, ASSIGN);
+				ret |= evaluateKey (data, assignMeta, suffixList, parentKey, cur, returned, ASSIGN);
 			}
 		}
 	}
+	// programs of keys that were not evaluated again are not needed anymore
+	freePrograms (data->previous);
+	data->previous = NULL;
 	if (ret == TRUE) keySetMeta (parentKey, "error", 0);
 	return ret;
 }
@@ -1071,6 +1330,8 @@ Plugin * ELEKTRA_PLUGIN_EXPORT
 {
 	// clang-format off
     return elektraPluginExport ("conditionals",
+	    ELEKTRA_PLUGIN_OPEN, &elektraConditionalsOpen,
+	    ELEKTRA_PLUGIN_CLOSE, &elektraConditionalsClose,
 	    ELEKTRA_PLUGIN_GET, &elektraConditionalsGet,
 	    ELEKTRA_PLUGIN_SET, &elektraConditionalsSet,
 	    ELEKTRA_PLUGIN_END);
@@ -653,6 +653,80 @@ static void test_multiAssign3 (void)
 	PLUGIN_CLOSE ();
 }
 
+static void test_reuse (void)
+{
+	Key * parentKey = keyNew ("user:/tests/conditionals", KEY_VALUE, "", KEY_END);
+	KeySet * ks = ksNew (5,
+			     keyNew ("user:/tests/conditionals/totest", KEY_VALUE, "5", KEY_META, "check/condition",
+				     "(../totest<../bla/val1) ? ((../bla/val1 == '100') && ((../bla/result == 'result1') || "
+				     "(../bla/result == 'result3')))",
+				     KEY_END),
+			     keyNew ("user:/tests/conditionals/assign", KEY_VALUE, "", KEY_META, "assign/condition",
+				     "(../bla/val1 == '100') ? (../bla/result) : ('none')", KEY_END),
+			     keyNew ("user:/tests/conditionals/bla/val1", KEY_VALUE, "100", KEY_END),
+			     keyNew ("user:/tests/conditionals/bla/result", KEY_VALUE, "result3", KEY_END), KS_END);
+
+	KeySet * conf = ksNew (0, KS_END);
+	PLUGIN_OPEN ("conditionals");
+	succeed_if (plugin->kdbGet (plugin, ks, parentKey) == 1, "error");
+	succeed_if_same_string (keyString (ksLookupByName (ks, "user:/tests/conditionals/assign", 0)), "result3");
+
+	// compiled conditions have to see the current values
+	keySetString (ksLookupByName (ks, "user:/tests/conditionals/bla/result", 0), "result2");
+	succeed_if (plugin->kdbSet (plugin, ks, parentKey) == -1, "changed value not seen");
+	succeed_if_same_string (keyString (ksLookupByName (ks, "user:/tests/conditionals/assign", 0)), "result2");
+	keySetMeta (parentKey, "error", 0);
+
+	// and changed conditions
+	keySetString (ksLookupByName (ks, "user:/tests/conditionals/bla/val1", 0), "50");
+	keySetMeta (ksLookupByName (ks, "user:/tests/conditionals/totest", 0), "check/condition",
+		    "(../totest<../bla/val1) ? ((../bla/val1 == '50') && ((../bla/result == 'result2') || "
+		    "(../bla/result == 'result3')))");
+	succeed_if (plugin->kdbGet (plugin, ks, parentKey) == 1, "changed condition not seen");
+	succeed_if_same_string (keyString (ksLookupByName (ks, "user:/tests/conditionals/assign", 0)), "none");
+
+	// programs of removed keys and other parents
+	keyDel (ksLookupByName (ks, "user:/tests/conditionals/totest", KDB_O_POP));
+	succeed_if (plugin->kdbGet (plugin, ks, parentKey) == 1, "error");
+	KeySet * other = ksNew (5,
+				keyNew ("user:/tests/other/assign", KEY_VALUE, "", KEY_META, "assign/condition",
+					"(@/bla/val1 == '100') ? ('hundred') : ('none')", KEY_END),
+				keyNew ("user:/tests/other/bla/val1", KEY_VALUE, "100", KEY_END), KS_END);
+	Key * otherParent = keyNew ("user:/tests/other", KEY_END);
+	succeed_if (plugin->kdbGet (plugin, other, otherParent) == 1, "error");
+	succeed_if_same_string (keyString (ksLookupByName (other, "user:/tests/other/assign", 0)), "hundred");
+
+	ksDel (other);
+	keyDel (otherParent);
+	ksDel (ks);
+	keyDel (parentKey);
+	PLUGIN_CLOSE ();
+}
+
+static void test_malformedBranchNotTaken (void)
+{
+	Key * parentKey = keyNew ("user:/tests/conditionals", KEY_VALUE, "", KEY_END);
+	KeySet * ks = ksNew (5,
+			     keyNew ("user:/tests/conditionals/totest", KEY_VALUE, "1", KEY_META, "check/condition",
+				     "(../c == '1') ? ((../c ==  )..t/x)", KEY_END),
+			     keyNew ("user:/tests/conditionals/other", KEY_VALUE, "1", KEY_META, "check/condition",
+				     "(../c == '2') ? (../c == '2') : ((../c ==  )..t/x)", KEY_END),
+			     keyNew ("user:/tests/conditionals/c", KEY_VALUE, "2", KEY_END), KS_END);
+
+	KeySet * conf = ksNew (0, KS_END);
+	PLUGIN_OPEN ("conditionals");
+	// the compiled condition is reused by the second and third call
+	for (int i = 0; i < 3; ++i)
+	{
+		succeed_if (plugin->kdbGet (plugin, ks, parentKey) == 1, "malformed branch that is not taken failed");
+		succeed_if (plugin->kdbSet (plugin, ks, parentKey) == 1, "malformed branch that is not taken failed");
+	}
+
+	ksDel (ks);
+	keyDel (parentKey);
+	PLUGIN_CLOSE ();
+}
+
 int main (int argc, char ** argv)
 {
 	printf ("CONDITIONALS     TESTS\n");
@@ -694,6 +768,8 @@ int main (int argc, char ** argv)
 	test_multiCond2NoFail ();
 	test_multiAssign2 ();
 	test_multiAssign3 ();
+	test_reuse ();
+	test_malformedBranchNotTaken ();
 	print_result ("testmod_conditionals");
 
 	return nbError;
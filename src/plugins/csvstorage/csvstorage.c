@@ -398,6 +398,16 @@ static int csvRead (KeySet * returned, Key * parentKey, char delim, Key * colAsP
 	keyAddName (dirKey, "#");
 	elektraFree (lineBuffer);
 	ksRewind (header);
+	// rows are read in order, so the builder does not need to sort them
+	ElektraKsBuilder * builder = elektraKsBuilderNew (0);
+	if (!builder)
+	{
+		ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey);
+		keyDel (dirKey);
+		ksDel (header);
+		fclose (fp);
+		return -1;
+	}
 	while (1)
 	{
 		lineBuffer = readNextLine (fp, delim, &lastLine, &linesRead);
@@ -406,6 +416,9 @@ static int csvRead (KeySet * returned, Key * parentKey, char delim, Key * colAsP
 			fclose (fp);
 			keyDel (dirKey);
 			ksDel (header);
+			KeySet * read = elektraKsBuilderFinish (builder);
+			ksAppend (returned, read);
+			ksDel (read);
 			return (lineCounter > 0) ? 1 : 0;
 		}
 
@@ -414,6 +427,7 @@ static int csvRead (KeySet * returned, Key * parentKey, char delim, Key * colAsP
 			elektraFree (lineBuffer);
 			keyDel (dirKey);
 			ksDel (header);
+			elektraKsBuilderDel (builder);
 			fclose (fp);
 			return -1;
 		}
@@ -464,15 +478,21 @@ static int csvRead (KeySet * returned, Key * parentKey, char delim, Key * colAsP
 				keyDel (renameKey);
 				ksRewind (renamedKs);
 				ksRewind (tmpKs);
-				ksAppend (returned, renamedKs);
+				for (elektraCursor it = 0; it < ksGetSize (renamedKs); ++it)
+				{
+					elektraKsBuilderAdd (builder, ksAtCursor (renamedKs, it));
+				}
 				ksDel (renamedKs);
 			}
 		}
 		else
 		{
 			keySetString (dirKey, lastIndex);
-			ksAppend (returned, tmpKs);
-			ksAppendKey (returned, keyDup (dirKey));
+			elektraKsBuilderAdd (builder, keyDup (dirKey));
+			for (elektraCursor it = 0; it < ksGetSize (tmpKs); ++it)
+			{
+				elektraKsBuilderAdd (builder, ksAtCursor (tmpKs, it));
+			}
 		}
 		ksDel (tmpKs);
 		tmpKs = NULL;
@@ -486,6 +506,7 @@ static int csvRead (KeySet * returned, Key * parentKey, char delim, Key * colAsP
 				fclose (fp);
 				keyDel (dirKey);
 				ksDel (header);
+				elektraKsBuilderDel (builder);
 				return -1;
 			}
 			ELEKTRA_ADD_VALIDATION_SYNTACTIC_WARNINGF (parentKey, "Illegal number of columns (%lu - %lu)  in line %lu: %s",
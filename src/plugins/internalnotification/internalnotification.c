@@ -14,6 +14,7 @@
 #include <kdbhelper.h>
 #include <kdblogger.h>
 #include <kdbnotificationinternal.h>
+#include <kdbprivate.h>
 
 #include <ctype.h>  // isspace()
 #include <errno.h>  // errno
@@ -26,7 +27,10 @@
 struct _KeyRegistration
 {
 	char * name;
+	Key * key; /*!< key with the registered name for lookups */
 	char * lastValue;
+	size_t lastValueSize; /*!< size of lastValue including the terminating null */
+	size_t order;	      /*!< position in the list of registrations */
 	int sameOrBelow;
 	int freeContext;
 	ElektraNotificationChangeCallback callback;
@@ -43,11 +47,25 @@ struct _PluginState
 {
 	KeyRegistration * head;
 	KeyRegistration * last;
+	KeyRegistration ** index; /*!< all registrations sorted by name, if indexSorted is set */
+	size_t indexSize;
+	size_t indexAlloc;
+	int indexSorted;
 	ElektraNotificationConversionErrorCallback conversionErrorCallback;
 	void * conversionErrorCallbackContext;
 };
 typedef struct _PluginState PluginState;
 
+/**
+ * Registration whose key changed, collected while updating registrations
+ * @internal
+ */
+typedef struct
+{
+	KeyRegistration * registration;
+	Key * key;
+} ChangedRegistration;
+
 /**
  * @see kdbnotificationinternal.h ::ElektraNotificationSetConversionErrorCallback
  */
@@ -147,7 +165,7 @@ void elektraInternalnotificationDoUpdate (Key * changedKey, ElektraNotificationC
 	KeyRegistration * keyRegistration = pluginState->head;
 	while (keyRegistration != NULL)
 	{
-		Key * registeredKey = keyNew (keyRegistration->name, KEY_END);
+		Key * registeredKey = keyRegistration->key;
 
 		// check if registered key is same or below changed/commit key
 		kdbChanged |= checkKeyIsBelowOrSame (changedKey, registeredKey);
@@ -159,7 +177,6 @@ void elektraInternalnotificationDoUpdate (Key * changedKey, ElektraNotificationC
 		}
 
 		keyRegistration = keyRegistration->next;
-		keyDel (registeredKey);
 	}
 
 	if (kdbChanged)
@@ -185,6 +202,16 @@ static KeyRegistration * elektraInternalnotificationAddNewRegistration (PluginSt
 									ElektraNotificationChangeCallback callback, void * context,
 									int freeContext)
 {
+	if (pluginState->indexSize == pluginState->indexAlloc)
+	{
+		size_t alloc = pluginState->indexAlloc ? 2 * pluginState->indexAlloc : 16;
+		if (elektraRealloc ((void **) &pluginState->index, alloc * sizeof (KeyRegistration *)) < 0)
+		{
+			return NULL;
+		}
+		pluginState->indexAlloc = alloc;
+	}
+
 	KeyRegistration * item = elektraMalloc (sizeof *item);
 	if (item == NULL)
 	{
@@ -192,12 +219,18 @@ static KeyRegistration * elektraInternalnotificationAddNewRegistration (PluginSt
 	}
 	item->next = NULL;
 	item->lastValue = NULL;
+	item->lastValueSize = 0;
 	item->name = elektraStrDup (keyName (key));
+	item->key = keyNew (keyName (key), KEY_END);
+	item->order = pluginState->indexSize;
 	item->callback = callback;
 	item->context = context;
 	item->sameOrBelow = 0;
 	item->freeContext = freeContext;
 
+	pluginState->index[pluginState->indexSize++] = item;
+	pluginState->indexSorted = 0;
+
 	if (pluginState->head == NULL)
 	{
 		// Initialize list
@@ -224,22 +257,114 @@ static KeyRegistration * elektraInternalnotificationAddNewRegistration (PluginSt
  */
 static int keySetContainsSameOrBelow (Key * check, KeySet * ks)
 {
-	Key * current;
-	ksRewind (ks);
-	while ((current = ksNext (ks)) != NULL)
+	// keys can be below keys of the same namespace and cascading keys
+	elektraNamespace checkNamespace = keyGetNamespace (check);
+	Key * lookup = keyNew (keyName (check), KEY_END);
+	int result = 0;
+	for (elektraNamespace ns = KEY_NS_CASCADING; ns <= KEY_NS_LAST && !result; ++ns)
 	{
-		if (checkKeyIsBelowOrSame (check, current))
+		if (checkNamespace != KEY_NS_CASCADING && ns != KEY_NS_CASCADING && ns != checkNamespace)
 		{
-			return 1;
+			continue;
 		}
+		keySetNamespace (lookup, ns);
+		elektraCursor end;
+		result = ksFindHierarchy (ks, lookup, &end) < end;
+	}
+	keyDel (lookup);
+	return result;
+}
+
+static int compareRegistrationNames (const void * a, const void * b)
+{
+	const KeyRegistration * registrationA = *(const KeyRegistration * const *) a;
+	const KeyRegistration * registrationB = *(const KeyRegistration * const *) b;
+	int result = keyCmp (registrationA->key, registrationB->key);
+	if (result != 0) return result;
+	return registrationA->order < registrationB->order ? -1 : registrationA->order > registrationB->order;
+}
+
+static int compareRegistrationOrder (const void * a, const void * b)
+{
+	const KeyRegistration * registrationA = ((const ChangedRegistration *) a)->registration;
+	const KeyRegistration * registrationB = ((const ChangedRegistration *) b)->registration;
+	return registrationA->order < registrationB->order ? -1 : registrationA->order > registrationB->order;
+}
+
+/**
+ * @internal
+ * Find the first key that is not less than a given key.
+ *
+ * Searches with growing steps from @p start, so that looking up keys in order
+ * costs about one pass over the key set.
+ *
+ * @param  ks    key set
+ * @param  start position to start with, all keys before it are less than @p key
+ * @param  key   key to search for
+ * @return position of the first key not less than @p key, or the size of @p ks
+ */
+static elektraCursor findFrom (KeySet * ks, elektraCursor start, Key * key)
+{
+	elektraCursor size = ksGetSize (ks);
+	elektraCursor lo = start;
+	elektraCursor hi = start;
+	elektraCursor step = 1;
+	while (hi < size && keyCmp (ksAtCursor (ks, hi), key) < 0)
+	{
+		lo = hi + 1;
+		hi = start + step;
+		step *= 2;
 	}
-	return 0;
+	if (hi > size) hi = size;
+	while (lo < hi)
+	{
+		elektraCursor mid = lo + (hi - lo) / 2;
+		if (keyCmp (ksAtCursor (ks, mid), key) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/**
+ * @internal
+ * Check if the value of a key differs from the value saved for a registration and save it.
+ *
+ * @param  registeredKey registration
+ * @param  key           key with the registered name
+ * @retval 1 if the value changed
+ * @retval 0 otherwise
+ */
+static int valueChanged (KeyRegistration * registeredKey, Key * key)
+{
+	// always notify for binary keys
+	if (!keyIsString (key)) return 1;
+
+	const char * currentValue = keyString (key);
+	size_t size = keyGetValueSize (key) > 0 ? (size_t) keyGetValueSize (key) : 1;
+	if (registeredKey->lastValue != NULL && registeredKey->lastValueSize == size &&
+	    memcmp (currentValue, registeredKey->lastValue, size) == 0)
+	{
+		return 0;
+	}
+
+	// Save last value
+	if (registeredKey->lastValueSize == size || elektraRealloc ((void **) &registeredKey->lastValue, size) == 0)
+	{
+		memcpy (registeredKey->lastValue, currentValue, size);
+		registeredKey->lastValueSize = size;
+	}
+	return 1;
 }
 
 /**
  * Updates all KeyRegistrations according to data from the given KeySet
  * @internal
  *
+ * The registrations are sorted by name and joined with the key set in one pass.
+ * Callbacks are invoked in the order of registration.
+ *
  * @param plugin    internal plugin handle
  * @param keySet    key set retrieved from hooks
  *                  e.g. elektraInternalnotificationGet or elektraInternalnotificationSet)
@@ -250,75 +375,78 @@ void elektraInternalnotificationUpdateRegisteredKeys (Plugin * plugin, KeySet *
 	PluginState * pluginState = elektraPluginGetData (plugin);
 	ELEKTRA_ASSERT (pluginState != NULL, "plugin state was not initialized properly");
 
-	KeyRegistration * registeredKey = pluginState->head;
-	while (registeredKey != NULL)
+	size_t registrations = pluginState->indexSize;
+	if (registrations == 0)
+	{
+		return;
+	}
+	if (!pluginState->indexSorted)
+	{
+		qsort (pluginState->index, registrations, sizeof (KeyRegistration *), compareRegistrationNames);
+		pluginState->indexSorted = 1;
+	}
+
+	ChangedRegistration * changed = elektraMalloc (registrations * sizeof (ChangedRegistration));
+	if (changed == NULL)
+	{
+		return;
+	}
+	size_t changedSize = 0;
+
+	elektraCursor position = 0;
+	for (size_t i = 0; i < registrations; ++i)
 	{
-		int changed = 0;
-		Key * key;
+		KeyRegistration * registeredKey = pluginState->index[i];
+		Key * key = NULL;
+		int isChanged = 0;
 		if (registeredKey->sameOrBelow)
 		{
-			Key * checkKey = keyNew (registeredKey->name, KEY_END);
-			if (keySetContainsSameOrBelow (checkKey, keySet))
-			{
-				changed = 1;
-				key = checkKey;
-			}
-			else
-			{
-				keyDel (checkKey);
-			}
+			isChanged = keySetContainsSameOrBelow (registeredKey->key, keySet);
+		}
+		else if (keyGetNamespace (registeredKey->key) == KEY_NS_CASCADING)
+		{
+			key = ksLookup (keySet, registeredKey->key, 0);
+			isChanged = key != NULL && valueChanged (registeredKey, key);
 		}
 		else
 		{
-			key = ksLookupByName (keySet, registeredKey->name, 0);
-			if (key != NULL)
+			// registrations are sorted like the key set, so the search continues where the previous one stopped
+			position = findFrom (keySet, position, registeredKey->key);
+			if (position < ksGetSize (keySet) && keyCmp (ksAtCursor (keySet, position), registeredKey->key) == 0)
 			{
-				// Detect changes for string keys
-				if (!keyIsString (key))
-				{
-					// always notify for binary keys
-					changed = 1;
-				}
-				else
-				{
-					const char * currentValue = keyString (key);
-					changed = registeredKey->lastValue == NULL || strcmp (currentValue, registeredKey->lastValue) != 0;
-
-					if (changed)
-					{
-						// Save last value
-						char * buffer = elektraStrDup (currentValue);
-						if (buffer)
-						{
-							if (registeredKey->lastValue != NULL)
-							{
-								// Free previous value
-								elektraFree (registeredKey->lastValue);
-							}
-							registeredKey->lastValue = buffer;
-						}
-					}
-				}
+				key = ksAtCursor (keySet, position);
+				isChanged = valueChanged (registeredKey, key);
 			}
 		}
 
-		if (changed)
+		if (isChanged)
 		{
-			ELEKTRA_LOG_DEBUG ("found changed registeredKey=%s with string value \"%s\". using context or variable=%p",
-					   registeredKey->name, keyString (key), registeredKey->context);
-
-			// Invoke callback
-			ElektraNotificationChangeCallback callback = *(ElektraNotificationChangeCallback) registeredKey->callback;
-			callback (key, registeredKey->context);
-			if (registeredKey->sameOrBelow)
-			{
-				keyDel (key);
-			}
+			changed[changedSize].registration = registeredKey;
+			changed[changedSize].key = key;
+			++changedSize;
 		}
+	}
+
+	qsort (changed, changedSize, sizeof (ChangedRegistration), compareRegistrationOrder);
+
+	for (size_t i = 0; i < changedSize; ++i)
+	{
+		KeyRegistration * registeredKey = changed[i].registration;
+		Key * key = registeredKey->sameOrBelow ? keyNew (registeredKey->name, KEY_END) : changed[i].key;
+
+		ELEKTRA_LOG_DEBUG ("found changed registeredKey=%s with string value \"%s\". using context or variable=%p",
+				   registeredKey->name, keyString (key), registeredKey->context);
 
-		// proceed with next registered key
-		registeredKey = registeredKey->next;
+		// Invoke callback
+		ElektraNotificationChangeCallback callback = *(ElektraNotificationChangeCallback) registeredKey->callback;
+		callback (key, registeredKey->context);
+		if (registeredKey->sameOrBelow)
+		{
+			keyDel (key);
+		}
 	}
+
+	elektraFree (changed);
 }
 
 // Generate register and conversion functions
@@ -603,6 +731,10 @@ int elektraInternalnotificationOpen (Plugin * handle, Key * parentKey ELEKTRA_UN
 		// Initialize list pointers for registered keys
 		pluginState->head = NULL;
 		pluginState->last = NULL;
+		pluginState->index = NULL;
+		pluginState->indexSize = 0;
+		pluginState->indexAlloc = 0;
+		pluginState->indexSorted = 1;
 		pluginState->conversionErrorCallback = NULL;
 		pluginState->conversionErrorCallbackContext = NULL;
 	}
@@ -632,6 +764,7 @@ int elektraInternalnotificationClose (Plugin * handle, Key * parentKey ELEKTRA_U
 		{
 			next = current->next;
 			elektraFree (current->name);
+			keyDel (current->key);
 			if (current->lastValue != NULL)
 			{
 				elektraFree (current->lastValue);
@@ -645,7 +778,8 @@ int elektraInternalnotificationClose (Plugin * handle, Key * parentKey ELEKTRA_U
 			current = next;
 		}
 
-		// Free list pointer
+		// Free index and list pointer
+		elektraFree (pluginState->index);
 		elektraFree (pluginState);
 		elektraPluginSetData (handle, NULL);
 	}
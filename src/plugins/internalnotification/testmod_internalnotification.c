@@ -430,6 +430,66 @@ static void test_callbackCalledWithChangeDetection (void)
 	PLUGIN_CLOSE ();
 }
 
+#define MANY_REGISTRATIONS 100
+
+static size_t callback_order[MANY_REGISTRATIONS];
+static size_t callback_order_size;
+
+static void test_orderCallback (Key * key ELEKTRA_UNUSED, void * context)
+{
+	if (callback_order_size < MANY_REGISTRATIONS)
+	{
+		callback_order[callback_order_size] = (size_t) context;
+	}
+	callback_order_size++;
+}
+
+static void test_callbackManyRegistrations (void)
+{
+	printf ("test callbacks of many registrations are called in order of registration\n");
+
+	KeySet * conf = ksNew (0, KS_END);
+	PLUGIN_OPEN ("internalnotification");
+
+	char name[64];
+	KeySet * ks = ksNew (MANY_REGISTRATIONS, KS_END);
+	// register in reverse order of names, with cascading keys in between
+	for (size_t i = 0; i < MANY_REGISTRATIONS; ++i)
+	{
+		size_t n = MANY_REGISTRATIONS - 1 - i;
+		snprintf (name, sizeof (name), "%s/test/internalnotification/key%03zu", n % 10 == 0 ? "" : "user:", n);
+		Key * key = keyNew (name, KEY_END);
+		succeed_if (internalnotificationRegisterCallback (plugin, key, test_orderCallback, (void *) (i + 1)) == 1,
+			    "call to elektraInternalnotificationRegisterCallback was not successful");
+		keyDel (key);
+
+		snprintf (name, sizeof (name), "user:/test/internalnotification/key%03zu", n);
+		ksAppendKey (ks, keyNew (name, KEY_VALUE, "value", KEY_END));
+	}
+
+	elektraInternalnotificationUpdateRegisteredKeys (plugin, ks);
+	succeed_if (callback_order_size == MANY_REGISTRATIONS, "not all registered callbacks were called");
+	for (size_t i = 0; i < MANY_REGISTRATIONS; ++i)
+	{
+		succeed_if (callback_order[i] == i + 1, "callbacks were not called in order of registration");
+	}
+
+	callback_order_size = 0;
+	elektraInternalnotificationUpdateRegisteredKeys (plugin, ks);
+	succeed_if (callback_order_size == 0, "callbacks were called but no value has changed");
+
+	keySetString (ksLookupByName (ks, "user:/test/internalnotification/key042", 0), "other");
+	keySetString (ksLookupByName (ks, "user:/test/internalnotification/key020", 0), "VALUE");
+	keySetString (ksLookupByName (ks, "user:/test/internalnotification/key007", 0), "value");
+	elektraInternalnotificationUpdateRegisteredKeys (plugin, ks);
+	succeed_if (callback_order_size == 2, "callbacks of changed keys were not called");
+	succeed_if (callback_order[0] == MANY_REGISTRATIONS - 42, "callbacks were not called in order of registration");
+	succeed_if (callback_order[1] == MANY_REGISTRATIONS - 20, "callbacks were not called in order of registration");
+
+	ksDel (ks);
+	PLUGIN_CLOSE ();
+}
+
 static void test_doUpdate_callback (KDB * kdb ELEKTRA_UNUSED, Key * changedKey ELEKTRA_UNUSED)
 {
 	doUpdate_callback_called = 1;
@@ -738,6 +798,7 @@ int main (int argc, char ** argv)
 	printf ("\nregisterCallback\n----------------\n");
 	test_callbackCalledWithKey ();
 	test_callbackCalledWithChangeDetection ();
+	test_callbackManyRegistrations ();
 
 	RUN_TYPE_TESTS (UnsignedInt)
 	RUN_TYPE_TESTS (Long)
@@ -25,6 +25,10 @@
 #define MIN_VALID_STACK 3
 #define EPSILON 0.00001
 
+// matches one token of the prefix notation, it is compiled once per plugin instance
+static const char * const tokenRegex =
+	"(((((\\.)|(\\.\\.\\/)*|(@)|(\\/))([[:alnum:]]*/)*[[:alnum:]]+))|('[0-9]*[.,]{0,1}[0-9]*')|(==)|([-+:/<>=!{*]))";
+
 typedef enum
 {
 	ERROR = 0,
@@ -59,6 +63,8 @@ int elektraMathcheckGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned ELEKT
 		KeySet * contract = ksNew (
 			30, keyNew ("system:/elektra/modules/mathcheck", KEY_VALUE, "mathcheck plugin waits for your orders", KEY_END),
 			keyNew ("system:/elektra/modules/mathcheck/exports", KEY_END),
+			keyNew ("system:/elektra/modules/mathcheck/exports/open", KEY_FUNC, elektraMathcheckOpen, KEY_END),
+			keyNew ("system:/elektra/modules/mathcheck/exports/close", KEY_FUNC, elektraMathcheckClose, KEY_END),
 			keyNew ("system:/elektra/modules/mathcheck/exports/get", KEY_FUNC, elektraMathcheckGet, KEY_END),
 			keyNew ("system:/elektra/modules/mathcheck/exports/set", KEY_FUNC, elektraMathcheckSet, KEY_END),
 #include ELEKTRA_README
@@ -195,12 +201,9 @@ static PNElem doPrefixCalculation (PNElem * stack, PNElem * stackPtr)
 	result.value = stackPtr->value;
 	return result;
 }
-static PNElem parsePrefixString (const char * prefixString, Key * curKey, KeySet * ks, Key * parentKey)
+static PNElem parsePrefixString (const regex_t * regex, const char * prefixString, Key * curKey, KeySet * ks, Key * parentKey)
 {
-	const char * regexString =
-		"(((((\\.)|(\\.\\.\\/)*|(@)|(\\/))([[:alnum:]]*/)*[[:alnum:]]+))|('[0-9]*[.,]{0,1}[0-9]*')|(==)|([-+:/<>=!{*]))";
 	char * ptr = (char *) prefixString;
-	regex_t regex;
 	Key * key;
 
 	PNElem * stack = elektraMalloc (MIN_VALID_STACK * sizeof (PNElem));
@@ -209,19 +212,13 @@ static PNElem parsePrefixString (const char * prefixString, Key * curKey, KeySet
 	PNElem result;
 	Operation resultOp = ERROR;
 	result.op = ERROR;
-	int ret;
-	if ((ret = regcomp (&regex, regexString, REG_EXTENDED | REG_NEWLINE)))
-	{
-		ksDel (ks);
-		return result;
-	}
 	regmatch_t match;
 	char * searchKey = NULL;
 	while (1)
 	{
 		stackPtr->op = ERROR;
 		stackPtr->value = 0;
-		int nomatch = regexec (&regex, ptr, 1, &match, 0);
+		int nomatch = regexec (regex, ptr, 1, &match, 0);
 		if (nomatch)
 		{
 			break;
@@ -291,7 +288,6 @@ static PNElem parsePrefixString (const char * prefixString, Key * curKey, KeySet
 				break;
 			default:
 				ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (parentKey, "%c isn't a valid operation", prefixString[start]);
-				regfree (&regex);
 				if (searchKey)
 				{
 					elektraFree (searchKey);
@@ -357,7 +353,6 @@ static PNElem parsePrefixString (const char * prefixString, Key * curKey, KeySet
 		stackPtr += offset;
 		ptr += match.rm_eo;
 	}
-	regfree (&regex);
 	elektraFree (searchKey);
 	ksDel (ks);
 	stackPtr->op = END;
@@ -374,8 +369,34 @@ static PNElem parsePrefixString (const char * prefixString, Key * curKey, KeySet
 	return result;
 }
 
-int elektraMathcheckSet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key * parentKey)
+int elektraMathcheckOpen (Plugin * handle, Key * errorKey)
+{
+	regex_t * regex = elektraMalloc (sizeof (regex_t));
+	if (!regex || regcomp (regex, tokenRegex, REG_EXTENDED | REG_NEWLINE))
+	{
+		elektraFree (regex);
+		ELEKTRA_SET_OUT_OF_MEMORY_ERROR (errorKey); // the regex compiles, so the only reason for failing is a lack of memory
+		return -1;
+	}
+	elektraPluginSetData (handle, regex);
+	return 1;
+}
+
+int elektraMathcheckClose (Plugin * handle, Key * errorKey ELEKTRA_UNUSED)
+{
+	regex_t * regex = elektraPluginGetData (handle);
+	if (regex)
+	{
+		regfree (regex);
+		elektraFree (regex);
+		elektraPluginSetData (handle, NULL);
+	}
+	return 1;
+}
+
+int elektraMathcheckSet (Plugin * handle, KeySet * returned, Key * parentKey)
 {
+	const regex_t * regex = elektraPluginGetData (handle);
 	Key * cur;
 	PNElem result;
 	while ((cur = ksNext (returned)) != NULL)
@@ -383,7 +404,7 @@ int elektraMathcheckSet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 		const Key * meta = keyGetMeta (cur, "check/math");
 		if (!meta) continue;
 		ELEKTRA_LOG_DEBUG ("Check key “%s” with value “%s”", keyName (cur), keyString (meta));
-		result = parsePrefixString (keyString (meta), cur, ksDup (returned), parentKey);
+		result = parsePrefixString (regex, keyString (meta), cur, ksDup (returned), parentKey);
 		ELEKTRA_LOG_DEBUG ("Result: “%f”", result.value);
 		char val1[MAX_CHARS_DOUBLE + 1]; // Include storage for trailing `\0` character
 		char val2[MAX_CHARS_DOUBLE];
@@ -455,6 +476,8 @@ Plugin * ELEKTRA_PLUGIN_EXPORT
 {
 	// clang-format off
 	return elektraPluginExport("mathcheck",
+			ELEKTRA_PLUGIN_OPEN,	&elektraMathcheckOpen,
+			ELEKTRA_PLUGIN_CLOSE,	&elektraMathcheckClose,
 			ELEKTRA_PLUGIN_GET,	&elektraMathcheckGet,
 			ELEKTRA_PLUGIN_SET,	&elektraMathcheckSet,
 			ELEKTRA_PLUGIN_END);
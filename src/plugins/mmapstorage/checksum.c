@@ -0,0 +1,296 @@
+/**
+ * @file
+ *
+ * @brief Source for the chunked checksum of mmapstorage files.
+ *
+ * The checksummed region is split into chunks of `ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE` bytes.
+ * Every chunk is hashed independently with XXH64, seeded with the index of the chunk.
+ * The hashes of all chunks are then combined in order and folded into 32 bits.
+ *
+ * Hashing reads eight bytes at once and does not depend on the previous chunk, which
+ * makes it much faster than a bytewise CRC32 and allows to verify large regions with
+ * multiple threads. The result does not depend on the number of threads.
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ *
+ */
+
+#include "checksum.h"
+
+#include <kdbhelper.h>
+
+#ifdef HAVE_KDBCONFIG_H
+#include "kdbconfig.h"
+#endif
+
+#include <string.h> // memcpy()
+#include <unistd.h> // sysconf()
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+/* -- XXH64 ----------------------------------------------------------------------------------------------------------------------------- */
+
+#define PRIME64_1 (0x9E3779B185EBCA87ULL)
+#define PRIME64_2 (0xC2B2AE3D27D4EB4FULL)
+#define PRIME64_3 (0x165667B19E3779F9ULL)
+#define PRIME64_4 (0x85EBCA77C2B2AE63ULL)
+#define PRIME64_5 (0x27D4EB2F165667C5ULL)
+
+static inline uint64_t rotl64 (uint64_t x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t read64 (const char * p)
+{
+	uint64_t v;
+	memcpy (&v, p, sizeof (v));
+	return v;
+}
+
+static inline uint32_t read32 (const char * p)
+{
+	uint32_t v;
+	memcpy (&v, p, sizeof (v));
+	return v;
+}
+
+static inline uint64_t round64 (uint64_t acc, uint64_t input)
+{
+	acc += input * PRIME64_2;
+	acc = rotl64 (acc, 31);
+	return acc * PRIME64_1;
+}
+
+static inline uint64_t mergeRound64 (uint64_t acc, uint64_t val)
+{
+	acc ^= round64 (0, val);
+	return acc * PRIME64_1 + PRIME64_4;
+}
+
+static inline uint64_t avalanche64 (uint64_t h)
+{
+	h ^= h >> 33;
+	h *= PRIME64_2;
+	h ^= h >> 29;
+	h *= PRIME64_3;
+	h ^= h >> 32;
+	return h;
+}
+
+/**
+ * @brief XXH64 of a memory region, with native byte order.
+ *
+ * @param p start of the region
+ * @param len size of the region in bytes
+ * @param seed the seed of the hash
+ *
+ * @return the hash
+ */
+static uint64_t hash64 (const char * p, size_t len, uint64_t seed)
+{
+	const char * const end = p + len;
+	uint64_t h;
+
+	if (len >= 32)
+	{
+		const char * const limit = end - 32;
+		uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+		uint64_t v2 = seed + PRIME64_2;
+		uint64_t v3 = seed;
+		uint64_t v4 = seed - PRIME64_1;
+
+		do
+		{
+			v1 = round64 (v1, read64 (p));
+			v2 = round64 (v2, read64 (p + 8));
+			v3 = round64 (v3, read64 (p + 16));
+			v4 = round64 (v4, read64 (p + 24));
+			p += 32;
+		} while (p <= limit);
+
+		h = rotl64 (v1, 1) + rotl64 (v2, 7) + rotl64 (v3, 12) + rotl64 (v4, 18);
+		h = mergeRound64 (h, v1);
+		h = mergeRound64 (h, v2);
+		h = mergeRound64 (h, v3);
+		h = mergeRound64 (h, v4);
+	}
+	else
+	{
+		h = seed + PRIME64_5;
+	}
+
+	h += (uint64_t) len;
+
+	for (; p + 8 <= end; p += 8)
+	{
+		h ^= round64 (0, read64 (p));
+		h = rotl64 (h, 27) * PRIME64_1 + PRIME64_4;
+	}
+	if (p + 4 <= end)
+	{
+		h ^= (uint64_t) read32 (p) * PRIME64_1;
+		h = rotl64 (h, 23) * PRIME64_2 + PRIME64_3;
+		p += 4;
+	}
+	for (; p < end; ++p)
+	{
+		h ^= (*(const unsigned char *) p) * PRIME64_5;
+		h = rotl64 (h, 11) * PRIME64_1;
+	}
+
+	return avalanche64 (h);
+}
+
+/* -- Chunks ---------------------------------------------------------------------------------------------------------------------------- */
+
+/**
+ * Range of chunks, hashed by one thread.
+ */
+typedef struct
+{
+	const char * data; /**<Start of the checksummed region */
+	size_t size;	   /**<Size of the checksummed region */
+	size_t first;	   /**<Index of the first chunk to hash */
+	size_t last;	   /**<Index after the last chunk to hash */
+	uint64_t * hashes; /**<Hashes of all chunks, indexed by chunk */
+} ChunkRange;
+
+/**
+ * @brief Hashes a single chunk.
+ *
+ * @param data start of the checksummed region
+ * @param size size of the checksummed region
+ * @param chunk index of the chunk
+ *
+ * @return the hash of the chunk
+ */
+static uint64_t hashChunk (const char * data, size_t size, size_t chunk)
+{
+	size_t offset = chunk * ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE;
+	size_t len = size - offset < ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE ? size - offset : ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE;
+	return hash64 (data + offset, len, chunk);
+}
+
+static void * hashChunkRange (void * arg)
+{
+	ChunkRange * range = arg;
+	for (size_t i = range->first; i < range->last; ++i)
+	{
+		range->hashes[i] = hashChunk (range->data, range->size, i);
+	}
+	return 0;
+}
+
+/**
+ * @brief Hashes all chunks with multiple threads.
+ *
+ * The calling thread hashes the first range of chunks itself.
+ * If a thread cannot be started, its range is hashed by the calling thread, too.
+ *
+ * @param data start of the checksummed region
+ * @param size size of the checksummed region
+ * @param chunks number of chunks
+ * @param threads number of threads, at most `ELEKTRA_MMAP_CHECKSUM_MAXTHREADS`
+ * @param hashes array for the hashes of all chunks
+ */
+static void hashChunksParallel (const char * data, size_t size, size_t chunks, size_t threads, uint64_t * hashes)
+{
+	ChunkRange ranges[ELEKTRA_MMAP_CHECKSUM_MAXTHREADS];
+	size_t perThread = (chunks + threads - 1) / threads;
+	for (size_t t = 0; t < threads; ++t)
+	{
+		ranges[t].data = data;
+		ranges[t].size = size;
+		ranges[t].first = t * perThread < chunks ? t * perThread : chunks;
+		ranges[t].last = (t + 1) * perThread < chunks ? (t + 1) * perThread : chunks;
+		ranges[t].hashes = hashes;
+	}
+
+#ifdef HAVE_PTHREAD_H
+	pthread_t tids[ELEKTRA_MMAP_CHECKSUM_MAXTHREADS];
+	int started[ELEKTRA_MMAP_CHECKSUM_MAXTHREADS] = { 0 };
+	for (size_t t = 1; t < threads; ++t)
+	{
+		started[t] = pthread_create (&tids[t], 0, hashChunkRange, &ranges[t]) == 0;
+	}
+	hashChunkRange (&ranges[0]);
+	for (size_t t = 1; t < threads; ++t)
+	{
+		if (started[t])
+		{
+			pthread_join (tids[t], 0);
+		}
+		else
+		{
+			hashChunkRange (&ranges[t]);
+		}
+	}
+#else
+	for (size_t t = 0; t < threads; ++t)
+	{
+		hashChunkRange (&ranges[t]);
+	}
+#endif
+}
+
+/* -- Checksum -------------------------------------------------------------------------------------------------------------------------- */
+
+/**
+ * @brief Number of threads to use for the checksum of a region.
+ *
+ * @param size size of the checksummed region
+ *
+ * @return 1 for small regions, otherwise the number of online processors,
+ * at most `ELEKTRA_MMAP_CHECKSUM_MAXTHREADS`
+ */
+size_t ELEKTRA_PLUGIN_FUNCTION (checksumThreads) (size_t size)
+{
+#ifdef HAVE_PTHREAD_H
+	if (size < ELEKTRA_MMAP_CHECKSUM_PARALLEL_MINSIZE) return 1;
+
+	long processors = sysconf (_SC_NPROCESSORS_ONLN);
+	if (processors < 1) return 1;
+	if (processors > ELEKTRA_MMAP_CHECKSUM_MAXTHREADS) return ELEKTRA_MMAP_CHECKSUM_MAXTHREADS;
+	return (size_t) processors;
+#else
+	(void) size;
+	return 1;
+#endif
+}
+
+/**
+ * @brief Calculates the chunked checksum of a region.
+ *
+ * @param data start of the region
+ * @param size size of the region in bytes
+ * @param threads number of threads to use, see checksumThreads()
+ *
+ * @return the checksum, which is the same for any number of threads
+ */
+uint32_t ELEKTRA_PLUGIN_FUNCTION (checksum) (const char * data, size_t size, size_t threads)
+{
+	size_t chunks = (size + ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE - 1) / ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE;
+	if (threads > ELEKTRA_MMAP_CHECKSUM_MAXTHREADS) threads = ELEKTRA_MMAP_CHECKSUM_MAXTHREADS;
+	if (threads > chunks) threads = chunks;
+
+	uint64_t * hashes = 0;
+	if (threads > 1 && (hashes = elektraMalloc (chunks * sizeof (uint64_t))) != 0)
+	{
+		hashChunksParallel (data, size, chunks, threads, hashes);
+	}
+
+	uint64_t h = PRIME64_5 + (uint64_t) size;
+	for (size_t i = 0; i < chunks; ++i)
+	{
+		uint64_t chunkHash = hashes ? hashes[i] : hashChunk (data, size, i);
+		h ^= round64 (0, chunkHash);
+		h = rotl64 (h, 27) * PRIME64_1 + PRIME64_4;
+	}
+	elektraFree (hashes);
+
+	h = avalanche64 (h);
+	return (uint32_t) (h ^ (h >> 32));
+}
@@ -0,0 +1,30 @@
+/**
+ * @file
+ *
+ * @brief Header for the chunked checksum of mmapstorage files.
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ *
+ */
+#ifndef ELEKTRA_MMAPSTORAGE_CHECKSUM_H
+#define ELEKTRA_MMAPSTORAGE_CHECKSUM_H
+
+#include <kdbplugin.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Size of the chunks, which are hashed independently */
+#define ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE (256 * 1024)
+
+/** Regions smaller than this are always hashed by the calling thread */
+#define ELEKTRA_MMAP_CHECKSUM_PARALLEL_MINSIZE (16 * 1024 * 1024)
+
+/** Maximum number of threads used for hashing a region */
+#define ELEKTRA_MMAP_CHECKSUM_MAXTHREADS (8)
+
+// checksum functions
+size_t ELEKTRA_PLUGIN_FUNCTION (checksumThreads) (size_t size);
+uint32_t ELEKTRA_PLUGIN_FUNCTION (checksum) (const char * data, size_t size, size_t threads);
+
+#endif
@@ -10,6 +10,8 @@
 #ifndef ELEKTRA_PLUGIN_MMAPSTORAGE_INTERNAL_H
 #define ELEKTRA_PLUGIN_MMAPSTORAGE_INTERNAL_H
 
+#include <stdint.h> // uintptr_t, UINTPTR_MAX
+
 #define SIZEOF_KEY (sizeof (Key))
 #define SIZEOF_KEY_PTR (sizeof (Key *))
 #define SIZEOF_KEYSET (sizeof (KeySet))
@@ -53,11 +55,27 @@
 /** Magic byte order marker, as used by UTF. */
 #define ELEKTRA_MMAP_MAGIC_BOM (0xFEFF)
 
-/** Magic number used in mmap format (8 bytes). Previously used: 0x0A6172746B656C45 */
-#define ELEKTRA_MAGIC_MMAP_NUMBER (0x0A3472746B656C45)
+/** Magic number used in mmap format (8 bytes). Previously used: 0x0A6172746B656C45, 0x0A3472746B656C45 */
+#define ELEKTRA_MAGIC_MMAP_NUMBER (0x0A3572746B656C45)
 
 /** Mmap format version (1 byte). Increment on breaking changes to invalidate old files. */
-#define ELEKTRA_MMAP_FORMAT_VERSION (2)
+#define ELEKTRA_MMAP_FORMAT_VERSION (3)
+
+/**
+ * Range of addresses, for which the pointers of a new file are written.
+ * If the file can be mapped to that address again, no pointers have to be updated.
+ * The range is far away from heap and shared libraries, on systems with 64-bit pointers.
+ */
+#if UINTPTR_MAX > 0xFFFFFFFF
+#define ELEKTRA_MMAP_ADDR_MIN ((uintptr_t) 0x200000000000)
+#define ELEKTRA_MMAP_ADDR_RANGE ((uintptr_t) 0x400000000000)
+#else
+#define ELEKTRA_MMAP_ADDR_MIN ((uintptr_t) 0)
+#define ELEKTRA_MMAP_ADDR_RANGE ((uintptr_t) 0)
+#endif
+
+/** Alignment of the address above, 2 MiB are a multiple of all common page sizes */
+#define ELEKTRA_MMAP_ADDR_ALIGN ((uintptr_t) 0x200000)
 
 /** Mmap temp file template */
 #define ELEKTRA_MMAP_TMP_NAME "/tmp/elektraMmapTmpXXXXXX"
@@ -91,6 +109,9 @@
 /** Defines whether file was written with opmphm data structures. */
 #define MMAP_FLAG_OPMPHM (1 << 2)
 
+/** Defines whether the checksum (see `MMAP_FLAG_CHECKSUM`) is the chunked checksum of checksum.c instead of CRC32. */
+#define MMAP_FLAG_CHECKSUM_CHUNKED (1 << 3)
+
 /**
  * Internal MmapAddr structure.
  * Used for functions passing around relevant pointers into the mmap region.
@@ -167,6 +188,7 @@ struct _mmapMetaData
 	size_t numKeySets;	/**<Number of KeySets inlcuding meta KS */
 	size_t ksAlloc;		/**<Sum of all KeySet->alloc sizes */
 	size_t numKeys;		/**<Number of Keys including meta Keys */
+	uintptr_t mmapAddr;	/**<Address of the mapped region the pointers were written for */
 	// clang-format on
 };
 
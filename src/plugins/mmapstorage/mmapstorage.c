@@ -34,10 +34,11 @@
 #include <sys/mman.h>  // mmap()
 #include <sys/stat.h>  // stat(), fstat()
 #include <sys/types.h> // ftruncate (), size_t
-#include <unistd.h>    // close(), ftruncate(), unlink(), read(), write()
+#include <time.h>      // time()
+#include <unistd.h>    // close(), ftruncate(), unlink(), read(), pread(), write()
 
 #ifdef ELEKTRA_MMAP_CHECKSUM
-#include <zlib.h> // crc32()
+#include "checksum.h"
 #endif
 
 /* -- Global declarations---------------------------------------------------------------------------------------------------------------- */
@@ -168,6 +169,47 @@ static char * mmapFile (void * addr, int fd, size_t mmapSize, int mapOpts, Key *
 	return mappedRegion;
 }
 
+/**
+ * @brief Chooses the address, for which the pointers of a new file are written.
+ *
+ * Every written file gets another address, such that a process still using
+ * the mapping of an old file can map the new file to its address, too.
+ *
+ * @param mappedRegion the region the file is written to, as additional entropy
+ *
+ * @return an address within the range given by `ELEKTRA_MMAP_ADDR_MIN` and `ELEKTRA_MMAP_ADDR_RANGE`,
+ * or 0 if there is no such range on this system
+ */
+static uintptr_t generateMmapAddr (const char * mappedRegion)
+{
+	if (ELEKTRA_MMAP_ADDR_RANGE == 0) return 0;
+
+	// mix the inputs, see splitmix64
+	uint64_t z = (uint64_t) (uintptr_t) mappedRegion ^ ((uint64_t) time (0) << 20) ^ (uint64_t) getpid ();
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	z ^= z >> 31;
+
+	return ELEKTRA_MMAP_ADDR_MIN + (((uintptr_t) z % (ELEKTRA_MMAP_ADDR_RANGE / ELEKTRA_MMAP_ADDR_ALIGN)) * ELEKTRA_MMAP_ADDR_ALIGN);
+}
+
+/**
+ * @brief Reads the address, for which the pointers of a file were written.
+ *
+ * Only a hint for mmap(), the file is not verified yet.
+ *
+ * @param fd file descriptor of the file to be mapped
+ *
+ * @return the address or 0 if it could not be read
+ */
+static uintptr_t readMmapAddr (int fd)
+{
+	MmapMetaData mmapMetaData;
+	if (pread (fd, &mmapMetaData, SIZEOF_MMAPMETADATA, OFFSET_MMAPMETADATA) != (ssize_t) SIZEOF_MMAPMETADATA) return 0;
+	if (mmapMetaData.mmapAddr % ELEKTRA_MMAP_ADDR_ALIGN != 0) return 0;
+	return mmapMetaData.mmapAddr;
+}
+
 
 /**
  * @brief Copy file
@@ -277,7 +319,7 @@ static void initHeader (MmapHeader * mmapHeader)
 	mmapHeader->mmapMagicNumber = ELEKTRA_MAGIC_MMAP_NUMBER;
 	mmapHeader->formatVersion = ELEKTRA_MMAP_FORMAT_VERSION;
 #ifdef ELEKTRA_MMAP_CHECKSUM
-	set_bit (mmapHeader->formatFlags, MMAP_FLAG_CHECKSUM);
+	set_bit (mmapHeader->formatFlags, MMAP_FLAG_CHECKSUM | MMAP_FLAG_CHECKSUM_CHUNKED);
 #endif
 #ifdef ELEKTRA_ENABLE_OPTIMIZATIONS
 	set_bit (mmapHeader->formatFlags, MMAP_FLAG_OPMPHM);
@@ -441,6 +483,7 @@ static void initMagicMmapMetaData (void)
 	magicMmapMetaData.numKeySets = SIZE_MAX;
 	magicMmapMetaData.ksAlloc = 0;
 	magicMmapMetaData.numKeys = SIZE_MAX / 2;
+	magicMmapMetaData.mmapAddr = UINTPTR_MAX / 4;
 }
 
 #ifdef ELEKTRA_ENABLE_OPTIMIZATIONS
@@ -580,9 +623,13 @@ static int verifyMagicData (char * mappedRegion)
 /**
  * @brief Verify checksum of the critical mmap data.
  *
- * Verifies the CRC32 checksum of all KeySet and Key structs (including pointers/pointer arrays)
+ * Verifies the checksum of all KeySet and Key structs (including pointers/pointer arrays)
  * as well as the MmapMetaData. Does not check Key name and value.
  *
+ * The chunked checksum is verified with multiple threads for large files. Files flagged with
+ * `MMAP_FLAG_CHECKSUM` but without `MMAP_FLAG_CHECKSUM_CHUNKED` are not written by this format
+ * version and are treated as a mismatch.
+ *
  * @param mappedRegion pointer to mapped region
  * @param mmapHeader containing the stored checksum and size of the checksum region
  *
@@ -594,8 +641,14 @@ static int verifyChecksum (char * mappedRegion, MmapHeader * mmapHeader, PluginM
 	// if file was written without checksum, we skip the check
 	if (!test_bit (mmapHeader->formatFlags, MMAP_FLAG_CHECKSUM)) return 0;
 
-	uint32_t checksum = crc32 (0L, Z_NULL, 0);
-	checksum = crc32 (checksum, (const unsigned char *) (mappedRegion + SIZEOF_MMAPHEADER), mmapHeader->cksumSize);
+	if (!test_bit (mmapHeader->formatFlags, MMAP_FLAG_CHECKSUM_CHUNKED))
+	{
+		ELEKTRA_MMAP_LOG_WARNING ("unknown checksum type");
+		return -1;
+	}
+
+	uint32_t checksum = ELEKTRA_PLUGIN_FUNCTION (checksum) (mappedRegion + SIZEOF_MMAPHEADER, mmapHeader->cksumSize,
+								ELEKTRA_PLUGIN_FUNCTION (checksumThreads) (mmapHeader->cksumSize));
 
 	if (checksum != mmapHeader->checksum)
 	{
@@ -607,6 +660,24 @@ static int verifyChecksum (char * mappedRegion, MmapHeader * mmapHeader, PluginM
 }
 #endif
 
+#ifdef ELEKTRA_ENABLE_OPTIMIZATIONS
+/**
+ * @brief Returns the OPMPHM to store with the KeySet.
+ *
+ * An OPMPHM with pending changes in its delta does not match the stored keys,
+ * so it is not stored and the OPMPHM is rebuilt on demand after reading.
+ *
+ * @param ks the KeySet that should be stored
+ *
+ * @return the OPMPHM to store or NULL
+ */
+static Opmphm * storedOpmphm (KeySet * ks)
+{
+	if (ks->opmphmDelta && ks->opmphmDelta->size) return 0;
+	return ks->opmphm;
+}
+#endif
+
 /**
  * @brief Calculates the size, in bytes, needed to store the KeySet in a mmap region.
  *
@@ -694,7 +765,7 @@ static void calculateMmapDataSize (MmapHeader * mmapHeader, MmapMetaData * mmapM
 	// the OPMPHM structs are included regardless of existece in KeySet
 	// s.t. the format stays the same for all KeySets
 	opmphmSize = (sizeof (Opmphm) * 2) + (sizeof (OpmphmPredictor) * 2); // *2 for magic opmphm data
-	Opmphm * opmphm = returned->opmphm;
+	Opmphm * opmphm = storedOpmphm (returned);
 	if (opmphm)
 	{
 		if (opmphm->rUniPar) dataBlocksSize += opmphm->rUniPar * sizeof (int32_t);
@@ -775,6 +846,7 @@ static void writeMetaKeys (MmapAddr * mmapAddr, DynArray * dynArray)
 		}
 
 		// move Key itself
+		clear_bit (mmapMetaKey->flags, (keyflag_t) KEY_FLAG_ARENA);
 		mmapMetaKey->flags |= KEY_FLAG_MMAP_STRUCT;
 		mmapMetaKey->meta = 0;
 		mmapMetaKey->ksReference = 0;
@@ -804,20 +876,18 @@ static KeySet * writeMetaKeySet (Key * key, MmapAddr * mmapAddr, DynArray * dynA
 	newMeta->array = (Key **) mmapAddr->metaKsArrayPtr;
 	mmapAddr->metaKsArrayPtr += SIZEOF_KEY_PTR * key->meta->alloc;
 
-	keyRewindMeta (key);
-	size_t metaKeyIndex = 0;
+	// iterate without the cursor, which would give the key its own copy of shared metadata
 	Key * mappedMetaKey = 0;
-	const Key * metaKey;
-	while ((metaKey = keyNextMeta (key)) != 0)
+	for (size_t metaKeyIndex = 0; metaKeyIndex < key->meta->size; ++metaKeyIndex)
 	{
 		// get address of mapped key and store it in the new array
-		mappedMetaKey = dynArray->mappedKeyArray[ELEKTRA_PLUGIN_FUNCTION (dynArrayFind) ((Key *) metaKey, dynArray)];
+		Key * metaKey = key->meta->array[metaKeyIndex];
+		mappedMetaKey = dynArray->mappedKeyArray[ELEKTRA_PLUGIN_FUNCTION (dynArrayFind) (metaKey, dynArray)];
 		newMeta->array[metaKeyIndex] = (Key *) ((char *) mappedMetaKey - mmapAddr->mmapAddrInt);
 		if (mappedMetaKey->ksReference < SSIZE_MAX)
 		{
 			++(mappedMetaKey->ksReference);
 		}
-		++metaKeyIndex;
 	}
 	newMeta->array[key->meta->size] = 0;
 	newMeta->array = (Key **) ((char *) newMeta->array - mmapAddr->mmapAddrInt);
@@ -895,6 +965,7 @@ static void writeKeys (KeySet * keySet, MmapAddr * mmapAddr, DynArray * dynArray
 		mmapKey->meta = writeMetaKeySet (cur, mmapAddr, dynArray);
 
 		// move Key itself
+		clear_bit (mmapKey->flags, (keyflag_t) KEY_FLAG_ARENA);
 		mmapKey->flags |= KEY_FLAG_MMAP_STRUCT;
 		mmapKey->ksReference = 1;
 
@@ -923,6 +994,7 @@ static void printMmapMetaData (MmapMetaData * mmapMetaData ELEKTRA_UNUSED)
 	ELEKTRA_LOG_DEBUG ("numKeySets: \t %lu", mmapMetaData->numKeySets);
 	ELEKTRA_LOG_DEBUG ("ksAlloc: \t %lu", mmapMetaData->ksAlloc);
 	ELEKTRA_LOG_DEBUG ("numKeys: \t %lu", mmapMetaData->numKeys);
+	ELEKTRA_LOG_DEBUG ("mmapAddr: \t %p", (void *) mmapMetaData->mmapAddr);
 }
 
 
@@ -961,7 +1033,7 @@ static int copyKeySetToMmap (char * const dest, KeySet * keySet, KeySet * global
 			      .metaKsArrayPtr = mmapAddr.ksArrayPtr + (SIZEOF_KEY_PTR * keySet->alloc),
 			      .keyPtr = mmapAddr.globalKsArrayPtr + (SIZEOF_KEY_PTR * mmapMetaData->ksAlloc),
 			      .dataPtr = mmapAddr.keyPtr + (SIZEOF_KEY * mmapMetaData->numKeys),
-			      .mmapAddrInt = (uintptr_t) dest };
+			      .mmapAddrInt = (uintptr_t) dest - mmapMetaData->mmapAddr };
 
 	printMmapAddr (&mmapAddr);
 	printMmapMetaData (mmapMetaData);
@@ -970,7 +1042,7 @@ static int copyKeySetToMmap (char * const dest, KeySet * keySet, KeySet * global
 	// We FIRST write the opmphm data. If this is changed, you'll run into alignment problems.
 	// set OPMPHM flag, so file is not readable by builds without OPMPHM
 	set_bit (mmapHeader->formatFlags, MMAP_FLAG_OPMPHM);
-	if (keySet->opmphm)
+	if (storedOpmphm (keySet))
 	{
 		mmapAddr.ksPtr->opmphm = (Opmphm *) (dest + OFFSET_OPMPHM);
 		memcpy (mmapAddr.ksPtr->opmphm, keySet->opmphm, sizeof (Opmphm));
@@ -1043,9 +1115,8 @@ static int copyKeySetToMmap (char * const dest, KeySet * keySet, KeySet * global
 
 	memcpy ((dest + OFFSET_MMAPMETADATA), mmapMetaData, SIZEOF_MMAPMETADATA);
 #ifdef ELEKTRA_MMAP_CHECKSUM
-	uint32_t checksum = crc32 (0L, Z_NULL, 0);
-	checksum = crc32 (checksum, (const unsigned char *) (dest + SIZEOF_MMAPHEADER), mmapHeader->cksumSize);
-	mmapHeader->checksum = checksum;
+	mmapHeader->checksum = ELEKTRA_PLUGIN_FUNCTION (checksum) (dest + SIZEOF_MMAPHEADER, mmapHeader->cksumSize,
+								   ELEKTRA_PLUGIN_FUNCTION (checksumThreads) (mmapHeader->cksumSize));
 #endif
 	memcpy (dest, mmapHeader, SIZEOF_MMAPHEADER);
 
@@ -1148,16 +1219,19 @@ static void mmapToKeySet (Plugin * handle, char * mappedRegion, KeySet * returne
  * @brief Updates pointers of a mapped keyset to a new location in memory.
  *
  * After mapping a file to a new location, all pointers have to be updated
- * in order to be consistent. When the mapped keyset is written, we subtract
- * the base address. Therefore, after mapping the keyset to a new memory location,
- * we only have to add the new base address to all pointers.
+ * in order to be consistent. When the mapped keyset is written, the pointers
+ * are written for the address `mmapMetaData->mmapAddr`. Therefore, after mapping
+ * the keyset to a different memory location, we only have to add the difference
+ * of both addresses to all pointers.
+ *
+ * Not needed if the file was mapped to `mmapMetaData->mmapAddr`.
  *
  * @param mmapMetaData meta-data of the old mapped region
  * @param dest new mapped memory region
  */
 static void updatePointers (MmapMetaData * mmapMetaData, char * dest)
 {
-	uintptr_t destInt = (uintptr_t) dest;
+	uintptr_t destInt = (uintptr_t) dest - mmapMetaData->mmapAddr;
 
 	char * ksPtr = (dest + OFFSET_GLOBAL_KEYSET);
 	char * ksArrayPtr = ksPtr + SIZEOF_KEYSET * mmapMetaData->numKeySets;
@@ -1376,7 +1450,8 @@ int ELEKTRA_PLUGIN_FUNCTION (get) (Plugin * handle ELEKTRA_UNUSED, KeySet * ks,
 		goto error;
 	}
 
-	mappedRegion = mmapFile ((void *) 0, fd, sbuf.st_size, MAP_PRIVATE, parentKey, mode);
+	// try to map the file to the address it was written for, to avoid updating all pointers
+	mappedRegion = mmapFile ((void *) readMmapAddr (fd), fd, sbuf.st_size, MAP_PRIVATE, parentKey, mode);
 	if (mappedRegion == MAP_FAILED)
 	{
 		ELEKTRA_MMAP_LOG_WARNING ("mappedRegion == MAP_FAILED");
@@ -1440,7 +1515,12 @@ int ELEKTRA_PLUGIN_FUNCTION (get) (Plugin * handle ELEKTRA_UNUSED, KeySet * ks,
 		goto error;
 	}
 
-	updatePointers (mmapMetaData, mappedRegion);
+	if ((uintptr_t) mappedRegion != mmapMetaData->mmapAddr)
+	{
+		ELEKTRA_LOG_DEBUG ("file mapped to %p instead of %p, updating pointers", (void *) mappedRegion,
+				   (void *) mmapMetaData->mmapAddr);
+		updatePointers (mmapMetaData, mappedRegion);
+	}
 	mmapToKeySet (handle, mappedRegion, ks, mode);
 
 	if (close (fd) != 0)
@@ -1555,6 +1635,8 @@ int ELEKTRA_PLUGIN_FUNCTION (set) (Plugin * handle ELEKTRA_UNUSED, KeySet * ks,
 		goto error;
 	}
 
+	mmapMetaData.mmapAddr = generateMmapAddr (mappedRegion);
+
 	MmapFooter mmapFooter;
 	initFooter (&mmapFooter);
 	if (copyKeySetToMmap (mappedRegion, ks, global, &mmapHeader, &mmapMetaData, &mmapFooter, dynArray, mode) != 0)
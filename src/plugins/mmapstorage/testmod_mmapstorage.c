@@ -577,6 +577,58 @@ static void test_mmap_set_get_large_keyset (const char * tmpFile)
 	PLUGIN_CLOSE ();
 }
 
+static void test_mmap_mmap_addr (const char * tmpFile)
+{
+	Key * parentKey = keyNew (TEST_ROOT_KEY, KEY_VALUE, tmpFile, KEY_END);
+	KeySet * conf = ksNew (0, KS_END);
+	PLUGIN_OPEN ("mmapstorage");
+	KeySet * ks = metaTestKeySet ();
+	succeed_if (plugin->kdbSet (plugin, ks, parentKey) == 1, "kdbSet was not successful");
+
+	struct stat sbuf;
+	MmapMetaData mmapMetaData;
+	FILE * fp = fopen (tmpFile, "r");
+	exit_if_fail (fp && stat (tmpFile, &sbuf) == 0, "could not open written file");
+	succeed_if (pread (fileno (fp), &mmapMetaData, SIZEOF_MMAPMETADATA, OFFSET_MMAPMETADATA) == (ssize_t) SIZEOF_MMAPMETADATA,
+		    "could not read meta-data");
+	fclose (fp);
+	succeed_if (mmapMetaData.mmapAddr % ELEKTRA_MMAP_ADDR_ALIGN == 0, "address not aligned");
+
+	// first mapping: at the address the file was written for, if that is possible on this system
+	KeySet * returned = ksNew (0, KS_END);
+	succeed_if (plugin->kdbGet (plugin, returned, parentKey) == 1, "kdbGet was not successful");
+	if (ELEKTRA_MMAP_ADDR_RANGE != 0)
+	{
+		succeed_if ((uintptr_t) returned->array > mmapMetaData.mmapAddr &&
+				    (uintptr_t) returned->array < mmapMetaData.mmapAddr + (uintptr_t) sbuf.st_size,
+			    "file not mapped to the address it was written for");
+	}
+	compare_keyset (ks, returned);
+
+	// second mapping: the address is still in use, so the pointers are updated
+	KeySet * relocated = ksNew (0, KS_END);
+	succeed_if (plugin->kdbGet (plugin, relocated, parentKey) == 1, "kdbGet was not successful");
+	succeed_if ((uintptr_t) relocated->array < mmapMetaData.mmapAddr ||
+			    (uintptr_t) relocated->array >= mmapMetaData.mmapAddr + (uintptr_t) sbuf.st_size,
+		    "file mapped to the same address twice");
+	compare_keyset (ks, relocated);
+
+	// modifying mapped keys copies them
+	Key * found = ksLookupByName (returned, "user:/tests/mmapstorage/a", 0);
+	exit_if_fail (found, "could not find key");
+	succeed_if (keySetString (found, "a modified value") > 0, "could not set value");
+	succeed_if (keySetMeta (found, "ab", "modified meta") > 0, "could not set meta");
+	succeed_if_same_string (keyString (found), "a modified value");
+	succeed_if_same_string (keyString (keyGetMeta (found, "ab")), "modified meta");
+	succeed_if_same_string (keyString (ksLookupByName (relocated, "user:/tests/mmapstorage/a", 0)), "a value");
+
+	ksDel (relocated);
+	ksDel (returned);
+	ksDel (ks);
+	keyDel (parentKey);
+	PLUGIN_CLOSE ();
+}
+
 static void test_mmap_ks_copy (const char * tmpFile)
 {
 	Key * parentKey = keyNew (TEST_ROOT_KEY, KEY_VALUE, tmpFile, KEY_END);
@@ -1130,6 +1182,7 @@ int main (int argc, char ** argv)
 	test_mmap_set_get (tmpFile);
 	test_mmap_get_after_reopen (tmpFile);
 	test_mmap_set_get_large_keyset (tmpFile);
+	test_mmap_mmap_addr (tmpFile);
 	test_mmap_ks_copy (tmpFile);
 
 	clearStorage (tmpFile);
@@ -16,6 +16,7 @@
 
 #include <tests_plugin.h>
 
+#include "checksum.h"
 #include "internal.h"
 #include "mmapstorage.h"
 
@@ -25,6 +26,162 @@
 
 /* -- Functions ------------------------------------------------------------------------------------------------------------------------- */
 
+static char * mapFile (const char * tmpFile, struct stat * sbuf)
+{
+	FILE * fp;
+	if ((fp = fopen (tmpFile, "r+")) == 0)
+	{
+		yield_error ("fopen() error");
+		return 0;
+	}
+	if (stat (tmpFile, sbuf) == -1)
+	{
+		yield_error ("stat() error");
+		fclose (fp);
+		return 0;
+	}
+
+	char * mappedRegion = mmap (0, sbuf->st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fileno (fp), 0);
+	fclose (fp);
+	if (mappedRegion == MAP_FAILED)
+	{
+		yield_error ("mmap() error");
+		return 0;
+	}
+	return mappedRegion;
+}
+
+static void unmapFile (char * mappedRegion, struct stat * sbuf)
+{
+	succeed_if (msync ((void *) mappedRegion, sbuf->st_size, MS_SYNC) == 0, "msync() error");
+	succeed_if (munmap (mappedRegion, sbuf->st_size) == 0, "munmap() error");
+}
+
+static void test_mmap_crc_chunked_checksum (void)
+{
+	// three and a half chunks
+	size_t size = ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE * 3 + ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE / 2;
+	char * data = elektraMalloc (size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		data[i] = (char) (i * 31 + i / 4096);
+	}
+
+	uint32_t checksum = ELEKTRA_PLUGIN_FUNCTION (checksum) (data, size, 1);
+	for (size_t threads = 2; threads <= ELEKTRA_MMAP_CHECKSUM_MAXTHREADS + 1; ++threads)
+	{
+		succeed_if (ELEKTRA_PLUGIN_FUNCTION (checksum) (data, size, threads) == checksum, "checksum depends on number of threads");
+	}
+	succeed_if (ELEKTRA_PLUGIN_FUNCTION (checksum) (data, size - 1, 1) != checksum, "size not part of checksum");
+
+	// flip a single bit in the last chunk
+	data[size - 3] ^= 4;
+	succeed_if (ELEKTRA_PLUGIN_FUNCTION (checksum) (data, size, 2) != checksum, "changed data not detected");
+	data[size - 3] ^= 4;
+
+	// swap the first two chunks
+	char * tmp = elektraMalloc (ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE);
+	memcpy (tmp, data, ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE);
+	memcpy (data, data + ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE, ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE);
+	memcpy (data + ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE, tmp, ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE);
+	succeed_if (ELEKTRA_PLUGIN_FUNCTION (checksum) (data, size, 1) != checksum, "swapped chunks not detected");
+
+	succeed_if (ELEKTRA_PLUGIN_FUNCTION (checksumThreads) (0) == 1, "small regions should not use threads");
+
+	elektraFree (tmp);
+	elektraFree (data);
+}
+
+static void test_mmap_crc_corrupt_data (const char * tmpFile)
+{
+	// write a file with multiple chunks
+	{
+		Key * parentKey = keyNew (TEST_ROOT_KEY, KEY_VALUE, tmpFile, KEY_END);
+		KeySet * conf = ksNew (0, KS_END);
+		PLUGIN_OPEN ("mmapstorage_crc");
+
+		KeySet * ks = ksNew (0, KS_END);
+		char name[64];
+		for (size_t i = 0; i < 10000; ++i)
+		{
+			snprintf (name, sizeof (name), "%s/key%zu", TEST_ROOT_KEY, i);
+			ksAppendKey (ks, keyNew (name, KEY_VALUE, "value", KEY_END));
+		}
+		succeed_if (plugin->kdbSet (plugin, ks, parentKey) == 1, "kdbSet was not successful");
+
+		KeySet * returned = ksNew (0, KS_END);
+		succeed_if (plugin->kdbGet (plugin, returned, parentKey) == 1, "kdbGet was not successful");
+		succeed_if (ksGetSize (returned) == 10000, "wrong size");
+
+		keyDel (parentKey);
+		ksDel (returned);
+		ksDel (ks);
+		PLUGIN_CLOSE ();
+	}
+
+	struct stat sbuf;
+	char * mappedRegion = mapFile (tmpFile, &sbuf);
+	exit_if_fail (mappedRegion, "could not map file");
+	MmapHeader * mmapHeader = (MmapHeader *) mappedRegion;
+	succeed_if (test_bit (mmapHeader->formatFlags, MMAP_FLAG_CHECKSUM_CHUNKED), "file not written with chunked checksum");
+	succeed_if (mmapHeader->cksumSize > 2 * ELEKTRA_MMAP_CHECKSUM_CHUNKSIZE, "file too small for multiple chunks");
+	// change the last byte of the checksummed region
+	mappedRegion[SIZEOF_MMAPHEADER + mmapHeader->cksumSize - 1] ^= 1;
+	unmapFile (mappedRegion, &sbuf);
+
+	// changed data should be detected now
+	{
+		Key * parentKey = keyNew (TEST_ROOT_KEY, KEY_VALUE, tmpFile, KEY_END);
+		KeySet * conf = ksNew (0, KS_END);
+		PLUGIN_OPEN ("mmapstorage_crc");
+
+		KeySet * ks = ksNew (0, KS_END);
+		succeed_if (plugin->kdbGet (plugin, ks, parentKey) == ELEKTRA_PLUGIN_STATUS_ERROR, "kdbGet did not detect changed data");
+
+		keyDel (parentKey);
+		ksDel (ks);
+		PLUGIN_CLOSE ();
+	}
+}
+
+static void test_mmap_crc_unchunked_checksum (const char * tmpFile)
+{
+	// write a file, then clear the flag marking the chunked checksum
+	{
+		Key * parentKey = keyNew (TEST_ROOT_KEY, KEY_VALUE, tmpFile, KEY_END);
+		KeySet * conf = ksNew (0, KS_END);
+		PLUGIN_OPEN ("mmapstorage_crc");
+
+		KeySet * ks = ksNew (1, keyNew (TEST_ROOT_KEY "/key", KEY_VALUE, "value", KEY_END), KS_END);
+		succeed_if (plugin->kdbSet (plugin, ks, parentKey) == 1, "kdbSet was not successful");
+
+		keyDel (parentKey);
+		ksDel (ks);
+		PLUGIN_CLOSE ();
+	}
+
+	struct stat sbuf;
+	char * mappedRegion = mapFile (tmpFile, &sbuf);
+	exit_if_fail (mappedRegion, "could not map file");
+	MmapHeader * mmapHeader = (MmapHeader *) mappedRegion;
+	clear_bit (mmapHeader->formatFlags, MMAP_FLAG_CHECKSUM_CHUNKED);
+	unmapFile (mappedRegion, &sbuf);
+
+	// other checksum types are rejected
+	{
+		Key * parentKey = keyNew (TEST_ROOT_KEY, KEY_VALUE, tmpFile, KEY_END);
+		KeySet * conf = ksNew (0, KS_END);
+		PLUGIN_OPEN ("mmapstorage_crc");
+
+		KeySet * ks = ksNew (0, KS_END);
+		succeed_if (plugin->kdbGet (plugin, ks, parentKey) == ELEKTRA_PLUGIN_STATUS_ERROR, "kdbGet accepted unknown checksum type");
+
+		keyDel (parentKey);
+		ksDel (ks);
+		PLUGIN_CLOSE ();
+	}
+}
+
 static void test_mmap_crc_no_checksum (const char * tmpFile)
 {
 	// regression test: write mmap file without checksum (=0L), then read with checksum
@@ -138,6 +295,9 @@ int main (int argc, char ** argv)
 	const char * tmpFile = elektraFilename ();
 	test_mmap_crc_no_checksum (tmpFile);
 	test_mmap_crc_wrong_checksum (tmpFile);
+	test_mmap_crc_chunked_checksum ();
+	test_mmap_crc_corrupt_data (tmpFile);
+	test_mmap_crc_unchunked_checksum (tmpFile);
 
 	printf ("\ntestmod_mmapstorage_crc RESULTS: %d test(s) done. %d error(s).\n", nbTest, nbError);
 
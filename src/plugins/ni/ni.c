@@ -14,6 +14,7 @@
 
 #include <kdbease.h>
 #include <kdberrors.h>
+#include <kdbprivate.h> // for elektraKsBuilderNew
 
 #include <errno.h>
 #include <string.h>
@@ -47,21 +48,47 @@ int elektraNiGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key * paren
 		return -1;
 	}
 
+	ElektraKsBuilder * builder = elektraKsBuilderNew (0);
+	if (!builder)
+	{
+		elektraNi_Free (root);
+		ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey);
+		return -1;
+	}
+
 	elektraNi_node current = NULL;
 	while ((current = elektraNi_GetNextChild (root, current)) != NULL)
 	{
-		Key * k = keyNew (keyName (parentKey), KEY_END);
-		keyAddName (k, elektraNi_GetName (current, NULL));
-		keySetString (k, elektraNi_GetValue (current, NULL));
+		const char * name = elektraNi_GetName (current, NULL);
+		Key * k = elektraKsBuilderAddBelow (builder, parentKey, name, elektraNi_GetValue (current, NULL));
+		if (!k)
+		{
+			// the builder fails for invalid names and on memory errors, only the latter are fatal
+			Key * check = keyNew (keyName (parentKey), KEY_END);
+			int invalidName = check && keyAddName (check, name) < 0;
+			keyDel (check);
+			if (invalidName)
+			{
+				ELEKTRA_ADD_VALIDATION_SYNTACTIC_WARNINGF (parentKey, "Skipped entry with invalid key name: %s", name);
+				continue;
+			}
+
+			elektraKsBuilderDel (builder);
+			elektraNi_Free (root);
+			ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey);
+			return -1;
+		}
 		elektraNi_node mcur = NULL;
 		while ((mcur = elektraNi_GetNextChild (current, mcur)) != NULL)
 		{
 			keySetMeta (k, elektraNi_GetName (mcur, NULL), elektraNi_GetValue (mcur, NULL));
 			// printf("get meta %s %s from %s\n", elektraNi_GetName(mcur, NULL), elektraNi_GetValue (mcur, NULL), keyName(k));
 		}
-		ksAppendKey (returned, k);
 	}
 
+	KeySet * read = elektraKsBuilderFinish (builder);
+	ksAppend (returned, read);
+	ksDel (read);
 	elektraNi_Free (root);
 
 	return 1; /* success */
@@ -13,6 +13,7 @@
 #include <kdbhelper.h>
 
 #include <kdberrors.h>
+#include <kdbprivate.h>
 #include <stdio.h>
 
 #define MAGIC_NUMBER_BASE (0x454b444200000000UL) // EKDB (in ASCII) + Version placeholder
@@ -156,6 +157,15 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 		return ELEKTRA_PLUGIN_STATUS_ERROR;
 	}
 
+	// keys, names and string values are allocated in one arena
+	KeySet * arena = ksNewArena (0, 0);
+	if (!arena)
+	{
+		fclose (file);
+		ELEKTRA_SET_OUT_OF_MEMORY_ERROR (parentKey);
+		return ELEKTRA_PLUGIN_STATUS_ERROR;
+	}
+
 	// setup buffers
 	struct stringbuffer valueBuffer;
 	setupBuffer (&valueBuffer, 4);
@@ -184,6 +194,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 			elektraFree (nameBuffer.string);
 			elektraFree (metaNameBuffer.string);
 			elektraFree (valueBuffer.string);
+			ksDel (arena);
 			fclose (file);
 			return ELEKTRA_PLUGIN_STATUS_ERROR;
 		}
@@ -194,6 +205,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 			elektraFree (nameBuffer.string);
 			elektraFree (metaNameBuffer.string);
 			elektraFree (valueBuffer.string);
+			ksDel (arena);
 			fclose (file);
 			ELEKTRA_SET_VALIDATION_SEMANTIC_ERROR (parentKey, "Missing key type");
 			return ELEKTRA_PLUGIN_STATUS_ERROR;
@@ -212,6 +224,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 				elektraFree (nameBuffer.string);
 				elektraFree (metaNameBuffer.string);
 				elektraFree (valueBuffer.string);
+				ksDel (arena);
 				fclose (file);
 				return ELEKTRA_PLUGIN_STATUS_ERROR;
 			}
@@ -227,6 +240,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 				{
 					elektraFree (nameBuffer.string);
 					elektraFree (metaNameBuffer.string);
+					ksDel (arena);
 					fclose (file);
 					ELEKTRA_SET_VALIDATION_SYNTACTIC_ERROR (parentKey, "Error while reading file");
 					return ELEKTRA_PLUGIN_STATUS_ERROR;
@@ -243,16 +257,18 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 				elektraFree (nameBuffer.string);
 				elektraFree (metaNameBuffer.string);
 				elektraFree (valueBuffer.string);
+				ksDel (arena);
 				fclose (file);
 				return ELEKTRA_PLUGIN_STATUS_ERROR;
 			}
-			k = keyNew (nameBuffer.string, KEY_VALUE, valueBuffer.string, KEY_END);
+			k = ksArenaKeyNew (arena, nameBuffer.string, valueBuffer.string);
 			break;
 		}
 		default:
 			elektraFree (nameBuffer.string);
 			elektraFree (metaNameBuffer.string);
 			elektraFree (valueBuffer.string);
+			ksDel (arena);
 			fclose (file);
 			ELEKTRA_SET_VALIDATION_SEMANTIC_ERRORF (parentKey, "Unknown key type %c", type);
 			return ELEKTRA_PLUGIN_STATUS_ERROR;
@@ -263,6 +279,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 			if (c == EOF)
 			{
 				keyDel (k);
+				ksDel (arena);
 				fclose (file);
 				ELEKTRA_SET_VALIDATION_SYNTACTIC_ERROR (parentKey, "Missing key end");
 				return ELEKTRA_PLUGIN_STATUS_ERROR;
@@ -278,6 +295,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 					elektraFree (nameBuffer.string);
 					elektraFree (metaNameBuffer.string);
 					elektraFree (valueBuffer.string);
+					ksDel (arena);
 					fclose (file);
 					return ELEKTRA_PLUGIN_STATUS_ERROR;
 				}
@@ -288,6 +306,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 					elektraFree (nameBuffer.string);
 					elektraFree (metaNameBuffer.string);
 					elektraFree (valueBuffer.string);
+					ksDel (arena);
 					fclose (file);
 					return ELEKTRA_PLUGIN_STATUS_ERROR;
 				}
@@ -304,6 +323,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 					elektraFree (nameBuffer.string);
 					elektraFree (metaNameBuffer.string);
 					elektraFree (valueBuffer.string);
+					ksDel (arena);
 					fclose (file);
 					return ELEKTRA_PLUGIN_STATUS_ERROR;
 				}
@@ -314,6 +334,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 					elektraFree (nameBuffer.string);
 					elektraFree (metaNameBuffer.string);
 					elektraFree (valueBuffer.string);
+					ksDel (arena);
 					fclose (file);
 					return ELEKTRA_PLUGIN_STATUS_ERROR;
 				}
@@ -327,6 +348,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 					elektraFree (nameBuffer.string);
 					elektraFree (metaNameBuffer.string);
 					elektraFree (valueBuffer.string);
+					ksDel (arena);
 					fclose (file);
 					return ELEKTRA_PLUGIN_STATUS_ERROR;
 				}
@@ -339,6 +361,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 					elektraFree (nameBuffer.string);
 					elektraFree (metaNameBuffer.string);
 					elektraFree (valueBuffer.string);
+					ksDel (arena);
 					fclose (file);
 					return ELEKTRA_PLUGIN_STATUS_ERROR;
 				}
@@ -349,6 +372,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 				elektraFree (nameBuffer.string);
 				elektraFree (metaNameBuffer.string);
 				elektraFree (valueBuffer.string);
+				ksDel (arena);
 				fclose (file);
 				ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (parentKey, "Unknown meta type %c", type);
 				return ELEKTRA_PLUGIN_STATUS_ERROR;
@@ -362,6 +386,7 @@ int elektraQuickdumpGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 	elektraFree (metaNameBuffer.string);
 	elektraFree (valueBuffer.string);
 
+	ksDel (arena);
 	fclose (file);
 
 	return ELEKTRA_PLUGIN_STATUS_SUCCESS;
@@ -645,6 +670,7 @@ Plugin * ELEKTRA_PLUGIN_EXPORT
 	return elektraPluginExport ("quickdump",
 				    ELEKTRA_PLUGIN_GET,	&elektraQuickdumpGet,
 				    ELEKTRA_PLUGIN_SET,	&elektraQuickdumpSet,
+				    ELEKTRA_PLUGIN_THREADSAFE,	1,
 				    ELEKTRA_PLUGIN_END);
 	// clang-format on
 }
@@ -514,33 +514,25 @@ int ELEKTRA_PLUGIN_FUNCTION (close) (Plugin * handle, Key * errorKey ELEKTRA_UNU
 }
 
 
-int ELEKTRA_PLUGIN_FUNCTION (get) (Plugin * handle, KeySet * returned, Key * parentKey)
+/**
+ * @brief Check if the file of a resolver handle changed since the last get().
+ *
+ * Remembers the new modification time and, if the global keyset is available,
+ * persists it for the cache.
+ *
+ * @param handle the plugin handle
+ * @param pk the resolver handle of the file
+ * @param buf the result of stat() on the file or NULL if there is no file
+ *
+ * @retval 0 no update needed
+ * @retval 1 the file needs to be read
+ * @retval ELEKTRA_PLUGIN_STATUS_CACHE_HIT the file did not change since it was cached
+ */
+static int elektraCheckFileUpdate (Plugin * handle, resolverHandle * pk, const struct stat * buf)
 {
-	Key * root = keyNew ("system:/elektra/modules/" ELEKTRA_PLUGIN_NAME, KEY_END);
-
-	if (keyCmp (root, parentKey) == 0 || keyIsBelow (root, parentKey) == 1)
-	{
-		keyDel (root);
-		KeySet * info =
-#include "contract.h"
-			ksAppend (returned, info);
-		ksDel (info);
-		return 1;
-	}
-	keyDel (root);
-
-	resolverHandle * pk = elektraGetResolverHandle (handle, parentKey);
-	keySetString (parentKey, pk->filename);
-
-	int errnoSave = errno;
-	struct stat buf;
-
-	ELEKTRA_LOG ("stat file %s", pk->filename);
-	/* Start file IO with stat() */
-	if (stat (pk->filename, &buf) == -1)
+	if (!buf)
 	{
 		// no file, so storage has no job
-		errno = errnoSave;
 		pk->isMissing = 1;
 
 		// no file, so no metadata:
@@ -548,20 +540,17 @@ int ELEKTRA_PLUGIN_FUNCTION (get) (Plugin * handle, KeySet * returned, Key * par
 		pk->mtime.tv_nsec = 0;
 		return 0;
 	}
-	else
-	{
-		// successful, remember mode, uid and gid
-		pk->filemode = buf.st_mode;
-		pk->gid = buf.st_gid;
-		pk->uid = buf.st_uid;
-		pk->isMissing = 0;
-	}
+
+	// successful, remember mode, uid and gid
+	pk->filemode = buf->st_mode;
+	pk->gid = buf->st_gid;
+	pk->uid = buf->st_uid;
+	pk->isMissing = 0;
 
 	/* Check if update needed */
-	if (pk->mtime.tv_sec == ELEKTRA_STAT_SECONDS (buf) && pk->mtime.tv_nsec == ELEKTRA_STAT_NANO_SECONDS (buf))
+	if (pk->mtime.tv_sec == ELEKTRA_STAT_SECONDS ((*buf)) && pk->mtime.tv_nsec == ELEKTRA_STAT_NANO_SECONDS ((*buf)))
 	{
 		// no update, so storage has no job
-		errno = errnoSave;
 		return 0;
 	}
 
@@ -569,7 +558,7 @@ int ELEKTRA_PLUGIN_FUNCTION (get) (Plugin * handle, KeySet * returned, Key * par
 	KeySet * global;
 	char * name = 0;
 
-	if ((global = elektraPluginGetGlobalKeySet (handle)) != NULL && ELEKTRA_STAT_NANO_SECONDS (buf) != 0)
+	if ((global = elektraPluginGetGlobalKeySet (handle)) != NULL && ELEKTRA_STAT_NANO_SECONDS ((*buf)) != 0)
 	{
 		name = elektraCacheKeyName (pk->filename);
 
@@ -579,29 +568,28 @@ int ELEKTRA_PLUGIN_FUNCTION (get) (Plugin * handle, KeySet * returned, Key * par
 		{
 			struct timespec cached;
 			keyGetBinary (time, &cached, sizeof (struct timespec));
-			if (cached.tv_sec == ELEKTRA_STAT_SECONDS (buf) && cached.tv_nsec == ELEKTRA_STAT_NANO_SECONDS (buf))
+			if (cached.tv_sec == ELEKTRA_STAT_SECONDS ((*buf)) && cached.tv_nsec == ELEKTRA_STAT_NANO_SECONDS ((*buf)))
 			{
 				ELEKTRA_LOG_DEBUG ("global-cache: no update needed, everything is fine");
 				ELEKTRA_LOG_DEBUG ("cached.tv_sec:\t%ld", cached.tv_sec);
 				ELEKTRA_LOG_DEBUG ("cached.tv_nsec:\t%ld", cached.tv_nsec);
-				ELEKTRA_LOG_DEBUG ("buf.tv_sec:\t%ld", ELEKTRA_STAT_SECONDS (buf));
-				ELEKTRA_LOG_DEBUG ("buf.tv_nsec:\t%ld", ELEKTRA_STAT_NANO_SECONDS (buf));
+				ELEKTRA_LOG_DEBUG ("buf.tv_sec:\t%ld", ELEKTRA_STAT_SECONDS ((*buf)));
+				ELEKTRA_LOG_DEBUG ("buf.tv_nsec:\t%ld", ELEKTRA_STAT_NANO_SECONDS ((*buf)));
 				// update timestamp inside resolver
-				pk->mtime.tv_sec = ELEKTRA_STAT_SECONDS (buf);
-				pk->mtime.tv_nsec = ELEKTRA_STAT_NANO_SECONDS (buf);
+				pk->mtime.tv_sec = ELEKTRA_STAT_SECONDS ((*buf));
+				pk->mtime.tv_nsec = ELEKTRA_STAT_NANO_SECONDS ((*buf));
 
 				if (name) elektraFree (name);
-				errno = errnoSave;
 				return ELEKTRA_PLUGIN_STATUS_CACHE_HIT;
 			}
 		}
 	}
 
-	pk->mtime.tv_sec = ELEKTRA_STAT_SECONDS (buf);
-	pk->mtime.tv_nsec = ELEKTRA_STAT_NANO_SECONDS (buf);
+	pk->mtime.tv_sec = ELEKTRA_STAT_SECONDS ((*buf));
+	pk->mtime.tv_nsec = ELEKTRA_STAT_NANO_SECONDS ((*buf));
 
 	/* Persist modification times for cache */
-	if (global != NULL && ELEKTRA_STAT_NANO_SECONDS (buf) != 0)
+	if (global != NULL && ELEKTRA_STAT_NANO_SECONDS ((*buf)) != 0)
 	{
 		ELEKTRA_LOG_DEBUG ("global-cache: adding file modufication times");
 		Key * time = keyNew (name, KEY_BINARY, KEY_SIZE, sizeof (struct timespec), KEY_VALUE, &(pk->mtime), KEY_END);
@@ -609,6 +597,78 @@ int ELEKTRA_PLUGIN_FUNCTION (get) (Plugin * handle, KeySet * returned, Key * par
 	}
 
 	if (name) elektraFree (name);
+	return 1;
+}
+
+int ELEKTRA_PLUGIN_FUNCTION (get) (Plugin * handle, KeySet * returned, Key * parentKey)
+{
+	Key * root = keyNew ("system:/elektra/modules/" ELEKTRA_PLUGIN_NAME, KEY_END);
+
+	if (keyCmp (root, parentKey) == 0 || keyIsBelow (root, parentKey) == 1)
+	{
+		keyDel (root);
+		KeySet * info =
+#include "contract.h"
+			ksAppend (returned, info);
+		ksDel (info);
+		return 1;
+	}
+	keyDel (root);
+
+	resolverHandle * pk = elektraGetResolverHandle (handle, parentKey);
+	keySetString (parentKey, pk->filename);
+
+	int errnoSave = errno;
+	struct stat buf;
+
+	ELEKTRA_LOG ("stat file %s", pk->filename);
+	/* Start file IO with stat() */
+	int ret = elektraCheckFileUpdate (handle, pk, stat (pk->filename, &buf) == -1 ? NULL : &buf);
+	errno = errnoSave;
+	return ret;
+}
+
+/**
+ * @brief Check the files of several backends for updates at once.
+ *
+ * Does the same as get() for every entry, but without the overhead of
+ * calling every resolver separately: kdbGet() neither needs to rename its
+ * parent key for every backend nor do the resolvers check for the contract
+ * with a freshly allocated key. All files are stat'ed in a single loop.
+ *
+ * @param handles the resolver instances of the backends
+ * @param returned the keysets of the backends, only used for the contract
+ * @param parentKeys the parent keys of the backends, receive the resolved file names
+ * @param results receives what get() would have returned for every entry
+ * @param size the number of entries
+ * @param errorKey unused, the check does not fail
+ *
+ * @retval 1 always
+ */
+int ELEKTRA_PLUGIN_FUNCTION (checkUpdate) (Plugin ** handles, KeySet ** returned, Key ** parentKeys, int * results, size_t size,
+					   Key * errorKey ELEKTRA_UNUSED)
+{
+	static const char contractRoot[] = "system:/elektra/modules/" ELEKTRA_PLUGIN_NAME;
+	int errnoSave = errno;
+	struct stat buf;
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		const char * name = keyName (parentKeys[i]);
+		if (strncmp (name, contractRoot, sizeof (contractRoot) - 1) == 0 &&
+		    (name[sizeof (contractRoot) - 1] == '\0' || name[sizeof (contractRoot) - 1] == '/'))
+		{
+			results[i] = ELEKTRA_PLUGIN_FUNCTION (get) (handles[i], returned[i], parentKeys[i]);
+			continue;
+		}
+
+		resolverHandle * pk = elektraGetResolverHandle (handles[i], parentKeys[i]);
+		keySetString (parentKeys[i], pk->filename);
+
+		ELEKTRA_LOG ("stat file %s", pk->filename);
+		results[i] = elektraCheckFileUpdate (handles[i], pk, stat (pk->filename, &buf) == -1 ? NULL : &buf);
+	}
+
 	errno = errnoSave;
 	return 1;
 }
@@ -1199,6 +1259,7 @@ Plugin * ELEKTRA_PLUGIN_EXPORT
             ELEKTRA_PLUGIN_SET,	&ELEKTRA_PLUGIN_FUNCTION(set),
             ELEKTRA_PLUGIN_ERROR,	&ELEKTRA_PLUGIN_FUNCTION(error),
             ELEKTRA_PLUGIN_COMMIT, &ELEKTRA_PLUGIN_FUNCTION (commit),
+            ELEKTRA_PLUGIN_CHECKUPDATE,	&ELEKTRA_PLUGIN_FUNCTION (checkUpdate),
             ELEKTRA_PLUGIN_END);
 }
 
@@ -66,6 +66,8 @@ int ELEKTRA_PLUGIN_FUNCTION (get) (Plugin * handle, KeySet * ks, Key * parentKey
 int ELEKTRA_PLUGIN_FUNCTION (set) (Plugin * handle, KeySet * ks, Key * parentKey);
 int ELEKTRA_PLUGIN_FUNCTION (error) (Plugin * handle, KeySet * returned, Key * parentKey);
 int ELEKTRA_PLUGIN_FUNCTION (commit) (Plugin * handle, KeySet * ks, Key * parentKey);
+int ELEKTRA_PLUGIN_FUNCTION (checkUpdate) (Plugin ** handles, KeySet ** returned, Key ** parentKeys, int * results, size_t size,
+					   Key * errorKey);
 Plugin * ELEKTRA_PLUGIN_EXPORT;
 
 #endif
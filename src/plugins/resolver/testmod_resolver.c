@@ -298,6 +298,66 @@ void test_checkfile (void)
 	ksDel (modules);
 }
 
+static void test_checkupdate (void)
+{
+	printf ("Check update\n");
+
+	KeySet * modules = ksNew (0, KS_END);
+	elektraModulesInit (modules, 0);
+
+	const char * filename = elektraFilename ();
+	elektraUnlink (filename);
+	KeySet * conf = ksNew (1, keyNew ("system:/path", KEY_VALUE, filename, KEY_END), KS_END);
+	Plugin * plugin = elektraPluginOpen ("resolver", modules, conf, 0);
+	exit_if_fail (plugin, "could not load resolver plugin");
+	exit_if_fail (plugin->kdbCheckUpdate != 0, "no check update pointer");
+
+	Key * contractKey = keyNew ("system:/elektra/modules", KEY_END);
+	keyAddBaseName (contractKey, plugin->name);
+
+	Plugin * handles[] = { plugin, plugin };
+	KeySet * returned[] = { ksNew (0, KS_END), ksNew (0, KS_END) };
+	Key * parentKeys[] = { keyNew ("system:/tests/resolver", KEY_END), contractKey };
+	int results[2];
+	Key * errorKey = keyNew ("/", KEY_END);
+
+	// missing file
+	succeed_if (plugin->kdbCheckUpdate (handles, returned, parentKeys, results, 2, errorKey) == 1, "check update failed");
+	succeed_if (results[0] == 0, "missing file needs update");
+	succeed_if_same_string (keyString (parentKeys[0]), filename);
+	succeed_if (results[1] == 1, "contract not returned");
+	succeed_if (ksGetSize (returned[1]) > 0, "contract is empty");
+	succeed_if (ksGetSize (returned[0]) == 0, "keys returned for file");
+
+	FILE * f = fopen (filename, "w");
+	exit_if_fail (f, "could not create file");
+	fputs ("test", f);
+	fclose (f);
+
+	// new file, only the first check needs an update
+	succeed_if (plugin->kdbCheckUpdate (handles, returned, parentKeys, results, 1, errorKey) == 1, "check update failed");
+	succeed_if (results[0] == 1, "new file needs no update");
+	succeed_if (plugin->kdbCheckUpdate (handles, returned, parentKeys, results, 1, errorKey) == 1, "check update failed");
+	succeed_if (results[0] == 0, "unchanged file needs update");
+
+	// same state as get()
+	succeed_if (plugin->kdbGet (plugin, returned[0], parentKeys[0]) == 0, "get and check update differ");
+
+	elektraUnlink (filename);
+	succeed_if (plugin->kdbCheckUpdate (handles, returned, parentKeys, results, 1, errorKey) == 1, "check update failed");
+	succeed_if (results[0] == 0, "removed file needs update");
+	succeed_if (plugin->kdbGet (plugin, returned[0], parentKeys[0]) == 0, "get and check update differ");
+
+	keyDel (errorKey);
+	keyDel (parentKeys[0]);
+	keyDel (parentKeys[1]);
+	ksDel (returned[0]);
+	ksDel (returned[1]);
+	elektraPluginClose (plugin, 0);
+	elektraModulesClose (modules, 0);
+	ksDel (modules);
+}
+
 static void check_xdg (void)
 {
 	KeySet * modules = ksNew (0, KS_END);
@@ -338,6 +398,7 @@ int main (int argc, char ** argv)
 	test_name ();
 	test_lockname ();
 	test_tempname ();
+	test_checkupdate ();
 
 
 	print_result ("testmod_resolver");
@@ -16,6 +16,7 @@
 #include <kdbhelper.h>
 #include <kdblogger.h>
 #include <kdbmeta.h>
+#include <kdbprivate.h>
 #include <kdbtypes.h>
 
 #include <fnmatch.h>
@@ -430,6 +431,37 @@ static bool validateArraySize (Key * arrayParent, Key * spec)
 	return (arrayMin == NULL || strcmp (arrayMin, arrayActual) <= 0) && (arrayMax == NULL || 0 <= strcmp (arrayActual, arrayMax));
 }
 
+/**
+ * Finds the keys in @p ks, which are below or same as @p parent in the namespace @p ns.
+ *
+ * Unlike ksCut() the keys stay in @p ks and nothing is copied.
+ * A cascading @p parent has keys in every namespace, which are
+ * searched with a copy of @p parent renamed to @p ns.
+ *
+ * @param ks     the KeySet to search
+ * @param parent the parent key
+ * @param lookup a copy of @p parent, its namespace is changed
+ * @param ns     the namespace to search, only used for a cascading @p parent
+ * @param end    set to the end of the range
+ *
+ * @return the start of the range
+ */
+static elektraCursor findBelow (KeySet * ks, Key * parent, Key * lookup, elektraNamespace ns, elektraCursor * end)
+{
+	if (keyGetNamespace (parent) != KEY_NS_CASCADING)
+	{
+		if (ns != keyGetNamespace (parent))
+		{
+			*end = 0;
+			return 0;
+		}
+		return ksFindHierarchy (ks, parent, end);
+	}
+
+	keySetNamespace (lookup, ns);
+	return ksFindHierarchy (ks, lookup, end);
+}
+
 static void validateEmptyArray (KeySet * ks, Key * arraySpecParent, Key * parentKey, OnConflict onConflict)
 {
 	Key * parentLookup = keyNew (strchr (keyName (arraySpecParent), '/'), KEY_END);
@@ -448,33 +480,33 @@ static void validateEmptyArray (KeySet * ks, Key * arraySpecParent, Key * parent
 		arrayParent = keyNew (keyName (parentLookup), KEY_END);
 	}
 
-	// TODO: [improvement] ksExtract?, like ksCut, but doesn't remove -> no need for ksDup
-	KeySet * ksCopy = ksDup (ks);
-	KeySet * subKeys = ksCut (ksCopy, parentLookup);
-	ksDel (ksCopy);
-
 	ssize_t parentLen = keyGetUnescapedNameSize (parentLookup);
 
 	bool haveConflict = false;
-	Key * cur;
-	ksRewind (subKeys);
-	while ((cur = ksNext (subKeys)) != NULL)
+	Key * lookup = keyNew (keyName (parentLookup), KEY_END);
+	for (elektraNamespace ns = KEY_NS_CASCADING; ns <= KEY_NS_LAST; ++ns)
 	{
-		if (keyIsBelow (parentLookup, cur) == 0 || keyGetNamespace (cur) == KEY_NS_SPEC)
+		elektraCursor end;
+		for (elektraCursor it = findBelow (ks, parentLookup, lookup, ns, &end); it < end; ++it)
 		{
-			continue;
-		}
+			Key * cur = ksAtCursor (ks, it);
+			if (keyIsBelow (parentLookup, cur) == 0 || keyGetNamespace (cur) == KEY_NS_SPEC)
+			{
+				continue;
+			}
 
-		const char * checkStr = strchr (keyName (cur), ':');
-		checkStr += parentLen;
+			const char * checkStr = strchr (keyName (cur), ':');
+			checkStr += parentLen;
 
-		if (elektraArrayValidateBaseNameString (checkStr) < 0)
-		{
-			haveConflict = true;
-			addConflict (arrayParent, CONFLICT_ARRAYMEMBER);
-			elektraMetaArrayAdd (arrayParent, "conflict/arraymember", keyName (cur));
+			if (elektraArrayValidateBaseNameString (checkStr) < 0)
+			{
+				haveConflict = true;
+				addConflict (arrayParent, CONFLICT_ARRAYMEMBER);
+				elektraMetaArrayAdd (arrayParent, "conflict/arraymember", keyName (cur));
+			}
 		}
 	}
+	keyDel (lookup);
 
 	if (immediate)
 	{
@@ -491,7 +523,6 @@ static void validateEmptyArray (KeySet * ks, Key * arraySpecParent, Key * parent
 		keyDel (arrayParent);
 	}
 
-	ksDel (subKeys);
 	keyDel (parentLookup);
 
 	if (!immediate)
@@ -513,34 +544,31 @@ static void validateArrayMembers (KeySet * ks, Key * arraySpec)
 		return;
 	}
 
-	// TODO: [improvement] ksExtract?, like ksCut, but doesn't remove -> no need for ksDup
-	KeySet * ksCopy = ksDup (ks);
-	KeySet * subKeys = ksCut (ksCopy, parentLookup);
-	ksDel (ksCopy);
-
 	ssize_t parentLen = keyGetUnescapedNameSize (parentLookup);
 
-	Key * cur;
-	ksRewind (subKeys);
-	while ((cur = ksNext (subKeys)) != NULL)
+	Key * lookup = keyNew (keyName (parentLookup), KEY_END);
+	for (elektraNamespace ns = KEY_NS_FIRST; ns <= KEY_NS_LAST; ++ns)
 	{
-		if (keyIsBelow (parentLookup, cur) == 0 || keyGetNamespace (cur) == KEY_NS_SPEC ||
-		    keyGetNamespace (cur) == KEY_NS_CASCADING)
+		elektraCursor end;
+		for (elektraCursor it = findBelow (ks, parentLookup, lookup, ns, &end); it < end; ++it)
 		{
-			continue;
-		}
+			Key * cur = ksAtCursor (ks, it);
+			if (keyIsBelow (parentLookup, cur) == 0 || keyGetNamespace (cur) == KEY_NS_SPEC)
+			{
+				continue;
+			}
 
-		const char * checkStr = strchr (keyName (cur), ':');
-		checkStr += parentLen;
+			const char * checkStr = strchr (keyName (cur), ':');
+			checkStr += parentLen;
 
-		if (elektraArrayValidateBaseNameString (checkStr) < 0)
-		{
-			addConflict (arrayParent, CONFLICT_ARRAYMEMBER);
-			elektraMetaArrayAdd (arrayParent, "conflict/arraymember", keyName (cur));
+			if (elektraArrayValidateBaseNameString (checkStr) < 0)
+			{
+				addConflict (arrayParent, CONFLICT_ARRAYMEMBER);
+				elektraMetaArrayAdd (arrayParent, "conflict/arraymember", keyName (cur));
+			}
 		}
 	}
-
-	ksDel (subKeys);
+	keyDel (lookup);
 	keyDel (parentLookup);
 
 	keySetMeta (arrayParent, "internal/spec/array/validated", "");
@@ -707,24 +735,24 @@ static void validateWildcardSubs (KeySet * ks, Key * key)
 	Key * parent = keyDup (key);
 	keySetBaseName (parent, NULL);
 
-	// TODO: [improvement] ksExtract?, like ksCut, but doesn't remove -> no need for ksDup
-	KeySet * ksCopy = ksDup (ks);
-	KeySet * subKeys = ksCut (ksCopy, parent);
-	ksDel (ksCopy);
-
-	Key * cur;
-	while ((cur = ksNext (subKeys)) != NULL)
+	Key * lookup = keyNew (keyName (parent), KEY_END);
+	for (elektraNamespace ns = KEY_NS_CASCADING; ns <= KEY_NS_LAST; ++ns)
 	{
-		if (keyIsDirectlyBelow (parent, cur))
+		elektraCursor end;
+		for (elektraCursor it = findBelow (ks, parent, lookup, ns, &end); it < end; ++it)
 		{
-			if (elektraArrayValidateBaseNameString (keyBaseName (cur)) > 0)
+			Key * cur = ksAtCursor (ks, it);
+			if (keyIsDirectlyBelow (parent, cur))
 			{
-				addConflict (parent, CONFLICT_WILDCARDMEMBER);
-				elektraMetaArrayAdd (parent, "conflict/wildcardmember", keyName (cur));
+				if (elektraArrayValidateBaseNameString (keyBaseName (cur)) > 0)
+				{
+					addConflict (parent, CONFLICT_WILDCARDMEMBER);
+					elektraMetaArrayAdd (parent, "conflict/wildcardmember", keyName (cur));
+				}
 			}
 		}
 	}
-	ksDel (subKeys);
+	keyDel (lookup);
 	keyDel (parent);
 }
 
@@ -246,6 +246,60 @@ void icase_test (void)
 	PLUGIN_CLOSE ();
 }
 
+void cache_test (void)
+{
+	Key * parentKey = keyNew ("user:/tests/validation", KEY_VALUE, "", KEY_END);
+
+	KeySet * conf = ksNew (0, KS_END);
+	KeySet * ks;
+	PLUGIN_OPEN ("validation");
+
+	// the same pattern with other flags must not reuse the compiled pattern
+	ks = ksNew (3,
+		    keyNew ("user:/tests/validation/any", KEY_VALUE, "a word b", KEY_META, "check/validation", "word", KEY_META,
+			    "check/validation/match", "any", KEY_END),
+		    keyNew ("user:/tests/validation/icase", KEY_VALUE, "WORD", KEY_META, "check/validation", "word", KEY_META,
+			    "check/validation/ignorecase", "", KEY_END),
+		    keyNew ("user:/tests/validation/line", KEY_VALUE, "a word b", KEY_META, "check/validation", "word", KEY_META,
+			    "check/validation/match", "line", KEY_END),
+		    KS_END);
+	succeed_if (plugin->kdbSet (plugin, ks, parentKey) == (-1), "anchored pattern matched");
+	succeed_if (keyGetMeta (parentKey, "error"), "no error for anchored pattern");
+	ksDel (ks);
+	keySetMeta (parentKey, "error", 0);
+
+	// more patterns than the cache holds
+	char name[64];
+	char value[64];
+	char pattern[sizeof (value) + 2];
+	ks = ksNew (0, KS_END);
+	for (int i = 0; i < 3 * VALIDATION_CACHE_SIZE; ++i)
+	{
+		snprintf (name, sizeof (name), "user:/tests/validation/key%d", i);
+		snprintf (value, sizeof (value), "value%d", i % (2 * VALIDATION_CACHE_SIZE));
+		snprintf (pattern, sizeof (pattern), "^%s$", value);
+		ksAppendKey (ks, keyNew (name, KEY_VALUE, value, KEY_META, "check/validation", pattern, KEY_END));
+	}
+	ksRewind (ks);
+	succeed_if (plugin->kdbSet (plugin, ks, parentKey) == (1), "kdbSet failed");
+	ksRewind (ks);
+	succeed_if (plugin->kdbSet (plugin, ks, parentKey) == (1), "kdbSet failed with filled cache");
+	ksDel (ks);
+
+	// invalid patterns are reported every time
+	for (int i = 0; i < 2; ++i)
+	{
+		ks = ksNew (1, keyNew ("user:/tests/validation/invalid", KEY_VALUE, "a", KEY_META, "check/validation", "a(", KEY_END),
+			    KS_END);
+		succeed_if (plugin->kdbSet (plugin, ks, parentKey) == (-1), "invalid pattern accepted");
+		succeed_if (keyGetMeta (parentKey, "error"), "no error for invalid pattern");
+		keySetMeta (parentKey, "error", 0);
+		ksDel (ks);
+	}
+
+	keyDel (parentKey);
+	PLUGIN_CLOSE ();
+}
 
 int main (int argc, char ** argv)
 {
@@ -261,6 +315,7 @@ int main (int argc, char ** argv)
 	line_test ();
 	icase_test ();
 	invert_test ();
+	cache_test ();
 	print_result ("testmod_validation");
 
 	return nbError;
@@ -26,6 +26,8 @@ int elektraValidationGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 		  n = ksNew (30,
 			     keyNew ("system:/elektra/modules/validation", KEY_VALUE, "validation plugin waits for your orders", KEY_END),
 			     keyNew ("system:/elektra/modules/validation/exports", KEY_END),
+			     keyNew ("system:/elektra/modules/validation/exports/open", KEY_FUNC, elektraValidationOpen, KEY_END),
+			     keyNew ("system:/elektra/modules/validation/exports/close", KEY_FUNC, elektraValidationClose, KEY_END),
 			     keyNew ("system:/elektra/modules/validation/exports/get", KEY_FUNC, elektraValidationGet, KEY_END),
 			     keyNew ("system:/elektra/modules/validation/exports/set", KEY_FUNC, elektraValidationSet, KEY_END),
 			     keyNew ("system:/elektra/modules/validation/exports/ksLookupRE", KEY_FUNC, ksLookupRE, KEY_END),
@@ -36,7 +38,74 @@ int elektraValidationGet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 	return 1;
 }
 
-static int validateKey (Key * key, Key * parentKey)
+/**
+ * @brief Finds the compiled pattern in the cache or compiles it.
+ *
+ * If the cache is full, the oldest entry is replaced.
+ *
+ * @param cache the cache of the plugin instance
+ * @param pattern the pattern without the anchors added for line and word validation
+ * @param cflags the flags for regcomp()
+ * @param anchored whether the pattern has to match the whole line or word
+ * @param ret set to the return value of regcomp() on a cache miss, otherwise 0
+ * @param error buffer for the message of regerror()
+ * @param errorSize size of @p error
+ *
+ * @return the entry with the compiled pattern
+ * @retval NULL if the pattern could not be compiled, the error is in @p ret and @p error
+ */
+static const ValidationRegex * validationCacheLookup (ValidationCache * cache, const char * pattern, int cflags, int anchored, int * ret,
+						      char * error, size_t errorSize)
+{
+	*ret = 0;
+	for (size_t i = 0; i < cache->size; ++i)
+	{
+		ValidationRegex * entry = &cache->entries[i];
+		if (entry->cflags == cflags && entry->anchored == anchored && !strcmp (entry->pattern, pattern)) return entry;
+	}
+
+	char * regexString = anchored ? elektraFormat ("^%s$", pattern) : (char *) pattern;
+	regex_t regex;
+	*ret = regcomp (&regex, regexString, cflags);
+	if (anchored) elektraFree (regexString);
+	if (*ret != 0)
+	{
+		regerror (*ret, &regex, error, errorSize);
+		regfree (&regex);
+		return NULL;
+	}
+
+	ValidationRegex * entry;
+	if (cache->size < VALIDATION_CACHE_SIZE)
+	{
+		entry = &cache->entries[cache->size++];
+	}
+	else
+	{
+		entry = &cache->entries[cache->next];
+		cache->next = (cache->next + 1) % VALIDATION_CACHE_SIZE;
+		regfree (&entry->regex);
+		elektraFree (entry->pattern);
+	}
+	entry->pattern = elektraStrDup (pattern);
+	entry->cflags = cflags;
+	entry->anchored = anchored;
+	entry->regex = regex;
+	return entry;
+}
+
+static void validationCacheClear (ValidationCache * cache)
+{
+	for (size_t i = 0; i < cache->size; ++i)
+	{
+		regfree (&cache->entries[i].regex);
+		elektraFree (cache->entries[i].pattern);
+	}
+	cache->size = 0;
+	cache->next = 0;
+}
+
+static int validateKeyCached (ValidationCache * cache, Key * key, Key * parentKey)
 {
 	const Key * regexMeta = keyGetMeta (key, "check/validation");
 
@@ -90,37 +159,26 @@ static int validateKey (Key * key, Key * parentKey)
 		elektraFree (typeCopy);
 	}
 
-	char * regexString = NULL;
-	int freeString = 0;
-	if (lineValidation || wordValidation)
-	{
-		regexString = elektraMalloc (keyGetValueSize (regexMeta) + 2);
-		freeString = 1;
-		sprintf (regexString, "^%s$", keyString (regexMeta));
-	}
-	else
-	{
-		regexString = (char *) keyString (regexMeta);
-	}
+	int anchored = lineValidation || wordValidation;
+	const char * pattern = keyString (regexMeta);
 
-	regex_t regex;
-	regmatch_t offsets;
-	int ret = regcomp (&regex, regexString, cflags);
+	char buffer[1000];
+	int ret;
+	const ValidationRegex * entry = validationCacheLookup (cache, pattern, cflags, anchored, &ret, buffer, 999);
 
-	if (ret != 0)
+	if (!entry)
 	{
-		char buffer[1000];
-		regerror (ret, &regex, buffer, 999);
-		ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (parentKey, "Could not compile regex '%s' of the key '%s'. Reason: %s",
-							 keyString (regexMeta), keyName (key), buffer);
-		regfree (&regex);
-		if (freeString) elektraFree (regexString);
+		ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (parentKey, "Could not compile regex '%s' of the key '%s'. Reason: %s", pattern,
+							 keyName (key), buffer);
 		return 0;
 	}
+
+	const regex_t * regex = &entry->regex;
+	regmatch_t offsets;
 	int match = 0;
 	if (!wordValidation)
 	{
-		ret = regexec (&regex, keyString (key), 1, &offsets, 0);
+		ret = regexec (regex, keyString (key), 1, &offsets, 0);
 		if (ret == 0) match = 1;
 	}
 	else
@@ -130,7 +188,7 @@ static int validateKey (Key * key, Key * parentKey)
 		char * string = (char *) keyString (key);
 		while ((token = strtok_r (string, " \t\n", &savePtr)) != NULL)
 		{
-			ret = regexec (&regex, token, 1, &offsets, 0);
+			ret = regexec (regex, token, 1, &offsets, 0);
 			if (ret == 0)
 			{
 				match = 1;
@@ -143,36 +201,61 @@ static int validateKey (Key * key, Key * parentKey)
 
 	if (!match)
 	{
+		const char * anchorStart = anchored ? "^" : "";
+		const char * anchorEnd = anchored ? "$" : "";
 		const Key * msg = keyGetMeta (key, "check/validation/message");
 		if (msg)
 		{
 			ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (parentKey,
-								 "The key '%s' with value '%s' does not confirm to '%s'. Reason: %s",
-								 keyName (key), keyString (key), regexString, keyString (msg));
-			regfree (&regex);
-			if (freeString) elektraFree (regexString);
+								 "The key '%s' with value '%s' does not confirm to '%s%s%s'. Reason: %s",
+								 keyName (key), keyString (key), anchorStart, pattern, anchorEnd,
+								 keyString (msg));
 			return 0;
 		}
 		else
 		{
-			char buffer[1000];
-			regerror (ret, &regex, buffer, 999);
+			regerror (ret, regex, buffer, 999);
 			ELEKTRA_SET_VALIDATION_SYNTACTIC_ERRORF (parentKey,
-								 "The key '%s' with value '%s' does not confirm to '%s'. Reason: %s",
-								 keyName (key), keyString (key), regexString, buffer);
-			regfree (&regex);
-			if (freeString) elektraFree (regexString);
+								 "The key '%s' with value '%s' does not confirm to '%s%s%s'. Reason: %s",
+								 keyName (key), keyString (key), anchorStart, pattern, anchorEnd, buffer);
 			return 0;
 		}
 	}
 
-	regfree (&regex);
-	if (freeString) elektraFree (regexString);
 	return 1;
 }
 
-int elektraValidationSet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key * parentKey)
+static int validateKey (Key * key, Key * parentKey)
+{
+	ValidationCache cache = { .size = 0, .next = 0 };
+	int rc = validateKeyCached (&cache, key, parentKey);
+	validationCacheClear (&cache);
+	return rc;
+}
+
+int elektraValidationOpen (Plugin * handle, Key * errorKey ELEKTRA_UNUSED)
+{
+	ValidationCache * cache = elektraCalloc (sizeof (ValidationCache));
+	if (!cache) return -1;
+	elektraPluginSetData (handle, cache);
+	return 1;
+}
+
+int elektraValidationClose (Plugin * handle, Key * errorKey ELEKTRA_UNUSED)
+{
+	ValidationCache * cache = elektraPluginGetData (handle);
+	if (cache)
+	{
+		validationCacheClear (cache);
+		elektraFree (cache);
+		elektraPluginSetData (handle, NULL);
+	}
+	return 1;
+}
+
+int elektraValidationSet (Plugin * handle, KeySet * returned, Key * parentKey)
 {
+	ValidationCache * cache = elektraPluginGetData (handle);
 	Key * cur = 0;
 
 	while ((cur = ksNext (returned)) != 0)
@@ -180,7 +263,7 @@ int elektraValidationSet (Plugin * handle ELEKTRA_UNUSED, KeySet * returned, Key
 		const Key * regexMeta = keyGetMeta (cur, "check/validation");
 
 		if (!regexMeta) continue;
-		int rc = validateKey (cur, parentKey);
+		int rc = cache ? validateKeyCached (cache, cur, parentKey) : validateKey (cur, parentKey);
 		if (!rc) return -1;
 	}
 
@@ -191,6 +274,8 @@ Plugin * ELEKTRA_PLUGIN_EXPORT
 {
 	// clang-format off
 	return elektraPluginExport("validation",
+			ELEKTRA_PLUGIN_OPEN,	&elektraValidationOpen,
+			ELEKTRA_PLUGIN_CLOSE,	&elektraValidationClose,
 			ELEKTRA_PLUGIN_GET,	&elektraValidationGet,
 			ELEKTRA_PLUGIN_SET,	&elektraValidationSet,
 			ELEKTRA_PLUGIN_END);
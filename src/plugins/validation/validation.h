@@ -15,6 +15,24 @@
 #include <kdberrors.h>
 #include <kdbplugin.h>
 
+/** The number of compiled patterns a plugin instance keeps */
+#define VALIDATION_CACHE_SIZE 64
+
+typedef struct
+{
+	char * pattern; /*!< the pattern without the anchors of line and word validation */
+	int cflags;
+	int anchored;
+	regex_t regex;
+} ValidationRegex;
+
+typedef struct
+{
+	ValidationRegex entries[VALIDATION_CACHE_SIZE];
+	size_t size;
+	size_t next; /*!< the entry replaced next if the cache is full */
+} ValidationCache;
+
 int elektraValidationOpen (Plugin * handle, Key * errorKey);
 int elektraValidationClose (Plugin * handle, Key * errorKey);
 int elektraValidationGet (Plugin * handle, KeySet * ks, Key * parentKey);
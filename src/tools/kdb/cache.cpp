@@ -36,11 +36,22 @@ int CacheCommand::execute (Cmdline const & cl)
 
 	string cmd = cl.arguments[0];
 	Key isEnabled ("system:/elektra/cache/enabled", KEY_END);
+	Key isShared ("system:/elektra/cache/shared", KEY_END);
 	if (cmd == "enable")
 	{
 		// always use the cache
 		isEnabled.setString ("1");
 		conf.append (isEnabled);
+		conf.lookup (isShared, KDB_O_POP);
+		kdb.set (conf, parentKey);
+	}
+	else if (cmd == "shared")
+	{
+		// always use the cache, stored in shared memory
+		isEnabled.setString ("1");
+		isShared.setString ("1");
+		conf.append (isEnabled);
+		conf.append (isShared);
 		kdb.set (conf, parentKey);
 	}
 	else if (cmd == "disable")
@@ -54,16 +65,23 @@ int CacheCommand::execute (Cmdline const & cl)
 	{
 		// reset to default settings, use cache if available
 		conf.lookup (isEnabled, KDB_O_POP);
+		conf.lookup (isShared, KDB_O_POP);
 		kdb.set (conf, parentKey);
 	}
 	else if (cmd == "clear")
 	{
-		Modules modules;
-		PluginPtr plugin = modules.load ("cache", cl.getPluginsConfig ());
-
-		KeySet ks;
+		// clear the cache files in the home directory and in shared memory
+		KeySet sharedConfig = cl.getPluginsConfig ();
+		sharedConfig.append (Key ("system:/shared", KEY_VALUE, "1", KEY_END));
 		parentKey.setMeta ("cache/clear", "1");
-		plugin->get (ks, parentKey);
+		for (KeySet pluginConfig : { cl.getPluginsConfig (), sharedConfig })
+		{
+			Modules modules;
+			PluginPtr plugin = modules.load ("cache", pluginConfig);
+
+			KeySet ks;
+			plugin->get (ks, parentKey);
+		}
 	}
 	else
 	{
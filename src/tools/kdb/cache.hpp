@@ -25,7 +25,7 @@ public:
 
 	virtual std::string getSynopsis () override
 	{
-		return "{enable,disable,default,clear}";
+		return "{enable,shared,disable,default,clear}";
 	}
 
 	virtual std::string getShortHelpText () override
@@ -37,8 +37,9 @@ public:
 	{
 		return "This command is used to enable or disable the cache and to revert\n"
 		       "to the default settings. The default settings will let the system\n"
-		       "decide whether to use the cache or not. The clear command will\n"
-		       "remove the generated cache files in a safe way.\n";
+		       "decide whether to use the cache or not. The shared command enables\n"
+		       "the cache and keeps the cache files in shared memory. The clear\n"
+		       "command will remove the generated cache files in a safe way.\n";
 	}
 
 	virtual int execute (Cmdline const & cmdline) override;
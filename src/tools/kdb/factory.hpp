@@ -58,6 +58,7 @@
 #include <showmeta.hpp>
 #include <specmount.hpp>
 #include <test.hpp>
+#include <trace.hpp>
 #include <umount.hpp>
 
 class Instancer
@@ -124,6 +125,7 @@ public:
 		m_factory.insert (std::make_pair ("gumount", std::make_shared<Cnstancer<GlobalUmountCommand>> ()));
 		m_factory.insert (std::make_pair ("list-commands", std::make_shared<Cnstancer<ListCommandsCommand>> ()));
 		m_factory.insert (std::make_pair ("gen", std::make_shared<Cnstancer<GenCommand>> ()));
+		m_factory.insert (std::make_pair ("trace", std::make_shared<Cnstancer<TraceCommand>> ()));
 	}
 
 	std::vector<std::string> getPrettyCommands () const
@@ -0,0 +1,76 @@
+/**
+ * @file
+ *
+ * @brief
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ */
+
+#include <trace.hpp>
+
+#include <cmdline.hpp>
+#include <kdb.hpp>
+#include <kdbtrace.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace kdb;
+
+TraceCommand::TraceCommand ()
+{
+}
+
+int TraceCommand::execute (Cmdline const & cl)
+{
+	if (cl.arguments.size () < 1 || cl.arguments.size () > 2) throw invalid_argument ("1 or 2 arguments required");
+
+	ckdb::ElektraTraceFormat format = ckdb::ELEKTRA_TRACE_FORMAT_JSON;
+	if (cl.arguments.size () == 2)
+	{
+		if (cl.arguments[1] == "chrome")
+			format = ckdb::ELEKTRA_TRACE_FORMAT_CHROME;
+		else if (cl.arguments[1] != "json")
+			throw invalid_argument ("format must be json or chrome");
+	}
+
+	Key root = cl.createKey (0);
+
+	// the C++ binding does not expose its handle, which is needed to enable tracing
+	Key errorKey (root.getName (), KEY_END);
+	ckdb::KDB * handle = ckdb::kdbOpen (errorKey.getKey ());
+	if (!handle) throw KDBException (errorKey);
+
+	if (ckdb::elektraTraceEnable (handle, 0) != 1)
+	{
+		ckdb::kdbClose (handle, errorKey.getKey ());
+		throw invalid_argument ("tracing is not available, Elektra was compiled with ENABLE_TRACE=OFF");
+	}
+
+	KeySet ks;
+	int ret = ckdb::kdbGet (handle, ks.getKeySet (), root.getKey ());
+	printWarnings (cerr, root, cl.verbose, cl.debug);
+	printError (cerr, root, cl.verbose, cl.debug);
+
+	vector<ckdb::ElektraTraceEvent> events;
+	ckdb::ElektraTraceEvent buffer[256];
+	size_t read;
+	while ((read = ckdb::elektraTraceRead (handle, buffer, 256)) > 0)
+	{
+		events.insert (events.end (), buffer, buffer + read);
+	}
+
+	// the strings of the events belong to the handle
+	ckdb::elektraTraceDump (events.data (), events.size (), format, stdout);
+	fflush (stdout);
+
+	ckdb::kdbClose (handle, errorKey.getKey ());
+	printWarnings (cerr, errorKey, cl.verbose, cl.debug);
+
+	return ret == -1 ? 1 : 0;
+}
+
+TraceCommand::~TraceCommand ()
+{
+}
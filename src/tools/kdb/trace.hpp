@@ -0,0 +1,48 @@
+/**
+ * @file
+ *
+ * @brief
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include "coloredkdbio.hpp"
+#include <command.hpp>
+
+class TraceCommand : public Command
+{
+public:
+	TraceCommand ();
+	~TraceCommand ();
+
+	virtual std::string getShortOptions () override
+	{
+		return "";
+	}
+
+	virtual std::string getSynopsis () override
+	{
+		return "<name> [<format>]";
+	}
+
+	virtual std::string getShortHelpText () override
+	{
+		return "Trace the phases of kdbGet for a given name.";
+	}
+
+	virtual std::string getLongHelpText () override
+	{
+		return "Opens a new KDB instance with tracing enabled, retrieves\n"
+		       "the keys below the given name and prints the time spent\n"
+		       "in the cache, resolvers, plugins and global plugins.\n"
+		       "The default format is json, chrome writes the trace event\n"
+		       "format, which can be opened with about:tracing or Perfetto.\n";
+	}
+
+	virtual int execute (Cmdline const & cmdline) override;
+};
+
+#endif
@@ -1840,6 +1840,34 @@ static void test_ksLookupPop (void)
 	ksDel (ks);
 }
 
+static void test_ksPopAllAfterLookup (void)
+{
+	printf ("Test appending after popping all keys of a large KeySet\n");
+
+	char name[64];
+	KeySet * ks = ksNew (0, KS_END);
+	for (int i = 0; i < 200; ++i)
+	{
+		snprintf (name, sizeof (name), "user:/tests/prefix/k%03d", i);
+		ksAppendKey (ks, keyNew (name, KEY_END));
+	}
+	succeed_if (ksLookupByName (ks, "user:/tests/prefix/k100", 0) != 0, "could not find key");
+
+	Key * popped;
+	while ((popped = ksPop (ks)) != 0)
+	{
+		keyDel (popped);
+	}
+	succeed_if (ksGetSize (ks) == 0, "KeySet not empty");
+
+	succeed_if (ksAppendKey (ks, keyNew ("user:/tests/prefix/k000", KEY_END)) == 1, "could not append key");
+	succeed_if (ksAppendKey (ks, keyNew ("user:/tests/other", KEY_END)) == 2, "could not append key");
+	succeed_if (ksLookupByName (ks, "user:/tests/prefix/k000", 0) != 0, "could not find key");
+	succeed_if (ksLookupByName (ks, "user:/tests/other", 0) != 0, "could not find key");
+
+	ksDel (ks);
+}
+
 static void test_ksSync (void)
 {
 	printf ("Test sync flag of KeySet\n");
@@ -2869,6 +2897,60 @@ static void test_ksAppend3 (void)
 	ksDel (ks);
 }
 
+static void test_ksAppendMerge (void)
+{
+	printf ("Test merging keysets with ksAppend\n");
+
+	Key * shared = keyNew ("user:/c", KEY_VALUE, "shared", KEY_END);
+	Key * replaced = keyNew ("user:/e", KEY_VALUE, "old", KEY_END);
+	KeySet * ks = ksNew (4, keyNew ("user:/a", KEY_END), shared, replaced, keyNew ("user:/g", KEY_END), KS_END);
+	keyIncRef (replaced);
+
+	Key * replacement = keyNew ("user:/e", KEY_VALUE, "new", KEY_END);
+	KeySet * toAppend = ksNew (5, keyNew ("user:/b", KEY_END), shared, replacement, keyNew ("user:/f", KEY_END),
+				   keyNew ("user:/h", KEY_END), KS_END);
+
+	succeed_if (ksAppend (ks, toAppend) == 7, "wrong size after merge");
+	succeed_if_same_string (keyName (ksCurrent (ks)), "user:/h");
+	succeed_if (ksGetSize (toAppend) == 5, "toAppend must not be changed");
+
+	const char * expected[] = { "user:/a", "user:/b", "user:/c", "user:/e", "user:/f", "user:/g", "user:/h" };
+	for (elektraCursor it = 0; it < ksGetSize (ks); ++it)
+	{
+		succeed_if_same_string (keyName (ksAtCursor (ks, it)), expected[it]);
+	}
+	succeed_if (ksAtCursor (ks, 7) == 0, "keyset not terminated");
+
+	succeed_if (ksLookupByName (ks, "user:/c", 0) == shared, "identical key was replaced");
+	succeed_if (keyGetRef (shared) == 2, "identical key must not get another reference");
+	succeed_if (ksLookupByName (ks, "user:/e", 0) == replacement, "key was not replaced");
+	succeed_if (keyGetRef (replacement) == 2, "replacement should be in both keysets");
+	succeed_if (keyGetRef (replaced) == 1, "replaced key should have been removed");
+	succeed_if_same_string (keyString (replaced), "old");
+	keyDecRef (replaced);
+	keyDel (replaced);
+
+	// merging in front of and behind all keys
+	KeySet * before = ksNew (2, keyNew ("dir:/x", KEY_END), keyNew ("dir:/y", KEY_END), KS_END);
+	KeySet * after = ksNew (2, keyNew ("user:/z/1", KEY_END), keyNew ("user:/z/2", KEY_END), KS_END);
+	succeed_if (ksAppend (ks, before) == 9, "wrong size after merge in front");
+	succeed_if (ksAppend (ks, after) == 11, "wrong size after merge at end");
+	succeed_if_same_string (keyName (ksAtCursor (ks, 0)), "dir:/x");
+	succeed_if_same_string (keyName (ksAtCursor (ks, 1)), "dir:/y");
+	succeed_if_same_string (keyName (ksAtCursor (ks, 2)), "user:/a");
+	succeed_if_same_string (keyName (ksAtCursor (ks, 10)), "user:/z/2");
+	succeed_if (ksLookupByName (ks, "user:/f", 0) != 0, "key not found after merge");
+
+	// merging a keyset that is already contained
+	succeed_if (ksAppend (ks, toAppend) == 11, "size changed when appending contained keys");
+	succeed_if (ksAppend (ks, ks) == 11, "size changed when appending keyset to itself");
+
+	ksDel (before);
+	ksDel (after);
+	ksDel (toAppend);
+	ksDel (ks);
+}
+
 
 int main (int argc, char ** argv)
 {
@@ -2898,6 +2980,7 @@ int main (int argc, char ** argv)
 #ifndef __SANITIZE_ADDRESS__
 	test_ksLookupPop ();
 #endif
+	test_ksPopAllAfterLookup ();
 	test_ksSync ();
 	test_ksDoubleFree ();
 	test_ksDoubleAppend ();
@@ -2923,6 +3006,7 @@ int main (int argc, char ** argv)
 	test_nsLookup ();
 	test_ksAppend2 ();
 	test_ksAppend3 ();
+	test_ksAppendMerge ();
 	test_ksOrderNs ();
 
 	printf ("\ntestabi_ks RESULTS: %d test(s) done. %d error(s).\n", nbTest, nbError);
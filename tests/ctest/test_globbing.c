@@ -161,6 +161,39 @@ static void test_keyset (void)
 	ksDel (actual);
 }
 
+static void test_keyset_prefix (void)
+{
+	printf ("keyset prefix\n");
+
+	KeySet * test = ksNew (8, keyNew ("/tests/globbing/yes/a", KEY_END), keyNew (BASE_KEY "/yes", KEY_END),
+			       keyNew (BASE_KEY "/yes/a", KEY_END), keyNew (BASE_KEY "/yes/#0", KEY_END),
+			       keyNew (BASE_KEY "/yes/a/b", KEY_END), keyNew (BASE_KEY "/yesno/a", KEY_END),
+			       keyNew ("system:/tests/globbing/yes/a", KEY_END), KS_END);
+
+	KeySet * actual = ksNew (0, KS_END);
+	succeed_if (elektraKsGlob (actual, test, BASE_KEY "/yes/*") == 2, "wrong number of matching keys");
+	succeed_if (ksLookupByName (actual, BASE_KEY "/yes/a", 0) != NULL, BASE_KEY "/yes/a not found");
+	succeed_if (ksLookupByName (actual, BASE_KEY "/yes/#0", 0) != NULL, BASE_KEY "/yes/#0 not found");
+	ksClear (actual);
+
+	succeed_if (elektraKsGlob (actual, test, BASE_KEY "/yes/#") == 1, "wrong number of matching keys");
+	succeed_if (elektraKsGlob (actual, test, BASE_KEY "/yes/__") == 4, "wrong number of matching keys");
+	ksClear (actual);
+
+	succeed_if (elektraKsGlob (actual, test, BASE_KEY "/yes") == 1, "wrong number of matching keys");
+	succeed_if (elektraKsGlob (actual, test, "user:/tests/globbing/ye?/a") == 1, "wrong number of matching keys");
+	ksClear (actual);
+
+	// patterns without literal namespace or non-canonical prefix
+	succeed_if (elektraKsGlob (actual, test, "*:/tests/globbing/yes/a") == 2, "wrong number of matching keys");
+	succeed_if (elektraKsGlob (actual, test, "/tests/globbing/yes/*") == 1, "wrong number of matching keys");
+	ksClear (actual);
+	succeed_if (elektraKsGlob (actual, test, "user:/tests//globbing/yes/*") == 0, "wrong number of matching keys");
+
+	ksDel (test);
+	ksDel (actual);
+}
+
 int main (int argc, char ** argv)
 {
 	printf (" GLOBBING   TESTS\n");
@@ -174,6 +207,7 @@ int main (int argc, char ** argv)
 	test_underscore ();
 	test_prefix ();
 	test_keyset ();
+	test_keyset_prefix ();
 
 	print_result ("test_globbing");
 
@@ -910,6 +910,92 @@ static void test_escapePart (void)
 
 #undef TEST_ESCAPE_PART_OK
 
+static void checkName (Key * key, const char * prefix, const char * name)
+{
+	// compute the expected name without keySetName() and keyAddName()
+	char * canonical = prefix == NULL ? NULL : elektraStrDup (prefix);
+	size_t canonicalSize = prefix == NULL ? 0 : strlen (prefix) + 1;
+	size_t usize = prefix == NULL ? 0 : (size_t) keyGetUnescapedNameSize (key);
+	elektraKeyNameCanonicalize (name, &canonical, &canonicalSize, canonicalSize, &usize);
+	char * unescaped = elektraMalloc (usize);
+	elektraKeyNameUnescape (canonical, unescaped);
+
+	if (prefix == NULL)
+	{
+		succeed_if_fmt (keySetName (key, name) == (ssize_t) canonicalSize, "keySetName '%s' returned wrong size", name);
+	}
+	else
+	{
+		succeed_if_fmt (keyAddName (key, name) == (ssize_t) canonicalSize, "keyAddName '%s' + '%s' returned wrong size", prefix,
+				name);
+	}
+	succeed_if_same_string (keyName (key), canonical);
+	succeed_if_fmt (keyGetUnescapedNameSize (key) == (ssize_t) usize, "wrong unescaped size for '%s'", canonical);
+	succeed_if_fmt (memcmp (keyUnescapedName (key), unescaped, usize) == 0, "wrong unescaped name for '%s'", canonical);
+
+	elektraFree (canonical);
+	elektraFree (unescaped);
+}
+
+static void test_simpleNames (void)
+{
+	// names with slashes and special characters at the borders of 16 byte chunks
+	const char * names[] = { "/a",
+				 "user:/a",
+				 "system:/a/b/c",
+				 "meta:/type",
+				 "/sw/org/application/#0/current/section/key",
+				 "user:/sw/org/application/#0/current/section/key",
+				 "user:/0123456789abcde/0123456789abcde/0123456789abcde",
+				 "user:/0123456789abcdef/0123456789abcdef/0123456789abcdef",
+				 "user:/0123456789abcdef/.hidden/0123456789abcdef",
+				 "user:/0123456789abcdef/..",
+				 "user:/0123456789abcde/.",
+				 "user:/0123456789abcde//0123456789abcde",
+				 "user:/0123456789abcdef/#10/0123456789abcdef",
+				 "user:/0123456789abcdef/#_10/0123456789abcdef",
+				 "user:/0123456789abcdef/%/0123456789abcdef",
+				 "user:/0123456789abcde/%/0123456789abcdef",
+				 "user:/0123456789abcdef0123456789/a\\/b/c",
+				 "user:/0123456789abcdef0123456789/a\\\\/b/c",
+				 "user:/0123456789abcdef0123456789abcdef/",
+				 "user:/0123456789abcde/0123456789abcdef/",
+				 "user:/a.b/c%d/e#f/g:h",
+				 "user:/#/#0/#1a/#_12/#12a/#12/.hidden/..x/%a/a",
+				 "user:/0123456789abcde/#12/0123456789abcde/#_12/0123456789abcde/#1",
+				 "user:/0123456789abcdef/.hidden/..x/%a/0123456789abcdef/%",
+				 "user:/0123456789abcdef/0123456789abcde/#",
+				 "/",
+				 "user:/",
+				 "user://",
+				 NULL };
+
+	Key * key = keyNew ("/", KEY_END);
+	for (const char ** name = names; *name != NULL; ++name)
+	{
+		checkName (key, NULL, *name);
+	}
+
+	const char * prefixes[] = { "/", "user:/", "user:/a", "system:/0123456789abcdef/0123456789abcdef", NULL };
+	for (const char ** prefix = prefixes; *prefix != NULL; ++prefix)
+	{
+		for (const char ** name = names; *name != NULL; ++name)
+		{
+			const char * suffix = strchr (*name, ':') == NULL ? *name : strchr (*name, ':') + 1;
+			while (*suffix == '/')
+			{
+				++suffix;
+			}
+			if (*suffix == '\0' || !elektraKeyNameValidate (suffix, false)) continue;
+
+			keySetName (key, *prefix);
+			checkName (key, *prefix, suffix);
+		}
+	}
+
+	keyDel (key);
+}
+
 int main (int argc, char ** argv)
 {
 	printf (" KEYNAME   TESTS\n");
@@ -921,6 +1007,7 @@ int main (int argc, char ** argv)
 	test_canonicalize ();
 	test_unescape ();
 	test_escapePart ();
+	test_simpleNames ();
 
 	print_result ("test_keyname");
 
@@ -65,6 +65,58 @@ static void test_cascadingLookup (void)
 	ksDel (ks);
 }
 
+static void test_cascadingLookupNamespaces (void)
+{
+	printf ("test cascading lookup namespaces\n");
+	Key * cascading;
+	Key * proc;
+	Key * user;
+	Key * userBelow;
+	Key * system;
+	Key * def;
+	KeySet * ks = ksNew (10, cascading = keyNew ("/a", KEY_END), keyNew ("proc:/", KEY_END), proc = keyNew ("proc:/b", KEY_END),
+			     user = keyNew ("user:/a", KEY_END), userBelow = keyNew ("user:/a/b", KEY_END), keyNew ("user:/ab", KEY_END),
+			     system = keyNew ("system:/a", KEY_END), keyNew ("system:/b", KEY_END), def = keyNew ("default:/c", KEY_END), KS_END);
+
+	Key * search = keyNew ("/a", KEY_END);
+	succeed_if (ksLookup (ks, search, 0) == user, "user key should be found first");
+	succeed_if (ksCurrent (ks) == user, "cursor not set to found key");
+	succeed_if_same_string (keyName (search), "/a");
+
+	ksRewind (ks);
+	keySetName (search, "/a/c");
+	succeed_if (ksLookup (ks, search, 0) == NULL, "found key that does not exist");
+	succeed_if (ksCurrent (ks) == NULL, "cursor changed on failed lookup");
+
+	keySetName (search, "/a/b");
+	succeed_if (ksLookup (ks, search, 0) == userBelow, "wrong key found");
+	keySetName (search, "/b");
+	succeed_if (ksLookup (ks, search, 0) == proc, "proc key should be found first");
+	keySetName (search, "/c");
+	succeed_if (ksLookup (ks, search, 0) == def, "default key not found");
+	succeed_if (ksLookup (ks, search, KDB_O_NODEFAULT) == def, "default namespace should be searched with KDB_O_NODEFAULT");
+
+	// lookup with keys of the keyset, which have a read-only name
+	succeed_if (ksLookup (ks, cascading, 0) == user, "lookup with read-only name failed");
+	succeed_if_same_string (keyName (cascading), "/a");
+
+	ksDel (ksCut (ks, user));
+	succeed_if (ksLookup (ks, cascading, 0) == system, "system key should be found after user key was removed");
+	ksDel (ksCut (ks, system));
+	succeed_if (ksLookup (ks, cascading, 0) == cascading, "cascading key should be found last");
+	succeed_if (ksLookup (ks, cascading, KDB_O_NODEFAULT) == NULL, "cascading key should not be found with KDB_O_NODEFAULT");
+
+	// spec keys decide about the namespaces
+	ksAppendKey (ks, keyNew ("spec:/b", KEY_META, "namespace/#0", "system", KEY_END));
+	ksAppendKey (ks, system = keyNew ("system:/b", KEY_END));
+	keySetName (search, "/b");
+	succeed_if (ksLookup (ks, search, 0) == ksLookupByName (ks, "system:/b", 0), "spec key not used");
+	succeed_if (ksLookup (ks, search, KDB_O_NOSPEC) == proc, "spec key used with KDB_O_NOSPEC");
+
+	keyDel (search);
+	ksDel (ks);
+}
+
 static void test_creatingLookup (void)
 {
 	printf ("Test creating lookup\n");
@@ -189,6 +241,122 @@ static void test_ksNoAlloc (void)
 	ksDel (ks);
 }
 
+static void test_ksFindHierarchy (void)
+{
+	printf ("Test find hierarchy\n");
+
+	KeySet * ks = ksNew (20, keyNew ("/a/b", KEY_END), keyNew ("user:/", KEY_END), keyNew ("user:/a", KEY_END),
+			     keyNew ("user:/a/b", KEY_END), keyNew ("user:/a/b/c", KEY_END), keyNew ("user:/a/b/c/d", KEY_END),
+			     keyNew ("user:/a/bb", KEY_END), keyNew ("user:/a/b\\/c", KEY_END), keyNew ("user:/b", KEY_END),
+			     keyNew ("system:/a/b", KEY_END), KS_END);
+	elektraCursor end;
+	elektraCursor start;
+
+	Key * root = keyNew ("user:/a/b", KEY_END);
+	start = ksFindHierarchy (ks, root, &end);
+	succeed_if (end - start == 3, "wrong number of keys below user:/a/b");
+	succeed_if_same_string (keyName (ksAtCursor (ks, start)), "user:/a/b");
+	succeed_if_same_string (keyName (ksAtCursor (ks, end - 1)), "user:/a/b/c/d");
+
+	keySetName (root, "user:/");
+	start = ksFindHierarchy (ks, root, &end);
+	succeed_if (end - start == 8, "wrong number of keys below user:/");
+	succeed_if_same_string (keyName (ksAtCursor (ks, start)), "user:/");
+	succeed_if_same_string (keyName (ksAtCursor (ks, end - 1)), "user:/b");
+
+	keySetName (root, "user:/a/b/c/d/e");
+	start = ksFindHierarchy (ks, root, &end);
+	succeed_if (start == end, "found keys below user:/a/b/c/d/e");
+	succeed_if (start == 6, "empty range not at insert position");
+
+	keySetName (root, "/a");
+	start = ksFindHierarchy (ks, root, &end);
+	succeed_if (start == 0 && end == 1, "cascading root should only find cascading keys");
+
+	keySetName (root, "spec:/");
+	start = ksFindHierarchy (ks, root, &end);
+	succeed_if (start == end, "found keys in empty namespace");
+
+	keySetName (root, "system:/a/b");
+	start = ksFindHierarchy (ks, root, &end);
+	succeed_if (end - start == 1 && end == ksGetSize (ks), "wrong range at end of keyset");
+
+	succeed_if (ksFindHierarchy (NULL, root, &end) == -1, "should fail on NULL keyset");
+	succeed_if (ksFindHierarchy (ks, NULL, &end) == -1, "should fail on NULL root");
+	succeed_if (ksFindHierarchy (ks, root, NULL) == -1, "should fail on NULL end");
+
+	keyDel (root);
+	ksDel (ks);
+}
+
+static void test_ksPrefixes (void)
+{
+	printf ("Test name prefixes\n");
+
+	const int size = 3 * KEYSET_PREFIX_MINSIZE;
+	char name[64];
+	KeySet * ks = ksNew (0, KS_END);
+	for (int i = 0; i < size; ++i)
+	{
+		snprintf (name, sizeof (name), "user:/tests/prefixes/key%d", (i * 7) % size);
+		ksAppendKey (ks, keyNew (name, KEY_VALUE, "old", KEY_END));
+	}
+	succeed_if (ks->prefixes == NULL, "prefixes built without lookup");
+
+	succeed_if (ksLookupByName (ks, "user:/tests/prefixes/key0", KDB_O_BINSEARCH) != NULL, "key not found");
+	exit_if_fail (ks->prefixes != NULL, "prefixes not built by lookup");
+	// the namespace and the separators take one byte each in the unescaped name
+	succeed_if (ks->prefixSkip == strlen ("/tests/prefixes/key") + 1, "wrong number of skipped bytes");
+
+	// replaced, inserted and popped keys keep the prefixes up to date
+	for (int i = 0; i < size; i += 2)
+	{
+		snprintf (name, sizeof (name), "user:/tests/prefixes/key%d", i);
+		ksAppendKey (ks, keyNew (name, KEY_VALUE, "new", KEY_END));
+		snprintf (name, sizeof (name), "user:/tests/prefixes/key%d/below", i + 1);
+		ksAppendKey (ks, keyNew (name, KEY_END));
+	}
+	succeed_if (ksGetSize (ks) == size + size / 2, "wrong size after appending");
+	for (int i = 0; i < size; i += 3)
+	{
+		snprintf (name, sizeof (name), "user:/tests/prefixes/key%d", i);
+		Key * popped = ksLookupByName (ks, name, KDB_O_POP | KDB_O_BINSEARCH);
+		succeed_if (popped != NULL, "key not popped");
+		keyDel (popped);
+	}
+	succeed_if (ks->prefixes != NULL, "prefixes dropped");
+
+	for (int i = 0; i < size; ++i)
+	{
+		snprintf (name, sizeof (name), "user:/tests/prefixes/key%d", i);
+		Key * found = ksLookupByName (ks, name, KDB_O_BINSEARCH);
+		if (i % 3 == 0)
+		{
+			succeed_if (found == NULL, "popped key found");
+			continue;
+		}
+		exit_if_fail (found != NULL, "key not found");
+		succeed_if_same_string (keyName (found), name);
+		succeed_if_same_string (keyString (found), i % 2 == 0 ? "new" : "old");
+
+		snprintf (name, sizeof (name), "user:/tests/prefixes/key%d/below", i);
+		succeed_if ((ksLookupByName (ks, name, KDB_O_BINSEARCH) != NULL) == (i % 2 == 1), "wrong key below found");
+	}
+	succeed_if (ksLookupByName (ks, "user:/tests/prefixes/key", KDB_O_BINSEARCH) == NULL, "found missing key");
+	succeed_if (ksLookupByName (ks, "user:/tests/prefixes", KDB_O_BINSEARCH) == NULL, "found missing key");
+	succeed_if (ksLookupByName (ks, "system:/tests/prefixes/key1", KDB_O_BINSEARCH) == NULL, "found missing key");
+
+	// keys without the skipped bytes drop the prefixes
+	ksAppendKey (ks, keyNew ("user:/tests/other", KEY_END));
+	succeed_if (ks->prefixes == NULL, "prefixes not dropped");
+	succeed_if (ksLookupByName (ks, "user:/tests/other", KDB_O_BINSEARCH) != NULL, "key not found");
+	succeed_if (ks->prefixes != NULL, "prefixes not built again");
+	succeed_if (ks->prefixSkip == strlen ("/tests/") + 1, "wrong number of skipped bytes");
+	succeed_if (ksLookupByName (ks, "user:/tests/prefixes/key1", KDB_O_BINSEARCH) != NULL, "key not found");
+
+	ksDel (ks);
+}
+
 int main (int argc, char ** argv)
 {
 	printf ("KS         TESTS\n");
@@ -199,8 +367,11 @@ int main (int argc, char ** argv)
 	test_ksToArray ();
 	test_ksRenameKeys ();
 	test_cascadingLookup ();
+	test_cascadingLookupNamespaces ();
 	test_creatingLookup ();
 	test_ksNoAlloc ();
+	test_ksFindHierarchy ();
+	test_ksPrefixes ();
 
 	printf ("\ntest_ks RESULTS: %d test(s) done. %d error(s).\n", nbTest, nbError);
 
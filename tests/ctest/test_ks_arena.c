@@ -0,0 +1,194 @@
+/**
+ * @file
+ *
+ * @brief Tests for KeySets with arena allocated keys.
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ */
+
+#include <tests_internal.h>
+
+static void test_arenaKeyNew (void)
+{
+	printf ("test arena key new\n");
+
+	KeySet * ks = ksNewArena (0, 0);
+	exit_if_fail (ks, "could not create arena keyset");
+	succeed_if (ks->arena, "no arena");
+
+	Key * k = ksArenaKeyNew (ks, "user:/tests/arena//a/../b/", "value");
+	exit_if_fail (k, "could not create arena key");
+	succeed_if_same_string (keyName (k), "user:/tests/arena/b");
+	succeed_if_same_string (keyBaseName (k), "b");
+	succeed_if_same_string (keyString (k), "value");
+	succeed_if (keyGetValueSize (k) == sizeof ("value"), "wrong value size");
+	succeed_if (keyGetRef (k) == 0, "new key referenced");
+	succeed_if (test_bit (k->flags, KEY_FLAG_ARENA), "key not in arena");
+
+	Key * empty = ksArenaKeyNew (ks, "/tests/arena/empty", NULL);
+	exit_if_fail (empty, "could not create arena key");
+	Key * plain = keyNew ("/tests/arena/empty", KEY_END);
+	succeed_if (keyGetValueSize (empty) == keyGetValueSize (plain), "value not empty");
+	succeed_if_same_string (keyString (empty), keyString (plain));
+	keyDel (plain);
+
+	succeed_if (ksArenaKeyNew (ks, "invalid", "value") == NULL, "invalid name accepted");
+	KeySet * noArena = ksNew (0, KS_END);
+	succeed_if (ksArenaKeyNew (noArena, "user:/tests/arena", "value") == NULL, "keyset without arena accepted");
+	ksDel (noArena);
+
+	ksAppendKey (ks, k);
+	ksAppendKey (ks, empty);
+	ksAppendKey (ks, keyNew ("user:/tests/arena/heap", KEY_VALUE, "heap", KEY_END));
+	succeed_if (ksGetSize (ks) == 3, "wrong size");
+	succeed_if (ksLookupByName (ks, "user:/tests/arena/b", 0) == k, "key not found");
+
+	ksDel (ks);
+}
+
+static void test_arenaModify (void)
+{
+	printf ("test arena key modify\n");
+
+	KeySet * ks = ksNewArena (0, 64);
+	Key * k = ksArenaKeyNew (ks, "user:/tests/arena/key", "value");
+	exit_if_fail (k, "could not create arena key");
+
+	succeed_if (keySetName (k, "system:/tests/arena/renamed") > 0, "could not rename");
+	succeed_if_same_string (keyName (k), "system:/tests/arena/renamed");
+	succeed_if (!test_bit (k->flags, KEY_FLAG_MMAP_KEY), "name still in arena");
+	succeed_if (keyAddBaseName (k, "sub") > 0, "could not add base name");
+	succeed_if_same_string (keyName (k), "system:/tests/arena/renamed/sub");
+
+	succeed_if (keySetString (k, "a longer value than before") > 0, "could not set value");
+	succeed_if_same_string (keyString (k), "a longer value than before");
+	succeed_if (!test_bit (k->flags, KEY_FLAG_MMAP_DATA), "value still in arena");
+
+	succeed_if (keySetMeta (k, "meta:/tests", "meta value") > 0, "could not set meta");
+	succeed_if_same_string (keyString (keyGetMeta (k, "meta:/tests")), "meta value");
+
+	Key * ns = ksArenaKeyNew (ks, "user:/tests/arena/namespace", "value");
+	succeed_if (keySetNamespace (ns, KEY_NS_SYSTEM) > 0, "could not set namespace");
+	succeed_if_same_string (keyName (ns), "system:/tests/arena/namespace");
+	keyDel (ns);
+
+	Key * copy = ksArenaKeyNew (ks, "user:/tests/arena/copy", "value");
+	Key * source = keyNew ("user:/tests/arena/source", KEY_VALUE, "source", KEY_END);
+	succeed_if (keyCopy (copy, source) == 1, "could not copy");
+	succeed_if_same_string (keyName (copy), "user:/tests/arena/source");
+	succeed_if_same_string (keyString (copy), "source");
+	keyDel (source);
+	succeed_if (keyClear (copy) == 0, "could not clear");
+	succeed_if (test_bit (copy->flags, KEY_FLAG_ARENA), "arena flag lost");
+	keyDel (copy);
+
+	Key * dup = keyDup (k);
+	succeed_if (!test_bit (dup->flags, KEY_FLAG_ARENA), "duplicate in arena");
+	succeed_if_same_string (keyName (dup), "system:/tests/arena/renamed/sub");
+
+	keyDel (k);
+	ksDel (ks);
+	keyDel (dup);
+}
+
+static void test_arenaLifetime (void)
+{
+	printf ("test arena lifetime\n");
+
+	// many keys to fill several blocks
+	KeySet * ks = ksNewArena (0, 128);
+	KeySet * other = ksNew (0, KS_END);
+	char name[64];
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		snprintf (name, sizeof (name), "user:/tests/arena/%zu", i);
+		Key * k = ksArenaKeyNew (ks, name, name);
+		exit_if_fail (k, "could not create arena key");
+		ksAppendKey (i % 2 ? ks : other, k);
+	}
+
+	Key * kept = ksLookupByName (ks, "user:/tests/arena/1", 0);
+	keyIncRef (kept);
+
+	// keys outlive the arena keyset
+	ksDel (ks);
+	succeed_if (ksGetSize (other) == 500, "wrong size");
+	succeed_if_same_string (keyString (ksLookupByName (other, "user:/tests/arena/998", 0)), "user:/tests/arena/998");
+	ksDel (other);
+
+	// the last key frees the arena
+	succeed_if_same_string (keyString (kept), "user:/tests/arena/1");
+	keyDecRef (kept);
+	keyDel (kept);
+}
+
+static void test_arenaDeepDup (void)
+{
+	printf ("test arena deep dup\n");
+
+	int binary = 42;
+	KeySet * ks = ksNew (3, keyNew ("user:/tests/arena/a", KEY_VALUE, "a", KEY_META, "type", "string", KEY_END),
+			     keyNew ("user:/tests/arena/b", KEY_BINARY, KEY_SIZE, sizeof (binary), KEY_VALUE, &binary, KEY_END),
+			     keyNew ("user:/tests/arena/c", KEY_END), KS_END);
+	keyClearSync (ksLookupByName (ks, "user:/tests/arena/c", 0));
+	keySetMeta (ksLookupByName (ks, "user:/tests/arena/c", 0), "owner", "hugo");
+
+	KeySet * dup = ksDeepDup (ks);
+	exit_if_fail (dup, "could not duplicate keyset");
+	succeed_if (dup->arena, "duplicate has no arena");
+	succeed_if (ksGetSize (dup) == 3, "wrong size");
+
+	for (elektraCursor it = 0; it < ksGetSize (dup); ++it)
+	{
+		Key * orig = ksAtCursor (ks, it);
+		Key * copy = ksAtCursor (dup, it);
+		succeed_if (orig != copy, "key not duplicated");
+		succeed_if (test_bit (copy->flags, KEY_FLAG_ARENA), "duplicate not in arena");
+		succeed_if (keyGetRef (copy) == 1, "wrong reference count");
+		succeed_if (keyIsLocked (copy, KEY_LOCK_NAME), "name not locked");
+		succeed_if (!keyIsLocked (copy, KEY_LOCK_VALUE), "value locked");
+		succeed_if (keyCmp (orig, copy) == 0, "names differ");
+		succeed_if (keyGetValueSize (orig) == keyGetValueSize (copy), "value sizes differ");
+		succeed_if (memcmp (keyValue (orig), keyValue (copy), keyGetValueSize (orig)) == 0, "values differ");
+		succeed_if (keyNeedSync (orig) == keyNeedSync (copy), "sync state differs");
+	}
+
+	Key * a = ksLookupByName (dup, "user:/tests/arena/a", 0);
+	succeed_if_same_string (keyString (keyGetMeta (a, "type")), "string");
+	keySetMeta (a, "type", "long");
+	succeed_if_same_string (keyString (keyGetMeta (ksLookupByName (ks, "user:/tests/arena/a", 0), "type")), "string");
+	keySetString (a, "changed");
+	succeed_if_same_string (keyString (ksLookupByName (ks, "user:/tests/arena/a", 0)), "a");
+	succeed_if (ksLookupByName (dup, "user:/tests/arena/c", 0)->flags & KEY_FLAG_OWNER, "owner flag not copied");
+
+	// duplicates outlive both keysets
+	keyIncRef (a);
+	ksDel (ks);
+	ksDel (dup);
+	succeed_if_same_string (keyString (a), "changed");
+	keyDecRef (a);
+	keyDel (a);
+
+	KeySet * empty = ksNew (0, KS_END);
+	KeySet * emptyDup = ksDeepDup (empty);
+	succeed_if (ksGetSize (emptyDup) == 0, "duplicate of empty keyset not empty");
+	ksDel (empty);
+	ksDel (emptyDup);
+}
+
+int main (int argc, char ** argv)
+{
+	printf ("KS ARENA   TESTS\n");
+	printf ("==================\n\n");
+
+	init (argc, argv);
+
+	test_arenaKeyNew ();
+	test_arenaModify ();
+	test_arenaLifetime ();
+	test_arenaDeepDup ();
+
+	printf ("\ntest_ks_arena RESULTS: %d test(s) done. %d error(s).\n", nbTest, nbError);
+
+	return nbError;
+}
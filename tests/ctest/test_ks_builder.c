@@ -0,0 +1,125 @@
+/**
+ * @file
+ *
+ * @brief Tests for the bulk construction of KeySets.
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ */
+
+#include <tests_internal.h>
+
+static void test_builderSorted (void)
+{
+	printf ("test builder sorted\n");
+
+	ElektraKsBuilder * builder = elektraKsBuilderNew (0);
+	exit_if_fail (builder, "could not create builder");
+
+	Key * parent = keyNew ("user:/tests/builder", KEY_VALUE, "parent", KEY_END);
+	succeed_if (elektraKsBuilderAdd (builder, keyDup (parent)) == 1, "wrong size");
+	char name[64];
+	for (size_t i = 0; i < 100; ++i)
+	{
+		snprintf (name, sizeof (name), "#_%zu/key", 10 + i);
+		Key * k = elektraKsBuilderAddBelow (builder, parent, name, name);
+		exit_if_fail (k, "could not add key below parent");
+		succeed_if (keyGetRef (k) == 1, "key not referenced by builder");
+		succeed_if (keyIsLocked (k, KEY_LOCK_NAME), "name not locked");
+	}
+	succeed_if (elektraKsBuilderAddBelow (builder, parent, "invalid\\", "value") == NULL, "invalid name accepted");
+	succeed_if (elektraKsBuilderAdd (builder, keyNew (0)) == -1, "key without name accepted");
+
+	KeySet * ks = elektraKsBuilderFinish (builder);
+	exit_if_fail (ks, "could not finish builder");
+	succeed_if (ksGetSize (ks) == 101, "wrong size");
+	succeed_if_same_string (keyName (ksAtCursor (ks, 0)), "user:/tests/builder");
+	succeed_if_same_string (keyString (ksAtCursor (ks, 0)), "parent");
+
+	Key * k = ksLookupByName (ks, "user:/tests/builder/#_15/key", 0);
+	exit_if_fail (k, "key not found");
+	succeed_if_same_string (keyString (k), "#_15/key");
+	succeed_if (keyGetRef (k) == 1, "wrong reference count");
+
+	ksAppendKey (ks, keyNew ("user:/tests/builder/#_50/appended", KEY_END));
+	succeed_if (ksGetSize (ks) == 102, "could not append to built keyset");
+	succeed_if (ksLookupByName (ks, "user:/tests/builder/#_50/appended", 0), "appended key not found");
+
+	keyDel (parent);
+	ksDel (ks);
+}
+
+static void test_builderUnsorted (void)
+{
+	printf ("test builder unsorted\n");
+
+	ElektraKsBuilder * builder = elektraKsBuilderNew (1000);
+	exit_if_fail (builder, "could not create builder");
+
+	Key * parent = keyNew ("system:/tests/builder", KEY_END);
+	char name[64];
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		// every key is added twice, the second value has to win
+		snprintf (name, sizeof (name), "%zu", (i * 7919) % 500);
+		exit_if_fail (elektraKsBuilderAddBelow (builder, parent, name, i < 500 ? "first" : "second"), "could not add key");
+	}
+	Key * shared = keyNew ("system:/tests/builder/shared", KEY_END);
+	elektraKsBuilderAdd (builder, shared);
+	elektraKsBuilderAdd (builder, shared);
+
+	KeySet * ks = elektraKsBuilderFinish (builder);
+	exit_if_fail (ks, "could not finish builder");
+	succeed_if (ksGetSize (ks) == 501, "wrong size");
+	succeed_if (keyGetRef (shared) == 1, "wrong reference count of shared key");
+
+	for (elektraCursor it = 0; it < ksGetSize (ks); ++it)
+	{
+		Key * cur = ksAtCursor (ks, it);
+		if (cur == shared) continue;
+		succeed_if_same_string (keyString (cur), "second");
+		if (it > 0) succeed_if (keyCmp (ksAtCursor (ks, it - 1), cur) < 0, "keys not sorted");
+	}
+	succeed_if (ksLookupByName (ks, "system:/tests/builder/499", 0), "key not found");
+
+	keyDel (parent);
+	ksDel (ks);
+}
+
+static void test_builderDel (void)
+{
+	printf ("test builder del\n");
+
+	ElektraKsBuilder * builder = elektraKsBuilderNew (0);
+	Key * kept = keyNew ("user:/tests/builder/kept", KEY_END);
+	keyIncRef (kept);
+	elektraKsBuilderAdd (builder, kept);
+	elektraKsBuilderAdd (builder, keyNew ("user:/tests/builder/deleted", KEY_END));
+	elektraKsBuilderDel (builder);
+	succeed_if (keyGetRef (kept) == 1, "reference of builder not released");
+	keyDecRef (kept);
+	keyDel (kept);
+
+	elektraKsBuilderDel (NULL);
+	succeed_if (elektraKsBuilderFinish (NULL) == NULL, "finished NULL builder");
+	succeed_if (elektraKsBuilderAdd (NULL, NULL) == -1, "added to NULL builder");
+
+	KeySet * empty = elektraKsBuilderFinish (elektraKsBuilderNew (0));
+	succeed_if (ksGetSize (empty) == 0, "empty builder not empty");
+	ksDel (empty);
+}
+
+int main (int argc, char ** argv)
+{
+	printf ("KS BUILDER TESTS\n");
+	printf ("==================\n\n");
+
+	init (argc, argv);
+
+	test_builderSorted ();
+	test_builderUnsorted ();
+	test_builderDel ();
+
+	printf ("\ntest_ks_builder RESULTS: %d test(s) done. %d error(s).\n", nbTest, nbError);
+
+	return nbError;
+}
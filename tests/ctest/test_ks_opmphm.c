@@ -209,10 +209,12 @@ void test_Invalidate (void)
 		succeed_if (opmphmIsBuild (ks->opmphm), "build opmphm");
 
 		// insert new one
-		succeed_if (ksAppendKey (ks, keyNew ("/k", KEY_END)) > 0, "invalidate");
+		succeed_if (ksAppendKey (ks, keyNew ("/k", KEY_END)) > 0, "record insertion");
 
 		exit_if_fail (ks->opmphm, "build opmphm");
-		succeed_if (!opmphmIsBuild (ks->opmphm), "empty opmphm");
+		succeed_if (opmphmIsBuild (ks->opmphm), "build opmphm");
+		exit_if_fail (ks->opmphmDelta, "delta");
+		succeed_if (ks->opmphmDelta->size == 1, "one change");
 
 		// cleanup
 		ksDel (ks);
@@ -314,10 +316,12 @@ void test_Invalidate (void)
 		succeed_if (opmphmIsBuild (ks->opmphm), "build opmphm");
 
 		Key * popKey = ksPop (ks);
-		succeed_if (popKey, "invalidate");
+		succeed_if (popKey, "record removal");
 
 		exit_if_fail (ks->opmphm, "build opmphm");
-		succeed_if (!opmphmIsBuild (ks->opmphm), "empty opmphm");
+		succeed_if (opmphmIsBuild (ks->opmphm), "build opmphm");
+		exit_if_fail (ks->opmphmDelta, "delta");
+		succeed_if (ks->opmphmDelta->size == 1, "one change");
 
 		// cleanup
 		ksDel (ks);
@@ -337,10 +341,12 @@ void test_Invalidate (void)
 		succeed_if (opmphmIsBuild (ks->opmphm), "build opmphm");
 
 		Key * popKey = elektraKsPopAtCursor (ks, 1);
-		succeed_if (popKey, "invalidate");
+		succeed_if (popKey, "record removal");
 
 		exit_if_fail (ks->opmphm, "build opmphm");
-		succeed_if (!opmphmIsBuild (ks->opmphm), "empty opmphm");
+		succeed_if (opmphmIsBuild (ks->opmphm), "build opmphm");
+		exit_if_fail (ks->opmphmDelta, "delta");
+		succeed_if (ks->opmphmDelta->size == 1, "one change");
 
 		// cleanup
 		ksDel (ks);
@@ -348,6 +354,89 @@ void test_Invalidate (void)
 	}
 }
 
+void test_Delta (void)
+{
+	const size_t n = 100;
+	char name[32];
+	KeySet * ks = ksNew (n, KS_END);
+	for (size_t i = 0; i < n; i += 2)
+	{
+		snprintf (name, sizeof (name), "/key%03zu", i);
+		ksAppendKey (ks, keyNew (name, KEY_END));
+	}
+
+	// trigger build
+	succeed_if (ksLookupByName (ks, "/key000", KDB_O_OPMPHM), "key found");
+	exit_if_fail (ks->opmphm, "build opmphm");
+	succeed_if (opmphmIsBuild (ks->opmphm), "build opmphm");
+
+	// mix insertions and removals below OPMPHM_DELTA_MAX
+	for (size_t i = 1; i < 20; i += 2)
+	{
+		snprintf (name, sizeof (name), "/key%03zu", i);
+		succeed_if (ksAppendKey (ks, keyNew (name, KEY_END)) > 0, "append");
+	}
+	keyDel (ksLookupByName (ks, "/key010", KDB_O_POP | KDB_O_BINSEARCH));
+	keyDel (ksLookupByName (ks, "/key011", KDB_O_POP | KDB_O_BINSEARCH));
+	keyDel (ksPop (ks));
+	// re-insert a removed one
+	succeed_if (ksAppendKey (ks, keyNew ("/key010", KEY_END)) > 0, "append");
+
+	succeed_if (opmphmIsBuild (ks->opmphm), "build opmphm");
+	exit_if_fail (ks->opmphmDelta, "delta");
+	succeed_if (ks->opmphmDelta->size == 14, "changes recorded");
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		snprintf (name, sizeof (name), "/key%03zu", i);
+		int exists = (i < 20 || i % 2 == 0) && i != 11 && i != n - 2;
+		Key * found = ksLookupByName (ks, name, KDB_O_OPMPHM);
+		if (exists)
+		{
+			succeed_if (found, "key found");
+			if (found)
+			{
+				succeed_if_same_string (keyName (found), name);
+				succeed_if (ksGetCursor (ks) >= 0 && ks->array[ksGetCursor (ks)] == found, "cursor at found key");
+			}
+		}
+		else
+		{
+			succeed_if (!found, "key not found");
+		}
+	}
+	succeed_if (opmphmIsBuild (ks->opmphm), "lookups do not rebuild");
+
+	// pop through the OPMPHM
+	Key * popped = ksLookupByName (ks, "/key013", KDB_O_POP | KDB_O_OPMPHM);
+	succeed_if (popped, "key popped");
+	succeed_if (!ksLookupByName (ks, "/key013", KDB_O_OPMPHM), "key removed");
+	succeed_if (ksLookupByName (ks, "/key014", KDB_O_OPMPHM), "key found");
+	keyDel (popped);
+
+	// too many changes fold in with the next build
+	for (size_t i = 21; i < n; i += 2)
+	{
+		snprintf (name, sizeof (name), "/key%03zu", i);
+		ksAppendKey (ks, keyNew (name, KEY_END));
+	}
+	succeed_if (!opmphmIsBuild (ks->opmphm), "empty opmphm");
+	succeed_if (ks->opmphmDelta->size == 0, "delta cleared");
+
+	succeed_if (ksLookupByName (ks, "/key099", KDB_O_OPMPHM), "key found");
+	succeed_if (opmphmIsBuild (ks->opmphm), "rebuild opmphm");
+	succeed_if (ks->opmphmDelta->size == 0, "delta cleared");
+
+	// copies keep the changes
+	ksAppendKey (ks, keyNew ("/key100", KEY_END));
+	KeySet * copy = ksDup (ks);
+	succeed_if (ksLookupByName (copy, "/key100", KDB_O_OPMPHM), "key found in copy");
+	succeed_if (ksLookupByName (copy, "/key050", KDB_O_OPMPHM), "key found in copy");
+
+	ksDel (copy);
+	ksDel (ks);
+}
+
 int main (int argc, char ** argv)
 {
 	printf ("KS OPMPHM      TESTS\n");
@@ -358,6 +447,7 @@ int main (int argc, char ** argv)
 	test_keyNotFound ();
 	test_Copy ();
 	test_Invalidate ();
+	test_Delta ();
 
 	print_result ("test_ks_opmphm");
 
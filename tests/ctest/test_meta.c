@@ -309,6 +309,192 @@ static void test_top (void)
 	ksDel (testCycleOrder3);
 	elektraFree (array);
 }
+
+static void test_getMetaNames (void)
+{
+	printf ("test get meta names\n");
+
+	Key * key = keyNew ("user:/test", KEY_META, "type", "long", KEY_META, "check/range", "0-10", KEY_META, "array/#0", "a", KEY_META,
+			    "a\\/b", "escaped", KEY_META, "check", "all", KEY_END);
+
+	succeed_if_same_string (keyString (keyGetMeta (key, "type")), "long");
+	succeed_if_same_string (keyString (keyGetMeta (key, "meta:/type")), "long");
+	succeed_if_same_string (keyString (keyGetMeta (key, "/type/")), "long");
+	succeed_if_same_string (keyString (keyGetMeta (key, "check/range")), "0-10");
+	succeed_if_same_string (keyString (keyGetMeta (key, "check//range")), "0-10");
+	succeed_if_same_string (keyString (keyGetMeta (key, "check/./range")), "0-10");
+	succeed_if_same_string (keyString (keyGetMeta (key, "check/x/../range")), "0-10");
+	succeed_if_same_string (keyString (keyGetMeta (key, "check")), "all");
+	succeed_if_same_string (keyString (keyGetMeta (key, "array/#0")), "a");
+	succeed_if_same_string (keyString (keyGetMeta (key, "a\\/b")), "escaped");
+
+	succeed_if (keyGetMeta (key, "typ") == NULL, "found prefix of meta name");
+	succeed_if (keyGetMeta (key, "type/x") == NULL, "found key below meta name");
+	succeed_if (keyGetMeta (key, "check/rang") == NULL, "found prefix of meta name");
+	succeed_if (keyGetMeta (key, "a") == NULL, "found unescaped meta name");
+	succeed_if (keyGetMeta (key, "") == NULL, "found meta root");
+	succeed_if (keyGetMeta (key, "zzz") == NULL, "found meta name after last");
+
+	const Key * found = keyGetMeta (key, "check/range");
+	succeed_if (key->meta->cursor == found, "cursor not set to found meta key");
+
+	keyDel (key);
+}
+
+static void test_ownerFlag (void)
+{
+	printf ("test owner flag\n");
+
+	Key * k1 = keyNew ("user:/tests/owner", KEY_META, "type", "string", KEY_END);
+	Key * k2 = keyNew ("user:/tests/owner", KEY_END);
+	succeed_if (!test_bit (k1->flags, KEY_FLAG_OWNER), "owner flag set without owner");
+	succeed_if (keyCmp (k1, k2) == 0, "keys without owner not equal");
+
+	keySetMeta (k1, "ownerx", "hugo");
+	keySetMeta (k1, "own", "hugo");
+	succeed_if (!test_bit (k1->flags, KEY_FLAG_OWNER), "owner flag set for other metadata");
+
+	keySetMeta (k1, "owner", "hugo");
+	succeed_if (test_bit (k1->flags, KEY_FLAG_OWNER), "owner flag not set");
+	succeed_if (keyCmp (k1, k2) > 0, "key with owner not greater");
+	succeed_if (keyCmp (k2, k1) < 0, "key without owner not smaller");
+
+	Key * dup = keyDup (k1);
+	succeed_if (test_bit (dup->flags, KEY_FLAG_OWNER), "owner flag not copied by keyDup");
+	succeed_if (keyCmp (k1, dup) == 0, "duplicate not equal");
+
+	keyCopyMeta (k2, k1, "owner");
+	succeed_if (test_bit (k2->flags, KEY_FLAG_OWNER), "owner flag not copied by keyCopyMeta");
+	succeed_if (keyCmp (k1, k2) == 0, "keys with same owner not equal");
+
+	keyCopy (dup, k2);
+	succeed_if (test_bit (dup->flags, KEY_FLAG_OWNER), "owner flag not copied by keyCopy");
+	keyClear (dup);
+	succeed_if (!test_bit (dup->flags, KEY_FLAG_OWNER), "owner flag not cleared by keyClear");
+
+	// the owner might be changed without keySetMeta
+	ksAppendKey (keyMeta (dup), keyNew ("meta:/owner", KEY_VALUE, "gerald", KEY_END));
+	succeed_if (test_bit (dup->flags, KEY_FLAG_OWNER), "owner flag not set by keyMeta");
+	keySetName (dup, "user:/tests/owner");
+	succeed_if (keyCmp (k1, dup) > 0, "owner set with keyMeta ignored");
+
+	keyDel (k1);
+	keyDel (k2);
+	keyDel (dup);
+}
+
+static void test_sharedMeta (void)
+{
+	printf ("test shared meta\n");
+
+	Key * key = keyNew ("user:/tests/shared", KEY_META, "type", "string", KEY_META, "check/enum", "#1", KEY_END);
+	Key * dup = keyDup (key);
+	succeed_if (dup->meta == key->meta, "metadata not shared by keyDup");
+	succeed_if (key->meta->shared == 1, "wrong share count");
+	succeed_if_same_string (keyString (keyGetMeta (dup, "type")), "string");
+
+	keySetMeta (dup, "type", "long");
+	succeed_if (dup->meta != key->meta, "metadata still shared after change");
+	succeed_if (key->meta->shared == 0 && dup->meta->shared == 0, "wrong share count after change");
+	succeed_if_same_string (keyString (keyGetMeta (key, "type")), "string");
+	succeed_if_same_string (keyString (keyGetMeta (dup, "type")), "long");
+	succeed_if (keyGetMeta (key, "check/enum") == keyGetMeta (dup, "check/enum"), "meta keys not shared");
+
+	Key * copy = keyNew ("user:/tests/copy", KEY_END);
+	keyCopyAllMeta (copy, key);
+	succeed_if (copy->meta == key->meta, "metadata not shared by keyCopyAllMeta");
+	keyDel (key);
+	succeed_if (copy->meta->shared == 0, "share count not released by keyDel");
+	succeed_if_same_string (keyString (keyGetMeta (copy, "type")), "string");
+
+	keyCopy (dup, copy);
+	succeed_if (dup->meta == copy->meta, "metadata not shared by keyCopy");
+	KeySet * meta = keyMeta (dup);
+	succeed_if (meta != copy->meta, "keyMeta returned shared metadata");
+	ksAppendKey (meta, keyNew ("meta:/default", KEY_VALUE, "1", KEY_END));
+	succeed_if (keyGetMeta (copy, "default") == NULL, "change through keyMeta visible in other key");
+
+	keyCopy (copy, dup);
+	keyRewindMeta (copy);
+	succeed_if (copy->meta != dup->meta, "metadata not unshared by keyRewindMeta");
+	size_t count = 0;
+	while (keyNextMeta (copy))
+		++count;
+	succeed_if (count == 3, "wrong number of meta keys");
+
+	keyDel (dup);
+	keyDel (copy);
+}
+
+static void test_sharedMetaDupDuringIteration (void)
+{
+	printf ("test shared meta dup during iteration\n");
+
+	Key * key = keyNew ("user:/tests/shared", KEY_META, "a", "1", KEY_META, "b", "2", KEY_META, "c", "3", KEY_END);
+
+	keyRewindMeta (key);
+	succeed_if_same_string (keyName (keyNextMeta (key)), "meta:/a");
+	Key * dup = keyDup (key);
+	succeed_if_same_string (keyString (keyGetMeta (dup, "c")), "3");
+	const Key * next = keyNextMeta (key);
+	succeed_if (next != NULL, "iteration stopped by keyDup");
+	succeed_if_same_string (keyName (next), "meta:/b");
+	succeed_if_same_string (keyName (keyNextMeta (key)), "meta:/c");
+	succeed_if (keyNextMeta (key) == NULL, "iteration did not end");
+
+	// keys sharing metadata keep the cursor when they get their own copy
+	Key * other = keyNew ("user:/tests/other", KEY_META, "a", "1", KEY_META, "b", "2", KEY_END);
+	Key * otherDup = keyDup (other);
+	succeed_if (other->meta == otherDup->meta, "metadata not shared by keyDup");
+	const Key * cursor = other->meta->cursor;
+	keyGetMeta (other, "a");
+	succeed_if (other->meta->cursor == cursor, "keyGetMeta moved the cursor of shared metadata");
+	keyRewindMeta (other);
+	succeed_if_same_string (keyName (keyNextMeta (other)), "meta:/a");
+	Key * otherDup2 = keyDup (other);
+	succeed_if (other->meta != otherDup2->meta, "metadata with used cursor shared by keyDup");
+	succeed_if_same_string (keyName (keyNextMeta (other)), "meta:/b");
+	keyRewindMeta (otherDup);
+	succeed_if_same_string (keyName (keyNextMeta (otherDup)), "meta:/a");
+
+	keyDel (key);
+	keyDel (dup);
+	keyDel (other);
+	keyDel (otherDup);
+	keyDel (otherDup2);
+}
+
+static void test_sharedMetaKeyMetaThenDup (void)
+{
+	printf ("test shared meta keyMeta then dup\n");
+
+	Key * key = keyNew ("user:/tests/shared", KEY_META, "x", "1", KEY_END);
+	KeySet * meta = keyMeta (key);
+	Key * dup = keyDup (key);
+	succeed_if (dup->meta != meta, "metadata handed out by keyMeta shared by keyDup");
+
+	ksAppendKey (meta, keyNew ("meta:/y", KEY_VALUE, "2", KEY_END));
+	succeed_if_same_string (keyString (keyGetMeta (key, "y")), "2");
+	succeed_if (keyGetMeta (dup, "y") == NULL, "change through keyMeta visible in later copy");
+
+	Key * copy = keyNew ("user:/tests/copy", KEY_END);
+	keyCopyAllMeta (copy, key);
+	ksAppendKey (meta, keyNew ("meta:/z", KEY_VALUE, "3", KEY_END));
+	succeed_if (keyGetMeta (copy, "z") == NULL, "change through keyMeta visible in keyCopyAllMeta copy");
+
+	Key * arenaDup = NULL;
+	KeySet * ks = ksNew (1, key, KS_END);
+	KeySet * deep = ksDeepDup (ks);
+	arenaDup = ksLookupByName (deep, "user:/tests/shared", 0);
+	ksAppendKey (meta, keyNew ("meta:/w", KEY_VALUE, "4", KEY_END));
+	succeed_if (arenaDup && keyGetMeta (arenaDup, "w") == NULL, "change through keyMeta visible in ksDeepDup copy");
+
+	ksDel (deep);
+	ksDel (ks);
+	keyDel (dup);
+	keyDel (copy);
+}
+
 int main (int argc, char ** argv)
 {
 	printf ("KEY META     TESTS\n");
@@ -321,6 +507,11 @@ int main (int argc, char ** argv)
 
 	test_metaArrayToKS ();
 	test_top ();
+	test_getMetaNames ();
+	test_ownerFlag ();
+	test_sharedMeta ();
+	test_sharedMetaDupDuringIteration ();
+	test_sharedMetaKeyMetaThenDup ();
 	printf ("\ntest_meta RESULTS: %d test(s) done. %d error(s).\n", nbTest, nbError);
 
 	return nbError;
@@ -1283,6 +1283,108 @@ static void test_state (void)
 }
 
 
+KeySet * set_nested (void)
+{
+	return ksNew (50, keyNew ("system:/elektra/mountpoints", KEY_END), keyNew ("system:/elektra/mountpoints/a", KEY_END),
+		      keyNew ("system:/elektra/mountpoints/a/mountpoint", KEY_VALUE, "user:/tests/a", KEY_END),
+		      keyNew ("system:/elektra/mountpoints/b", KEY_END),
+		      keyNew ("system:/elektra/mountpoints/b/mountpoint", KEY_VALUE, "user:/tests/a/b", KEY_END),
+		      keyNew ("system:/elektra/mountpoints/c", KEY_END),
+		      keyNew ("system:/elektra/mountpoints/c/mountpoint", KEY_VALUE, "/tests/c", KEY_END),
+		      keyNew ("system:/elektra/mountpoints/d", KEY_END),
+		      keyNew ("system:/elektra/mountpoints/d/mountpoint", KEY_VALUE, "system:/tests/a", KEY_END), KS_END);
+}
+
+static void test_nested (void)
+{
+	printf ("Test nested mountpoints\n");
+
+	KDB * handle = kdb_open ();
+	succeed_if (mountOpen (handle, set_nested (), handle->modules, 0) == 0, "could not open mountpoints");
+	succeed_if (mountDefault (handle, handle->modules, 1, 0) == 0, "could not open default backend");
+
+	const char * names[] = { "user:/tests",
+				 "user:/tests/a",
+				 "user:/tests/a/a",
+				 "user:/tests/a/b",
+				 "user:/tests/a/b/#0",
+				 "user:/tests/a/b/#_10",
+				 "user:/tests/a/b\\/c",
+				 "user:/tests/a/ba",
+				 "user:/tests/a/c",
+				 "user:/tests/a\\/b",
+				 "user:/tests/ab",
+				 "user:/tests/b",
+				 "user:/tests/c",
+				 "user:/tests/c/x",
+				 "user:/tests/cc",
+				 "dir:/tests/c/x",
+				 "dir:/tests/d",
+				 "system:/tests/a/b",
+				 "system:/tests/c",
+				 "system:/z",
+				 "spec:/tests/c/x",
+				 "proc:/tests/a",
+				 "default:/tests/a",
+				 0 };
+	KeySet * ks = ksNew (30, KS_END);
+	for (size_t i = 0; names[i]; ++i)
+	{
+		ksAppendKey (ks, keyNew (names[i], KEY_END));
+	}
+
+	Split * split = splitNew ();
+	succeed_if (splitBuildup (split, handle, 0) == 1, "could not build up split");
+	succeed_if (splitDivide (split, handle, ks) == 1, "should need sync");
+
+	// every key has to be in the keyset a lookup of its backend finds
+	size_t divided = 0;
+	for (elektraCursor it = 0; it < ksGetSize (ks); ++it)
+	{
+		Key * cur = ksAtCursor (ks, it);
+		ssize_t expected = splitSearchBackend (split, mountGetBackend (handle, keyName (cur)), cur);
+		for (size_t i = 0; i < split->size; ++i)
+		{
+			Key * found = ksLookup (split->keysets[i], cur, 0);
+			succeed_if ((found != 0) == ((ssize_t) i == expected), "key divided into wrong backend");
+			if (found && (ssize_t) i != expected) printf ("%s divided into %s\n", keyName (cur), keyName (split->parents[i]));
+		}
+		if (expected != -1) ++divided;
+	}
+
+	size_t total = 0;
+	for (size_t i = 0; i < split->size; ++i)
+	{
+		total += ksGetSize (split->keysets[i]);
+		for (elektraCursor it = 1; it < ksGetSize (split->keysets[i]); ++it)
+		{
+			succeed_if (keyCmp (ksAtCursor (split->keysets[i], it - 1), ksAtCursor (split->keysets[i], it)) < 0,
+				    "divided keys not sorted");
+		}
+	}
+	succeed_if (total == divided, "wrong number of divided keys");
+	succeed_if (divided == 21, "only the proc and default keys should be skipped");
+	splitDel (split);
+
+	split = splitNew ();
+	Key * parent = keyNew ("user:/tests/a", KEY_END);
+	succeed_if (splitBuildup (split, handle, parent) == 1, "could not build up split");
+	succeed_if (split->size == 2, "should contain the nested mountpoints");
+	succeed_if (splitAppoint (split, handle, ks) == 1, "could not appoint keys");
+	succeed_if (split->size == 3, "should have appended default split");
+	succeed_if (ksGetSize (split->keysets[0]) == 5, "wrong number of keys for user:/tests/a");
+	succeed_if (ksGetSize (split->keysets[1]) == 3, "wrong number of keys for user:/tests/a/b");
+	succeed_if (ksGetSize (split->keysets[2]) == ksGetSize (ks) - 8, "other keys should be in default split");
+	succeed_if (ksLookupByName (split->keysets[0], "user:/tests/a/ba", 0), "key next to nested mountpoint not appointed");
+	succeed_if (ksLookupByName (split->keysets[1], "user:/tests/a/b/#_10", 0), "key of nested mountpoint not appointed");
+	keyDel (parent);
+	splitDel (split);
+
+	ksDel (ks);
+	kdb_close (handle);
+}
+
+
 int main (int argc, char ** argv)
 {
 	printf ("SPLIT SET   TESTS\n");
@@ -1302,6 +1404,7 @@ int main (int argc, char ** argv)
 	test_emptysplit ();
 	test_nothingsync ();
 	test_state ();
+	test_nested ();
 
 	printf ("\ntest_splitset RESULTS: %d test(s) done. %d error(s).\n", nbTest, nbError);
 
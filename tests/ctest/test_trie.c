@@ -755,6 +755,81 @@ static void test_userroot (void)
 }
 
 
+static void test_hierarchy (void)
+{
+	printf ("Test hierarchy lookup\n");
+
+	Trie * trie = test_insert (0, "user:/tests/a/", "a");
+	trie = test_insert (trie, "user:/tests/a/b/", "b");
+	trie = test_insert (trie, "user:/tests/ab/", "ab");
+	trie = test_insert (trie, "system:/", "system");
+
+	exit_if_fail (trie, "trie was not build up successfully");
+
+	Backend * a = trieLookup (trie, "user:/tests/a");
+	Backend * b = trieLookup (trie, "user:/tests/a/b/c");
+	exit_if_fail (a && b && a != b, "nested backends not found");
+	succeed_if (trieLookup (trie, "user:/tests/a/bc") == a, "prefix of name should not match");
+	succeed_if (trieLookup (trie, "user:/tests/ab/c") != a, "should be other backend");
+
+	int exclusive = 1;
+	succeed_if (trieLookupHierarchy (trie, "user:/tests", &exclusive) == 0, "there should be no backend");
+	succeed_if (exclusive == 0, "backends are mounted below");
+
+	exclusive = 1;
+	succeed_if (trieLookupHierarchy (trie, "user:/tests/a", &exclusive) == a, "should be backend a");
+	succeed_if (exclusive == 0, "b is mounted below a");
+
+	exclusive = 0;
+	succeed_if (trieLookupHierarchy (trie, "user:/tests/a/b", &exclusive) == b, "should be backend b");
+	succeed_if (exclusive == 1, "nothing is mounted below b");
+
+	exclusive = 0;
+	succeed_if (trieLookupHierarchy (trie, "user:/tests/a/c", &exclusive) == a, "should be backend a");
+	succeed_if (exclusive == 1, "nothing is mounted below c");
+
+	exclusive = 0;
+	succeed_if (trieLookupHierarchy (trie, "user:/tests/ab", &exclusive) != a, "should be other backend");
+	succeed_if (exclusive == 1, "nothing is mounted below ab");
+
+	exclusive = 1;
+	succeed_if (trieLookupHierarchy (trie, "user:", &exclusive) == 0, "there should be no backend");
+	succeed_if (exclusive == 0, "backends are mounted below");
+
+	exclusive = 0;
+	succeed_if (trieLookupHierarchy (trie, "system:/elektra", &exclusive) != 0, "should be system backend");
+	succeed_if (exclusive == 1, "nothing is mounted below system:/elektra");
+
+	exclusive = 0;
+	succeed_if (trieLookupHierarchy (trie, "dir:/", &exclusive) == 0, "there should be no backend");
+	succeed_if (exclusive == 1, "nothing is mounted below dir:/");
+
+	trieClose (trie, 0);
+
+	// root mountpoints already end with a slash
+	trie = test_insert (0, "user:/", "root");
+	trie = test_insert (trie, "user:/hosts/", "hosts");
+
+	Backend * root = trieLookup (trie, "user:/");
+	Backend * hosts = trieLookup (trie, "user:/hosts/a");
+	exit_if_fail (root && hosts && root != hosts, "root and nested backends not found");
+	succeed_if (trieLookup (trie, "user:/hostsx") == root, "prefix of name should not match");
+
+	exclusive = 1;
+	succeed_if (trieLookupHierarchy (trie, "user:/", &exclusive) == root, "should be root backend");
+	succeed_if (exclusive == 0, "hosts is mounted below the root");
+
+	exclusive = 0;
+	succeed_if (trieLookupHierarchy (trie, "user:/hosts", &exclusive) == hosts, "should be backend hosts");
+	succeed_if (exclusive == 1, "nothing is mounted below hosts");
+
+	exclusive = 0;
+	succeed_if (trieLookupHierarchy (trie, "user:/other", &exclusive) == root, "should be root backend");
+	succeed_if (exclusive == 1, "nothing is mounted below other");
+
+	trieClose (trie, 0);
+}
+
 int main (int argc, char ** argv)
 {
 	printf ("TRIE       TESTS\n");
@@ -774,6 +849,7 @@ int main (int argc, char ** argv)
 	test_double ();
 	test_emptyvalues ();
 	test_userroot ();
+	test_hierarchy ();
 
 	printf ("\ntest_trie RESULTS: %d test(s) done. %d error(s).\n", nbTest, nbError);
 
@@ -10,6 +10,7 @@
 #include <gtest/gtest-elektra.h>
 #include <kdb.hpp>
 
+#include <fstream>
 #include <regex>
 
 class Ensure : public ::testing::Test
@@ -213,3 +214,162 @@ TEST_F (Ensure, GlobalMount)
 		}
 	}
 }
+
+TEST_F (Ensure, GetWorkers)
+{
+	using namespace kdb;
+	KDB kdb;
+
+	KeySet contract;
+	contract.append (Key ("system:/elektra/ensure/get/workers", KEY_VALUE, "4", KEY_END));
+	Key root (testRoot, KEY_END);
+	kdb.ensure (contract, root);
+
+	KeySet ks;
+	kdb.get (ks, root);
+
+	EXPECT_TRUE (ks.lookup (userRoot + "/speckey/#0", 0)) << "keys missing with get workers";
+	EXPECT_EQ (ks.lookup (userRoot + "/speckey/#0", 0).getMeta<std::string> ("mymeta"), "1") << "spec plugin didn't run";
+}
+
+/**
+ * @brief Cascading mountpoint with resolver+quickdump, whose kdbGet is thread-safe
+ */
+class QuickdumpMountpoint
+{
+public:
+	std::string mountpoint;
+	std::string userConfigFile;
+
+	QuickdumpMountpoint (std::string mountpoint_, std::string configFile_) : mountpoint (mountpoint_)
+	{
+		using namespace kdb;
+		using namespace kdb::tools;
+
+		Backend b;
+		b.setMountpoint (Key (mountpoint, KEY_END), KeySet (0, KS_END));
+		b.addPlugin (PluginSpec (KDB_RESOLVER));
+		b.useConfigFile (configFile_);
+		b.addPlugin (PluginSpec ("quickdump"));
+		KeySet ks;
+		KDB kdb;
+		Key parentKey ("system:/elektra/mountpoints", KEY_END);
+		kdb.get (ks, parentKey);
+		b.serialize (ks);
+		kdb.set (ks, parentKey);
+
+		userConfigFile = testing::Mountpoint::getConfigFileName ("user", mountpoint);
+		::unlink (userConfigFile.c_str ());
+	}
+
+	~QuickdumpMountpoint ()
+	{
+		testing::Mountpoint::umount (mountpoint);
+		::unlink (userConfigFile.c_str ());
+	}
+
+	void corrupt (const std::string & content)
+	{
+		std::ofstream file (userConfigFile, std::ios::binary | std::ios::trunc);
+		file << content;
+	}
+};
+
+static void expectSameMeta (const kdb::Key & expected, const kdb::Key & actual)
+{
+	kdb::KeySet expectedMeta (ckdb::ksDup (ckdb::keyMeta (*expected)));
+	kdb::KeySet actualMeta (ckdb::ksDup (ckdb::keyMeta (*actual)));
+	ASSERT_EQ (expectedMeta.size (), actualMeta.size ()) << "different number of metadata on " << expected.getName ();
+	for (elektraCursor it = 0; it < expectedMeta.size (); ++it)
+	{
+		EXPECT_EQ (expectedMeta.at (it).getName (), actualMeta.at (it).getName ());
+		EXPECT_EQ (expectedMeta.at (it).getString (), actualMeta.at (it).getString ());
+	}
+}
+
+TEST_F (Ensure, GetWorkersConcurrent)
+{
+	using namespace kdb;
+
+	std::string workersRoot = std::string (testRoot) + "/workers";
+	std::vector<std::unique_ptr<QuickdumpMountpoint>> mountpoints;
+	for (const char * name : { "a", "b", "c" })
+	{
+		mountpoints.emplace_back (
+			new QuickdumpMountpoint (workersRoot + "/" + name, std::string ("kdbFileEnsureWorkers_") + name + ".quickdump"));
+	}
+
+	{
+		KDB kdb;
+		KeySet ks;
+		kdb.get (ks, testRoot);
+		for (const char * name : { "a", "b", "c" })
+		{
+			for (int i = 0; i < 10; ++i)
+			{
+				std::string value = std::string (name) + std::to_string (i);
+				ks.append (Key (userRoot + "/workers/" + name + "/key" + std::to_string (i), KEY_VALUE, value.c_str (), KEY_META,
+						"order", std::to_string (i).c_str (), KEY_END));
+			}
+		}
+		kdb.set (ks, testRoot);
+	}
+
+	KeySet contract;
+	contract.append (Key ("system:/elektra/ensure/get/workers", KEY_VALUE, "4", KEY_END));
+
+	{
+		KDB sequential;
+		KeySet expected;
+		Key expectedRoot (testRoot, KEY_END);
+		sequential.get (expected, expectedRoot);
+
+		KDB concurrent;
+		Key root (testRoot, KEY_END);
+		concurrent.ensure (contract, root);
+		KeySet actual;
+		concurrent.get (actual, root);
+
+		ASSERT_EQ (expected.size (), actual.size ()) << "concurrent kdbGet returned other keys";
+		for (elektraCursor it = 0; it < expected.size (); ++it)
+		{
+			EXPECT_EQ (expected.at (it).getName (), actual.at (it).getName ());
+			EXPECT_EQ (expected.at (it).getString (), actual.at (it).getString ());
+			expectSameMeta (expected.at (it), actual.at (it));
+		}
+		EXPECT_EQ (actual.lookup (userRoot + "/workers/b/key3", 0).getString (), "b3") << "keys of quickdump backend missing";
+		expectSameMeta (expectedRoot, root);
+	}
+
+	// the error of the first backend in split order must win, as in the sequential path
+	mountpoints[1]->corrupt ("garbage-b-garbage-b");
+	mountpoints[2]->corrupt ("garbage-c-garbage-c");
+
+	{
+		KDB sequential;
+		KeySet expected;
+		Key expectedRoot (testRoot, KEY_END);
+		EXPECT_THROW (sequential.get (expected, expectedRoot), KDBException);
+
+		KDB concurrent;
+		Key root (testRoot, KEY_END);
+		concurrent.ensure (contract, root);
+		KeySet actual;
+		EXPECT_THROW (concurrent.get (actual, root), KDBException);
+
+		EXPECT_EQ (root.getMeta<std::string> ("error/module"), "quickdump") << "quickdump didn't report the error";
+		EXPECT_EQ (root.getName (), expectedRoot.getName ()) << "error reported for another backend";
+		expectSameMeta (expectedRoot, root);
+	}
+}
+
+TEST_F (Ensure, GetWorkersInvalid)
+{
+	using namespace kdb;
+	KDB kdb;
+
+	KeySet contract;
+	contract.append (Key ("system:/elektra/ensure/get/workers", KEY_VALUE, "many", KEY_END));
+	Key root (testRoot, KEY_END);
+	EXPECT_THROW (kdb.ensure (contract, root), KDBException);
+}
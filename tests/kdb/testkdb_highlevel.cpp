@@ -956,3 +956,42 @@ TEST_F (Highlevel, EnforceMetadata)
 
 	EXPECT_NE (elektraFindKey (elektra, "testkey", nullptr), nullptr);
 }
+
+TEST_F (Highlevel, CachedKeys)
+{
+	setValues ({
+		makeKey (KDB_TYPE_LONG, "longkey", "1"),
+		makeKey (KDB_TYPE_STRING, "stringkey", "A string"),
+	});
+	setArrays ({ makeArray (KDB_TYPE_LONG, "longarraykey", { "1", "2" }) });
+
+	createElektra ();
+
+	for (int i = 0; i < 3; ++i)
+	{
+		EXPECT_EQ (elektraGetLong (elektra, "longkey"), 1) << "Wrong key value.";
+		EXPECT_STREQ (elektraGetString (elektra, "stringkey"), "A string") << "Wrong key value.";
+		EXPECT_EQ (elektraGetLongArrayElement (elektra, "longarraykey", 0), 1) << "Wrong key value.";
+		EXPECT_EQ (elektraGetLongArrayElement (elektra, "longarraykey", 1), 2) << "Wrong key value.";
+	}
+
+	// cached keys must not be returned for a different type
+	EXPECT_THROW (elektraGetString (elektra, "longkey"), std::runtime_error);
+	EXPECT_THROW (elektraGetLongArrayElement (elektra, "longkey", 0), std::runtime_error);
+
+	ElektraError * error = nullptr;
+
+	elektraSetLong (elektra, "longkey", 2, &error);
+	ASSERT_EQ (error, nullptr) << "elektraSetLong failed: " << elektraErrorDescription (error) << std::endl;
+	EXPECT_EQ (elektraGetLong (elektra, "longkey"), 2) << "Wrong key value after set.";
+
+	elektraSetLongArrayElement (elektra, "longarraykey", 1, 3, &error);
+	ASSERT_EQ (error, nullptr) << "elektraSetLongArrayElement failed: " << elektraErrorDescription (error) << std::endl;
+	EXPECT_EQ (elektraGetLongArrayElement (elektra, "longarraykey", 1), 3) << "Wrong key value after set.";
+	EXPECT_EQ (elektraGetLongArrayElement (elektra, "longarraykey", 0), 1) << "Wrong key value after set.";
+
+	elektraSetString (elektra, "stringkey", "Another string", &error);
+	ASSERT_EQ (error, nullptr) << "elektraSetString failed: " << elektraErrorDescription (error) << std::endl;
+	EXPECT_STREQ (elektraGetString (elektra, "stringkey"), "Another string") << "Wrong key value after set.";
+	EXPECT_EQ (elektraGetLong (elektra, "longkey"), 2) << "Wrong key value after set.";
+}
@@ -0,0 +1,146 @@
+/**
+ * @file
+ *
+ * @brief Tests for tracing of kdbGet and kdbSet
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ *
+ */
+
+#include <keysetio.hpp>
+
+#include <gtest/gtest-elektra.h>
+
+#include <kdbconfig.h>
+#include <kdbprivate.h>
+#include <kdbtrace.h>
+
+#include <set>
+#include <vector>
+
+class Trace : public ::testing::Test
+{
+protected:
+	static const std::string testRoot;
+	static const std::string configFile;
+
+	testing::Namespaces namespaces;
+	testing::MountpointPtr mp;
+
+	Trace () : namespaces ()
+	{
+	}
+
+	virtual void SetUp () override
+	{
+		mp.reset (new testing::Mountpoint (testRoot, configFile));
+	}
+
+	virtual void TearDown () override
+	{
+		mp.reset ();
+	}
+};
+
+const std::string Trace::configFile = "kdbFileTrace.dump";
+const std::string Trace::testRoot = "/tests/kdb/trace/";
+
+static std::vector<ckdb::ElektraTraceEvent> readAll (ckdb::KDB * kdb)
+{
+	std::vector<ckdb::ElektraTraceEvent> events;
+	ckdb::ElektraTraceEvent buffer[16];
+	size_t read;
+	while ((read = ckdb::elektraTraceRead (kdb, buffer, 16)) > 0)
+	{
+		events.insert (events.end (), buffer, buffer + read);
+	}
+	return events;
+}
+
+static std::set<ckdb::ElektraTracePhase> phasesOf (std::vector<ckdb::ElektraTraceEvent> const & events)
+{
+	std::set<ckdb::ElektraTracePhase> phases;
+	for (auto const & event : events)
+	{
+		phases.insert (event.phase);
+	}
+	return phases;
+}
+
+#ifdef HAVE_TRACE
+
+TEST_F (Trace, Phases)
+{
+	using namespace ckdb;
+	Key * parentKey = keyNew (testRoot.c_str (), KEY_END);
+	KDB * kdb = kdbOpen (parentKey);
+	EXPECT_EQ (readAll (kdb).size (), 0u) << "recorded events without tracing";
+	ASSERT_EQ (elektraTraceEnable (kdb, 0), 1) << "could not enable tracing";
+	KeySet * ks = ksNew (20, KS_END);
+
+	kdbGet (kdb, ks, parentKey);
+	ksAppendKey (ks, keyNew (("system:" + testRoot + "key").c_str (), KEY_VALUE, "value", KEY_END));
+	ASSERT_EQ (kdbSet (kdb, ks, parentKey), 1) << "could not set key";
+
+	std::vector<ElektraTraceEvent> events = readAll (kdb);
+	std::set<ElektraTracePhase> phases = phasesOf (events);
+	EXPECT_TRUE (phases.count (ELEKTRA_TRACE_GET)) << "whole kdbGet not traced";
+	EXPECT_TRUE (phases.count (ELEKTRA_TRACE_SET)) << "whole kdbSet not traced";
+	EXPECT_TRUE (phases.count (ELEKTRA_TRACE_RESOLVER)) << "resolver not traced";
+	EXPECT_TRUE (phases.count (ELEKTRA_TRACE_STORAGE)) << "storage not traced";
+	EXPECT_TRUE (phases.count (ELEKTRA_TRACE_COMMIT)) << "commit not traced";
+	EXPECT_TRUE (phases.count (ELEKTRA_TRACE_SPLIT)) << "split not traced";
+	EXPECT_EQ (events.back ().phase, ELEKTRA_TRACE_SET) << "whole kdbSet should be recorded last";
+	EXPECT_GE (events.back ().keys, 1u);
+	EXPECT_GT (events.back ().bytes, 0u);
+
+	bool foundBackend = false;
+	for (auto const & event : events)
+	{
+		if (event.phase != ELEKTRA_TRACE_STORAGE) continue;
+		EXPECT_NE (event.plugin, nullptr) << "storage event without plugin";
+		if (event.backend && std::string (event.backend) + "/" == testRoot) foundBackend = true;
+	}
+	EXPECT_TRUE (foundBackend) << "storage of mounted backend not traced";
+	EXPECT_EQ (readAll (kdb).size (), 0u) << "events not removed by read";
+
+	FILE * file = tmpfile ();
+	ASSERT_NE (file, nullptr);
+	EXPECT_EQ (elektraTraceDump (events.data (), events.size (), ELEKTRA_TRACE_FORMAT_JSON, file), 0);
+	EXPECT_EQ (elektraTraceDump (events.data (), events.size (), ELEKTRA_TRACE_FORMAT_CHROME, file), 0);
+	rewind (file);
+	EXPECT_EQ (fgetc (file), '[') << "JSON dump should be an array";
+	fclose (file);
+
+	elektraTraceDisable (kdb);
+	EXPECT_EQ (kdb->trace, nullptr) << "tracing not disabled";
+	kdbGet (kdb, ks, parentKey);
+	EXPECT_EQ (readAll (kdb).size (), 0u) << "recorded events after disabling";
+
+	kdbClose (kdb, parentKey);
+	keyDel (parentKey);
+	ksDel (ks);
+}
+
+TEST_F (Trace, Overflow)
+{
+	using namespace ckdb;
+	Key * parentKey = keyNew (testRoot.c_str (), KEY_END);
+	KDB * kdb = kdbOpen (parentKey);
+	ASSERT_EQ (elektraTraceEnable (kdb, 2), 1) << "could not enable tracing";
+	KeySet * ks = ksNew (20, KS_END);
+
+	kdbGet (kdb, ks, parentKey);
+
+	// only the newest events are kept, the whole kdbGet is recorded last
+	std::vector<ElektraTraceEvent> events = readAll (kdb);
+	ASSERT_EQ (events.size (), 2u);
+	EXPECT_EQ (events[1].phase, ELEKTRA_TRACE_GET);
+	EXPECT_LE (events[0].start + events[0].duration, events[1].start + events[1].duration);
+
+	kdbClose (kdb, parentKey);
+	keyDel (parentKey);
+	ksDel (ks);
+}
+
+#endif
@@ -0,0 +1,182 @@
+/**
+ * @file
+ *
+ * @brief Tests for change tracking of KDB
+ *
+ * @copyright BSD License (see LICENSE.md or https://www.libelektra.org)
+ *
+ */
+
+#include <keysetio.hpp>
+
+#include <gtest/gtest-elektra.h>
+
+#include <kdbio.h>
+#include <kdbprivate.h>
+
+class Watch : public ::testing::Test
+{
+protected:
+	static const std::string testRoot;
+	static const std::string configFile;
+
+	testing::Namespaces namespaces;
+	testing::MountpointPtr mp;
+
+	Watch () : namespaces ()
+	{
+	}
+
+	virtual void SetUp () override
+	{
+		mp.reset (new testing::Mountpoint (testRoot, configFile));
+	}
+
+	virtual void TearDown () override
+	{
+		mp.reset ();
+	}
+
+	void setExternally (std::string value)
+	{
+		using namespace kdb;
+		KDB kdb;
+		KeySet ks;
+		kdb.get (ks, testRoot);
+		ks.append (Key ("system:" + testRoot + "key", KEY_VALUE, value.c_str (), KEY_END));
+		kdb.set (ks, testRoot);
+	}
+};
+
+const std::string Watch::configFile = "kdbFileWatch.dump";
+const std::string Watch::testRoot = "/tests/kdb/watch/";
+
+static ckdb::ElektraIoFdOperation * boundFdOp = nullptr;
+
+static int addFd (ckdb::ElektraIoInterface *, ckdb::ElektraIoFdOperation * fdOp)
+{
+	boundFdOp = fdOp;
+	return 1;
+}
+
+static int removeFd (ckdb::ElektraIoFdOperation * fdOp)
+{
+	if (boundFdOp == fdOp) boundFdOp = nullptr;
+	return 1;
+}
+
+static int updateFd (ckdb::ElektraIoFdOperation *)
+{
+	return 1;
+}
+
+static int addTimer (ckdb::ElektraIoInterface *, ckdb::ElektraIoTimerOperation *)
+{
+	return 1;
+}
+
+static int updateTimer (ckdb::ElektraIoTimerOperation *)
+{
+	return 1;
+}
+
+static int removeTimer (ckdb::ElektraIoTimerOperation *)
+{
+	return 1;
+}
+
+static int addIdle (ckdb::ElektraIoInterface *, ckdb::ElektraIoIdleOperation *)
+{
+	return 1;
+}
+
+static int updateIdle (ckdb::ElektraIoIdleOperation *)
+{
+	return 1;
+}
+
+static int removeIdle (ckdb::ElektraIoIdleOperation *)
+{
+	return 1;
+}
+
+static int cleanup (ckdb::ElektraIoInterface * binding)
+{
+	ckdb::elektraFree (binding);
+	return 1;
+}
+
+static std::string lookupValue (ckdb::KeySet * ks, std::string name)
+{
+	ckdb::Key * found = ckdb::ksLookupByName (ks, name.c_str (), 0);
+	return found ? ckdb::keyString (found) : "";
+}
+
+TEST_F (Watch, ExternalChanges)
+{
+	using namespace ckdb;
+	Key * parentKey = keyNew (testRoot.c_str (), KEY_END);
+	KDB * kdb = kdbOpen (parentKey);
+	ASSERT_EQ (elektraIoWatchEnable (kdb), 1) << "could not enable watch";
+	EXPECT_EQ (elektraIoWatchEnable (kdb), 1) << "could not enable watch twice";
+	KeySet * ks = ksNew (20, KS_END);
+
+	// the first get adds the watches, the second makes them trusted
+	for (int i = 0; i < 3; ++i)
+	{
+		EXPECT_EQ (kdbGet (kdb, ks, parentKey), 0) << "should be nothing to update";
+	}
+	EXPECT_EQ (ksGetSize (ks), 0) << "got keys from freshly mounted backends";
+
+	setExternally ("created");
+	EXPECT_EQ (kdbGet (kdb, ks, parentKey), 1) << "missed created file";
+	EXPECT_EQ (lookupValue (ks, "system:" + testRoot + "key"), "created");
+	EXPECT_EQ (kdbGet (kdb, ks, parentKey), 0) << "should be nothing to update";
+	EXPECT_EQ (kdbGet (kdb, ks, parentKey), 0) << "should be nothing to update";
+	EXPECT_EQ (std::string (keyString (parentKey)), mp->systemConfigFile) << "resolved file not set";
+
+	setExternally ("modified");
+	EXPECT_EQ (kdbGet (kdb, ks, parentKey), 1) << "missed modified file";
+	EXPECT_EQ (lookupValue (ks, "system:" + testRoot + "key"), "modified");
+
+	elektraIoWatchDisable (kdb);
+	EXPECT_EQ (kdb->watch, nullptr) << "watch not disabled";
+	setExternally ("unwatched");
+	EXPECT_EQ (kdbGet (kdb, ks, parentKey), 1) << "missed modified file";
+	EXPECT_EQ (lookupValue (ks, "system:" + testRoot + "key"), "unwatched");
+
+	kdbClose (kdb, parentKey);
+	keyDel (parentKey);
+	ksDel (ks);
+}
+
+TEST_F (Watch, IoBinding)
+{
+	using namespace ckdb;
+	Key * parentKey = keyNew (testRoot.c_str (), KEY_END);
+	KDB * kdb = kdbOpen (parentKey);
+	ElektraIoInterface * binding =
+		elektraIoNewBinding (addFd, updateFd, removeFd, addTimer, updateTimer, removeTimer, addIdle, updateIdle, removeIdle, cleanup);
+	ASSERT_NE (binding, nullptr);
+	elektraIoSetBinding (kdb, binding);
+	ASSERT_EQ (elektraIoWatchEnable (kdb), 1) << "could not enable watch";
+	ASSERT_NE (boundFdOp, nullptr) << "watch not added to binding";
+	KeySet * ks = ksNew (20, KS_END);
+
+	for (int i = 0; i < 3; ++i)
+	{
+		EXPECT_EQ (kdbGet (kdb, ks, parentKey), 0) << "should be nothing to update";
+	}
+
+	// changes are picked up after the binding processed the events
+	setExternally ("created");
+	elektraIoFdGetCallback (boundFdOp) (boundFdOp, ELEKTRA_IO_READABLE);
+	EXPECT_EQ (kdbGet (kdb, ks, parentKey), 1) << "missed created file";
+	EXPECT_EQ (lookupValue (ks, "system:" + testRoot + "key"), "created");
+
+	kdbClose (kdb, parentKey);
+	EXPECT_EQ (boundFdOp, nullptr) << "watch not removed from binding";
+	elektraIoBindingCleanup (binding);
+	keyDel (parentKey);
+	ksDel (ks);
+}